@@ -77,6 +77,8 @@ if [ "$DISTRO" = "UBUNTU" ]; then
         libboost-thread-dev \
         libboost-filesystem-dev \
         libjemalloc-dev \
+        liblz4-dev \
+        libzstd-dev \
         valgrind \
         lcov \
         postgresql-client \
@@ -95,6 +97,8 @@ elif [[ "$DISTRO" == *"FEDORA"* ]]; then
         libevent-devel \
         boost-devel \
         jemalloc-devel \
+        lz4-devel \
+        libzstd-devel \
         valgrind \
         lcov \
         postgresql \
@@ -128,6 +132,8 @@ elif [[ "$DISTRO" == *"REDHAT"* ]] && [[ "${DISTRO_VER%.*}" == "7" ]]; then
         flex \
         protobuf-devel \
         jemalloc-devel \
+        lz4-devel \
+        libzstd-devel \
         valgrind \
         lcov \
         m4 \
@@ -22,6 +22,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "common/timer.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "index/index_factory.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
@@ -94,51 +95,51 @@ static void AddIndex(storage::DataTable* table,
 
 void IndexTuner::BuildIndex(storage::DataTable* table,
                             std::shared_ptr<index::Index> index) {
-  auto table_schema = table->GetSchema();
   auto index_tile_group_offset = index->GetIndexedTileGroupOff();
   auto table_tile_group_count = table->GetTileGroupCount();
-  oid_t tile_groups_indexed = 0;
-
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-
-  while (index_tile_group_offset < table_tile_group_count &&
-         (tile_groups_indexed < tile_groups_indexed_per_iteration)) {
-    std::unique_ptr<storage::Tuple> tuple_ptr(
-        new storage::Tuple(table_schema, true));
-
-    auto tile_group = table->GetTileGroup(index_tile_group_offset);
-    auto tile_group_id = tile_group->GetTileGroupId();
-    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
-
-    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-      // Setup container tuple
-      expression::ContainerTuple<storage::TileGroup> container_tuple(
-          tile_group.get(), tuple_id);
-
-      // Set the location
-      ItemPointer location(tile_group_id, tuple_id);
+  if (index_tile_group_offset >= table_tile_group_count) {
+    return;
+  }
 
-      // Set the key
-      key->SetFromTuple(&container_tuple, indexed_columns, index->GetPool());
+  size_t thread_count = index_build_thread_count;
+  if (thread_count == 0) {
+    thread_count = std::max(1U, std::thread::hardware_concurrency());
+  }
 
-      // Insert in specific index
-      // TODO: Allocate itempointer ?
-      index->InsertEntry(key.get(), &location);
-    }
+  // Each build thread indexes up to tile_groups_indexed_per_iteration
+  // tile groups of the batch
+  size_t batch_end = std::min<size_t>(
+      table_tile_group_count,
+      index_tile_group_offset + tile_groups_indexed_per_iteration * thread_count);
+  oid_t tile_groups_indexed = batch_end - index_tile_group_offset;
+
+  // The index is attached to the table already and maintained by writers
+  if (table->PopulateIndex(index.get(), index_tile_group_offset, batch_end,
+                           thread_count, true) == false) {
+    LOG_DEBUG("Conflicting keys while building index : %s",
+              index->GetName().c_str());
+  }
 
-    // Update indexed tile group offset (set of tgs indexed)
+  // Update indexed tile group offset (set of tgs indexed) only once the
+  // whole batch is done, since scans rely on it
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_groups_indexed;
+       tile_group_itr++) {
     index->IncrementIndexedTileGroupOffset();
-
-    index_tile_group_offset++;
-    tile_groups_indexed++;
   }
 
   tile_groups_indexed_ += tile_groups_indexed;
 }
 
 void IndexTuner::BuildIndices(storage::DataTable* table) {
+  // Transactions that started before the last index was added might still
+  // insert tuples without indexing them
+  auto& epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  if (epoch_manager.GetMaxCommittedEpochId() < index_added_epoch_id_) {
+    LOG_TRACE("Postpone index build till epoch %lu is committed",
+              index_added_epoch_id_);
+    return;
+  }
+
   oid_t index_count = table->GetIndexCount();
 
   for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
@@ -149,7 +150,7 @@ void IndexTuner::BuildIndices(storage::DataTable* table) {
     }
 
     // Build index
-    // BuildIndex(table, index);
+    BuildIndex(table, index);
   }
 }
 
@@ -367,6 +368,9 @@ void IndexTuner::AddIndexes(
       // Add adhoc index with given utility
       AddIndex(table, suggested_index_set);
       constructed_index_itr++;
+
+      index_added_epoch_id_ =
+          concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
     }
     // Found suggested index, enable it
     else if (suggested_index_found == true) {
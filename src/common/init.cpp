@@ -19,7 +19,11 @@
 #include "brain/index_tuner.h"
 #include "brain/layout_tuner.h"
 #include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
+#include "logging/log_manager.h"
+#include "logging/loggers/wal_frontend_logger.h"
+#include "logging/replication/replication_standby.h"
 #include "storage/data_table.h"
 
 #include <google/protobuf/stubs/common.h>
@@ -30,6 +34,57 @@ namespace peloton {
 
 ThreadPool thread_pool;
 
+// Start write ahead logging, with the log streamed to the standby
+static void StartReplication() {
+  auto& log_manager = logging::LogManager::GetInstance();
+
+  ReplicationType replication_type = SYNC_REPLICATION;
+  if (FLAGS_replication_mode == "semisync") {
+    replication_type = SEMISYNC_REPLICATION;
+  } else if (FLAGS_replication_mode == "async") {
+    replication_type = ASYNC_REPLICATION;
+  } else if (FLAGS_replication_mode != "sync") {
+    LOG_ERROR("Invalid replication mode : %s", FLAGS_replication_mode.c_str());
+    return;
+  }
+
+  // only the commits of ssi and ssn are logged
+  auto protocol = concurrency::TransactionManagerFactory::GetProtocol();
+  if (protocol != ConcurrencyType::CONCURRENCY_TYPE_SSI &&
+      protocol != ConcurrencyType::CONCURRENCY_TYPE_SI_SSN) {
+    LOG_ERROR(
+        "Cannot replicate, the concurrency protocol does not log its "
+        "commits");
+    return;
+  }
+
+  peloton_logging_mode = LoggingType::SSD_WAL;
+  log_manager.Configure(peloton_logging_mode);
+  log_manager.SetLogDirectoryName("./");
+  log_manager.SetLogFileName(
+      std::string("./") +
+      logging::WriteAheadFrontendLogger::wal_directory_path);
+
+  if (log_manager.SetReplication(FLAGS_replication_standby_address,
+                                 replication_type,
+                                 FLAGS_replication_port) == false) {
+    LOG_ERROR("Could not replicate to %s",
+              FLAGS_replication_standby_address.c_str());
+    peloton_logging_mode = LoggingType::INVALID;
+    return;
+  }
+
+  // Launch the frontend logger, and wait for standby mode
+  log_manager.StartStandbyMode();
+  log_manager.WaitForModeTransition(LoggingStatusType::STANDBY, true);
+
+  // Do any recovery
+  log_manager.PrepareRecovery();
+  log_manager.StartRecoveryMode();
+  log_manager.WaitForModeTransition(LoggingStatusType::LOGGING, true);
+  log_manager.DoneRecovery();
+}
+
 void PelotonInit::Initialize() {
   CONNECTION_THREAD_COUNT = std::thread::hardware_concurrency();
   LOGGING_THREAD_COUNT = 1;
@@ -67,9 +122,23 @@ void PelotonInit::Initialize() {
   // initialize the catalog and add the default database, so we don't do this on
   // the first query
   catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  // replay the log stream of a primary, which must create the same tables
+  if (FLAGS_replication_standby == true) {
+    logging::ReplicationStandby::GetInstance().Start(FLAGS_replication_port);
+  }
+  // stream the log to a standby
+  else if (FLAGS_replication_standby_address.empty() == false) {
+    StartReplication();
+  }
 }
 
 void PelotonInit::Shutdown() {
+  // stop logging
+  if (peloton_logging_mode != LoggingType::INVALID) {
+    logging::LogManager::GetInstance().EndLogging();
+  }
+
   // shut down index tuner
   if (FLAGS_index_tuner == true) {
     auto& index_tuner = brain::IndexTuner::GetInstance();
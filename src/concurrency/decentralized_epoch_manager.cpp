@@ -29,6 +29,13 @@ namespace concurrency {
       bool rt = local_epochs_.at(thread_id)->EnterEpoch(epoch_id);
       // if successfully enter local epoch
       if (rt == true) {
+
+        // the gc assumes that transactions it does not see yet begin in the
+        // epoch it read or in a later one.
+        if (GetCurrentGlobalEpoch() != epoch_id) {
+          local_epochs_.at(thread_id)->ExitEpoch(epoch_id);
+          continue;
+        }
     
         uint32_t next_txn_id = GetNextTransactionId();
 
@@ -42,9 +49,18 @@ namespace concurrency {
 
     PL_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
 
-    local_epochs_.at(thread_id)->EnterEpochRO(current_global_epoch_ro_);
+    while (true) {
+      uint64_t epoch_id = current_global_epoch_ro_.load();
+
+      local_epochs_.at(thread_id)->EnterEpochRO(epoch_id);
 
-    return (current_global_epoch_ro_ << 32) | 0x0;
+      // same as above.
+      if (current_global_epoch_ro_.load() == epoch_id) {
+        return (epoch_id << 32) | 0x0;
+      }
+
+      local_epochs_.at(thread_id)->ExitEpoch(epoch_id);
+    }
   }
 
   void DecentralizedEpochManager::ExitEpoch(const size_t thread_id, const cid_t begin_cid) {
@@ -83,5 +99,18 @@ namespace concurrency {
     return global_max_committed_eid;
   }
 
+  void DecentralizedEpochManager::GetActiveSnapshots(ActiveSnapshots &snapshots) {
+    // read before the local epochs, such that transactions entering an epoch
+    // afterwards are covered by them.
+    snapshots.next_epoch_id = GetCurrentGlobalEpoch();
+    snapshots.next_ro_epoch_id = current_global_epoch_ro_.load();
+
+    snapshots.epoch_ranges.clear();
+    for (auto &local_epoch_itr : local_epochs_) {
+      local_epoch_itr.second->GetActiveEpochRanges(snapshots.next_epoch_id,
+                                                   snapshots.epoch_ranges);
+    }
+  }
+
 }
 }
\ No newline at end of file
@@ -16,104 +16,130 @@
 namespace peloton {
 namespace concurrency {
 
+  LocalEpoch::LocalEpoch(const size_t thread_id) :
+    epoch_lower_bound_(0),
+    thread_id_(thread_id) {
+    for (size_t slot_itr = 0; slot_itr < EPOCH_RING_SIZE; ++slot_itr) {
+      epoch_slots_[slot_itr] = PackSlot(0, 0);
+    }
+  }
+
   bool LocalEpoch::EnterEpoch(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
-    // if this thread is never used or GC'd
-    if (epoch_lower_bound_ == UINT64_MAX) {
-      epoch_lower_bound_ = epoch_id - 1;
-    } else if (epoch_lower_bound_ >= epoch_id) {
+    IncreaseTxnCount(epoch_id);
+
     // epoch_lower_bound_ has already been updated by the GC.
     // have to grab a newer epoch_id.
-      epoch_lock_.Unlock();
+    // the count is raised before the bound is read, and the gc reads the
+    // counts again after raising the bound, so either this transaction backs
+    // off or the gc sees it.
+    if (epoch_lower_bound_.load() >= epoch_id) {
+      DecreaseTxnCount(epoch_id);
       return false;
-    } 
-
-    auto epoch_map_itr = epoch_map_.find(epoch_id);
-    // check whether the corresponding epoch exists.
-    if (epoch_map_itr == epoch_map_.end()) {
-
-      std::shared_ptr<Epoch> epoch_ptr(new Epoch(epoch_id, 1));
-
-      epoch_queue_.push(epoch_ptr);
-      epoch_map_[epoch_id] = epoch_ptr;
-
-    } else {
-      epoch_map_itr->second->txn_count_++;
     }
 
-    epoch_lock_.Unlock();
     return true;
   }
   
   // the input parameter is the global read-only epoch id.
+  // read-only transactions always succeed, the gc keeps their versions as
+  // it sees them.
   void LocalEpoch::EnterEpochRO(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
-    // if this thread is never used or GC'd
-    if (epoch_lower_bound_ == UINT64_MAX) {
-      epoch_lower_bound_ = epoch_id - 1;
-    } else if (epoch_lower_bound_ >= epoch_id) {
-      epoch_lower_bound_ = epoch_id - 1;
-    }
+    IncreaseTxnCount(epoch_id);
+  }
 
-    if (epoch_map_.find(epoch_id) == epoch_map_.end()) {
 
-      std::shared_ptr<Epoch> epoch_ptr(new Epoch(epoch_id, 1));
+  void LocalEpoch::ExitEpoch(const uint64_t epoch_id) {
+    DecreaseTxnCount(epoch_id);
+  }
+
+  uint64_t LocalEpoch::GetMaxCommittedEpochId(const uint64_t epoch_id) {
+    // there's no epoch in this thread.
+    // which indicates that this thread is used or GC'd for some time.
+    uint64_t min_epoch_id = GetMinActiveEpochId();
+    uint64_t lower_bound =
+      (min_epoch_id == UINT64_MAX) ? epoch_id - 1 : min_epoch_id - 1;
 
-      epoch_queue_.push(epoch_ptr);
-      epoch_map_[epoch_id] = epoch_ptr;
+    epoch_lower_bound_.store(lower_bound);
 
-    } else {
-      epoch_map_.at(epoch_id)->txn_count_++;
+    // a transaction may have entered an epoch at or below the bound while
+    // the slots were read.
+    min_epoch_id = GetMinActiveEpochId();
+    if (min_epoch_id != UINT64_MAX && min_epoch_id - 1 < lower_bound) {
+      lower_bound = min_epoch_id - 1;
     }
 
-    epoch_lock_.Unlock();
+    return lower_bound;
   }
 
+  // a slot that counts transactions of an older epoch keeps the older id.
+  void LocalEpoch::IncreaseTxnCount(const uint64_t epoch_id) {
+    auto &epoch_slot = epoch_slots_[epoch_id % EPOCH_RING_SIZE];
+    uint64_t slot = epoch_slot.load();
+    while (true) {
+      uint64_t txn_count = GetSlotTxnCount(slot);
+      uint64_t slot_epoch_id = GetSlotEpochId(slot);
+      uint64_t shared_flag = 0;
+      if (txn_count == 0) {
+        slot_epoch_id = epoch_id;
+      } else if (epoch_id != slot_epoch_id || IsSlotShared(slot) == true) {
+        slot_epoch_id = std::min(slot_epoch_id, epoch_id);
+        shared_flag = SLOT_SHARED_FLAG;
+      }
 
-  void LocalEpoch::ExitEpoch(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
+      if (epoch_slot.compare_exchange_weak(
+              slot, PackSlot(slot_epoch_id, txn_count + 1) | shared_flag) ==
+          true) {
+        return;
+      }
+    }
+  }
 
-    PL_ASSERT(epoch_map_.find(epoch_id) != epoch_map_.end());
-    epoch_map_.at(epoch_id)->txn_count_--;
+  void LocalEpoch::DecreaseTxnCount(const uint64_t epoch_id) {
+    auto &epoch_slot = epoch_slots_[epoch_id % EPOCH_RING_SIZE];
+    uint64_t slot = epoch_slot.load();
+    while (true) {
+      PL_ASSERT(GetSlotTxnCount(slot) > 0);
+      PL_ASSERT(GetSlotEpochId(slot) <= epoch_id);
+
+      // the last transaction clears the shared flag
+      uint64_t new_slot = (GetSlotTxnCount(slot) == 1)
+                              ? PackSlot(GetSlotEpochId(slot), 0)
+                              : slot - 1;
+      if (epoch_slot.compare_exchange_weak(slot, new_slot) == true) {
+        return;
+      }
+    }
+  }
+
+  // a shared slot may count transactions of any younger epoch.
+  void LocalEpoch::GetActiveEpochRanges(
+      const uint64_t current_epoch_id,
+      std::vector<std::pair<uint64_t, uint64_t>> &epoch_ranges) const {
+    for (size_t slot_itr = 0; slot_itr < EPOCH_RING_SIZE; ++slot_itr) {
+      uint64_t slot = epoch_slots_[slot_itr].load();
+      if (GetSlotTxnCount(slot) == 0) {
+        continue;
+      }
 
-    while (epoch_queue_.size() != 0) {
-      auto &epoch_ptr = epoch_queue_.top();
-      if (epoch_ptr->txn_count_ == 0) {
-        epoch_map_.erase(epoch_ptr->epoch_id_);
-        epoch_queue_.pop();
+      uint64_t slot_epoch_id = GetSlotEpochId(slot);
+      if (IsSlotShared(slot) == true) {
+        epoch_ranges.emplace_back(slot_epoch_id,
+                                  std::max(slot_epoch_id, current_epoch_id));
       } else {
-        PL_ASSERT(epoch_ptr->epoch_id_ > epoch_lower_bound_);
-        epoch_lower_bound_ = epoch_ptr->epoch_id_ - 1;
-        break;
+        epoch_ranges.emplace_back(slot_epoch_id, slot_epoch_id);
       }
     }
-
-    epoch_lock_.Unlock();
   }
 
-  uint64_t LocalEpoch::GetMaxCommittedEpochId(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
-    // there's no epoch in this thread.
-    // which indicates that this thread is used or GC'd for some time.
-    if (epoch_queue_.size() == 0) {
-      epoch_lower_bound_ = epoch_id - 1;
-    } else {
-      while (epoch_queue_.size() != 0) {
-        auto &epoch_ptr = epoch_queue_.top();
-        if (epoch_ptr->txn_count_ == 0) {
-          epoch_map_.erase(epoch_ptr->epoch_id_);
-          epoch_queue_.pop();
-        } else {
-          PL_ASSERT(epoch_ptr->epoch_id_ > epoch_lower_bound_);
-          epoch_lower_bound_ = epoch_ptr->epoch_id_ - 1;
-          break;
-        }
+  uint64_t LocalEpoch::GetMinActiveEpochId() const {
+    uint64_t min_epoch_id = UINT64_MAX;
+    for (size_t slot_itr = 0; slot_itr < EPOCH_RING_SIZE; ++slot_itr) {
+      uint64_t slot = epoch_slots_[slot_itr].load();
+      if (GetSlotTxnCount(slot) != 0 && GetSlotEpochId(slot) < min_epoch_id) {
+        min_epoch_id = GetSlotEpochId(slot);
       }
     }
-    uint64_t ret = epoch_lower_bound_;
-    
-    epoch_lock_.Unlock();
-    return ret;
+    return min_epoch_id;
   }
 
 }
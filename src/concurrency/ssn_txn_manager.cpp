@@ -31,9 +31,6 @@ SsnTxnManager &SsnTxnManager::GetInstance() {
 
 Transaction *SsnTxnManager::BeginTransaction(const size_t thread_id) {
 
-//  auto &log_manager = logging::LogManager::GetInstance();
-//  log_manager.PrepareLogging();
-
   // protect beginTransaction with a global lock
   // to ensure that:
   //    txn_id_a > txn_id_b --> begin_cid_a > begin_cid_b
@@ -88,30 +85,25 @@ void SsnTxnManager::EndTransaction(Transaction *current_txn) {
       current_txn->GetThreadId(),
       current_txn->GetEpochId());
 
-
-//  auto &log_manager = logging::LogManager::GetInstance();
-
   if (current_txn->GetResult() == ResultType::SUCCESS) {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
           RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetBeginCommitId());
     }
-    // Log the transaction's commit
-    // For time stamp ordering, every transaction only has one timestamp
-//    log_manager.LogCommitTransaction(current_txn->GetBeginCommitId());
   } else {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
           RecycleTransaction(current_txn->GetGCSetPtr(), GetNextCommitId());
     }
-//    log_manager.DoneLogging();
   }
 
-  RemoveSsnReader(current_txn);
-
-  delete current_txn;
+  PL_ASSERT(current_ssn_txn_ctx->transaction_ == current_txn);
+  RetireTxnContext(current_ssn_txn_ctx);
+  current_ssn_txn_ctx = nullptr;
   current_txn = nullptr;
 
+  CleanUp();
+
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()
         ->GetTxnLatencyMetric()
@@ -127,9 +119,13 @@ void SsnTxnManager::EndReadonlyTransaction(
       current_txn->GetThreadId(),
       current_txn->GetEpochId());
 
-  delete current_txn;
+  PL_ASSERT(current_ssn_txn_ctx->transaction_ == current_txn);
+  RetireTxnContext(current_ssn_txn_ctx);
+  current_ssn_txn_ctx = nullptr;
   current_txn = nullptr;
 
+  CleanUp();
+
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()
         ->GetTxnLatencyMetric()
@@ -144,10 +140,15 @@ VisibilityType SsnTxnManager::IsVisible(Transaction *const current_txn,
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
   cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  if (tuple_txn_id == INVALID_TXN_ID) {
-    // the tuple is not available.
+  if (tuple_txn_id == INVALID_TXN_ID || CidIsInDirtyRange(tuple_begin_cid)) {
+    // the tuple is not available, or was written by a transaction that was
+    // not durable when the system crashed.
     return VisibilityType::INVISIBLE;
   }
+  if (CidIsInDirtyRange(tuple_end_cid)) {
+    // the transaction invalidating it was not durable either.
+    tuple_end_cid = MAX_CID;
+  }
   bool own = (current_txn->GetTransactionId() == tuple_txn_id);
 
   // there are exactly two versions that can be owned by a transaction.
@@ -209,7 +210,8 @@ bool SsnTxnManager::IsOwnable(UNUSED_ATTRIBUTE Transaction *const current_txn,
 //  assert(current_txn != nullptr);
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  return tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID;
+  return tuple_txn_id == INITIAL_TXN_ID &&
+         (tuple_end_cid == MAX_CID || CidIsInDirtyRange(tuple_end_cid));
 }
 
 //acquire the lock of the tuple
@@ -265,10 +267,13 @@ bool SsnTxnManager::IsOccupied(Transaction *const current_txn, const void *posit
   cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
   cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
 
-  if (tuple_txn_id == INVALID_TXN_ID) {
+  if (tuple_txn_id == INVALID_TXN_ID || CidIsInDirtyRange(tuple_begin_cid)) {
     // the tuple is not available.
     return false;
   }
+  if (CidIsInDirtyRange(tuple_end_cid)) {
+    tuple_end_cid = MAX_CID;
+  }
 
   // the tuple has already been owned by the current transaction.
   bool own = (current_txn->GetTransactionId() == tuple_txn_id);
@@ -610,6 +615,11 @@ ResultType SsnTxnManager::CommitTransaction(Transaction *const current_txn) {
   auto &manager = catalog::Manager::GetInstance();
   auto &rw_set = current_txn->GetReadWriteSet();
   auto gc_set = current_txn->GetGCSetPtr();
+
+  // the logged cid lower bound must be set before the commit id is drawn
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.PrepareLogging();
+
   cid_t end_commit_id = GetNextCommitId();
   txn_id_t t_cstamp = GetNextTransactionId();
 //  ResultType ret;
@@ -699,14 +709,14 @@ ResultType SsnTxnManager::CommitTransaction(Transaction *const current_txn) {
 
   if (should_abort) {
     LOG_DEBUG("Abort because RW conflict");
+    log_manager.DoneLogging();
     return AbortTransaction(current_txn);
   }
   current_ssn_txn_ctx->is_finish_ = true;
 
   //////////////////////////////////////////////////////////
   //post-commit
-//  auto &log_manager = logging::LogManager::GetInstance();
-//  log_manager.LogBeginTransaction(end_commit_id);
+  log_manager.LogBeginTransaction(end_commit_id);
   // install everything.
   for (auto &tile_group_entry : rw_set) {
     oid_t tile_group_id = tile_group_entry.first;
@@ -721,6 +731,9 @@ ResultType SsnTxnManager::CommitTransaction(Transaction *const current_txn) {
             tile_group_header->GetNextItemPointer(tuple_slot);
 
         PL_ASSERT(new_version.IsNull() == false);
+        ItemPointer old_version(tile_group_id, tuple_slot);
+        log_manager.LogUpdate(end_commit_id, old_version, new_version,
+                              current_txn->GetUpdatedColumns(new_version));
 
         auto cid = tile_group_header->GetEndCommitId(tuple_slot);
         PL_ASSERT(cid > end_commit_id);
@@ -750,6 +763,8 @@ ResultType SsnTxnManager::CommitTransaction(Transaction *const current_txn) {
       } else if (tuple_entry.second == RWType::DELETE) {
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
+        ItemPointer delete_location(tile_group_id, tuple_slot);
+        log_manager.LogDelete(end_commit_id, delete_location);
 
         auto cid = tile_group_header->GetEndCommitId(tuple_slot);
         PL_ASSERT(cid > end_commit_id);
@@ -785,6 +800,9 @@ ResultType SsnTxnManager::CommitTransaction(Transaction *const current_txn) {
 //        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
 //                  current_txn->GetTransactionId());
         // set the begin commit id to persist insert
+        ItemPointer insert_location(tile_group_id, tuple_slot);
+        log_manager.LogInsert(end_commit_id, insert_location);
+
         tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
         InitTupleReserved(t_cstamp, tile_group_id, tuple_slot);
@@ -802,11 +820,11 @@ ResultType SsnTxnManager::CommitTransaction(Transaction *const current_txn) {
     }
   }
 
-//  log_manager.LogCommitTransaction(end_commit_id);
-
   current_ssn_txn_ctx->is_finish_ = true;
 
-  end_txn_table_[current_ssn_txn_ctx->transaction_->GetEndCommitId()] = current_ssn_txn_ctx;
+  // waits for the group flush that covers this commit if commits are
+  // synchronous
+  log_manager.LogCommitTransaction(end_commit_id);
 
   EndTransaction(current_ssn_txn_ctx->transaction_);
 //  LOG_DEBUG("Committing peloton txn finished: %lu ", current_txn->GetTransactionId());
@@ -954,21 +972,18 @@ ResultType SsnTxnManager::AbortTransaction(Transaction *const current_txn) {
   if(current_ssn_txn_ctx->transaction_->GetEndCommitId() == MAX_CID) {
     current_ssn_txn_ctx->transaction_->SetEndCommitId(GetNextCommitId());
   }
-  end_txn_table_[current_ssn_txn_ctx->transaction_->GetEndCommitId()] = current_ssn_txn_ctx;
 
-  // delete current_ssn_txn_ctx;
-  // delete current_txn;
   EndTransaction(current_ssn_txn_ctx->transaction_);
 
 //  LOG_DEBUG("Aborting peloton txn finished: %lu ", current_txn->GetTransactionId());
   return ResultType::ABORTED;
 }
 
-void SsnTxnManager::RemoveSsnReader(Transaction *txn) {
+void SsnTxnManager::RemoveSsnReader(SsnTxnContext *txn_ctx) {
 //  LOG_DEBUG("release SILock");
 
   // Remove from the read list of accessed tuples
-  auto &rw_set = txn->GetReadWriteSet();
+  auto &rw_set = txn_ctx->transaction_->GetReadWriteSet();
 
   for (auto &tile_group_entry : rw_set) {
     oid_t tile_group_id = tile_group_entry.first;
@@ -985,11 +1000,83 @@ void SsnTxnManager::RemoveSsnReader(Transaction *txn) {
           tuple_entry.second == RWType::INS_DEL) {
         continue;
       }
-      RemoveSsnReader(tile_group_header, tuple_slot, txn->GetTransactionId());
+      RemoveSsnReader(tile_group_header, tuple_slot, txn_ctx);
     }
   }
 //  LOG_DEBUG("release SILock finish");
 }
 
+void SsnTxnManager::RetireTxnContext(SsnTxnContext *txn_ctx) {
+  auto txn = txn_ctx->transaction_;
+  if (txn->GetEndCommitId() == MAX_CID) {
+    txn->SetEndCommitId(GetNextCommitId());
+  }
+
+  auto epoch_id = EpochManagerFactory::GetInstance().GetCurrentEpochId();
+
+  end_txn_lock_.Lock();
+  end_txn_table_.emplace(epoch_id, txn_ctx);
+  end_txn_lock_.Unlock();
+}
+
+void SsnTxnManager::FreeTxnContext(SsnTxnContext *txn_ctx) {
+  for (auto reader : txn_ctx->readers_) {
+    delete reader;
+  }
+  delete txn_ctx->transaction_;
+  delete txn_ctx;
+}
+
+// Transactions that overlapped a context started at the latest in the epoch
+// it was retired in, so it is no longer looked up once that epoch is
+// committed
+size_t SsnTxnManager::CleanUp(const size_t max_count) {
+  std::unique_lock<std::mutex> lock(clean_mutex_, std::try_to_lock);
+  if (lock.owns_lock() == false) {
+    return 0;
+  }
+
+  auto &epoch_manager = EpochManagerFactory::GetInstance();
+  auto max_epoch_id = epoch_manager.GetMaxCommittedEpochId();
+  auto current_epoch_id = epoch_manager.GetCurrentEpochId();
+
+  size_t freed_count = 0;
+  auto unlinked_itr = unlinked_txn_table_.begin();
+  while (unlinked_itr != unlinked_txn_table_.end() &&
+         unlinked_itr->first <= max_epoch_id && freed_count < max_count) {
+    FreeTxnContext(unlinked_itr->second);
+    unlinked_itr = unlinked_txn_table_.erase(unlinked_itr);
+    freed_count++;
+  }
+
+  std::vector<SsnTxnContext *> txn_ctxs;
+  end_txn_lock_.Lock();
+  auto end_itr = end_txn_table_.begin();
+  while (end_itr != end_txn_table_.end() && end_itr->first <= max_epoch_id &&
+         txn_ctxs.size() < max_count) {
+    txn_ctxs.push_back(end_itr->second);
+    end_itr = end_txn_table_.erase(end_itr);
+  }
+  end_txn_lock_.Unlock();
+
+  for (auto txn_ctx : txn_ctxs) {
+    txn_table_.erase(txn_ctx->transaction_->GetTransactionId());
+    RemoveSsnReader(txn_ctx);
+    unlinked_txn_table_.emplace(current_epoch_id, txn_ctx);
+  }
+
+  LOG_TRACE("Unlinked %lu and freed %lu txn contexts", txn_ctxs.size(),
+            freed_count);
+  return freed_count;
+}
+
+size_t SsnTxnManager::GetRetainedTxnCount() {
+  std::lock_guard<std::mutex> lock(clean_mutex_);
+  end_txn_lock_.Lock();
+  size_t retained_count = end_txn_table_.size() + unlinked_txn_table_.size();
+  end_txn_lock_.Unlock();
+  return retained_count;
+}
+
 }  // End storage namespace
 }  // End peloton namespace
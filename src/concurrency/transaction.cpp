@@ -17,6 +17,7 @@
 #include "common/platform.h"
 #include "common/macros.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <iomanip>
@@ -176,6 +177,32 @@ bool Transaction::RecordDelete(const ItemPointer &location) {
   return false;
 }
 
+void Transaction::RecordUpdatedColumns(const ItemPointer &location,
+                                       const TargetList &target_list) {
+  auto &columns = updated_columns_[location.block][location.offset];
+  for (auto &target : target_list) {
+    if (std::find(columns.begin(), columns.end(), target.first) ==
+        columns.end()) {
+      columns.push_back(target.first);
+    }
+  }
+}
+
+const std::vector<oid_t> *Transaction::GetUpdatedColumns(
+    const ItemPointer &location) const {
+  auto itr = updated_columns_.find(location.block);
+  if (itr == updated_columns_.end()) {
+    return nullptr;
+  }
+
+  auto inner_itr = itr->second.find(location.offset);
+  if (inner_itr == itr->second.end()) {
+    return nullptr;
+  }
+
+  return &inner_itr->second;
+}
+
 const std::string Transaction::GetInfo() const {
   std::ostringstream os;
 
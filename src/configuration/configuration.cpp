@@ -38,6 +38,15 @@ void PrintConfiguration(){
   LOG_INFO("%30s: %10lu","Statistics", FLAGS_stats_mode);
   LOG_INFO("%30s: %10lu","Max Connections", FLAGS_max_connections);
 
+  LOG_INFO(" ");
+  LOG_INFO("%30s", "//===----------------- REPLICATION ---------------------===//");
+  LOG_INFO(" ");
+
+  LOG_INFO("%30s: %10s","Standby", FLAGS_replication_standby ? "true" : "false");
+  LOG_INFO("%30s: %10s","Standby Address", FLAGS_replication_standby_address.c_str());
+  LOG_INFO("%30s: %10s","Replication Mode", FLAGS_replication_mode.c_str());
+  LOG_INFO("%30s: %10lu","Replication Port", FLAGS_replication_port);
+
   LOG_INFO(" ");
   LOG_INFO("%30s", "//===---------------------------------------------------===//");
 
@@ -74,6 +83,23 @@ DEFINE_string(socket_family,
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
 
+DEFINE_string(replication_standby_address,
+              "",
+              "Stream the log to the standby at ip:port (default: none)");
+
+DEFINE_string(replication_mode,
+              "sync",
+              "Replication mode: sync, semisync or async (default: sync)");
+
+DEFINE_uint64(replication_port,
+              15445,
+              "Port of the log stream, served by the standby and receiving "
+              "its acknowledgements on the primary (default: 15445)");
+
+DEFINE_bool(replication_standby,
+            false,
+            "Replay the log stream of a primary (default: false)");
+
 //===----------------------------------------------------------------------===//
 // ERROR REPORTING AND LOGGING
 //===----------------------------------------------------------------------===//
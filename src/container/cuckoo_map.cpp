@@ -15,6 +15,7 @@
 #include <iostream>
 
 #include "container/cuckoo_map.h"
+#include "common/item_pointer.h"
 #include "common/logger.h"
 #include "common/macros.h"
 #include "type/types.h"
@@ -100,4 +101,6 @@ template class CuckooMap<std::thread::id,
 
 template class CuckooMap<oid_t, std::shared_ptr<stats::IndexMetric>>;
 
+template class CuckooMap<ItemPointer *, bool>;
+
 }  // End peloton namespace
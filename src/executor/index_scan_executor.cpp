@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "catalog/manager.h"
+#include "catalog/schema.h"
 #include "common/container_tuple.h"
 #include "common/logger.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -30,6 +31,7 @@
 #include "planner/index_scan_plan.h"
 #include "storage/data_table.h"
 #include "storage/masked_tuple.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "type/types.h"
@@ -113,6 +115,29 @@ bool IndexScanExecutor::DInit() {
     std::iota(full_column_ids_.begin(), full_column_ids_.end(), 0);
   }
 
+  // Projection-only scans on an index with included columns can be
+  // answered from the index keys if all output columns are stored there
+  index_only_ = false;
+  index_only_key_columns_.clear();
+  auto index_metadata = index_->GetMetadata();
+  if (index_metadata->HasIncludedColumns() == true && table_ != nullptr &&
+      predicate_ == nullptr && limit_ == false &&
+      key_column_ids_.size() != 0 && node.IsForUpdate() == false) {
+    auto &output_column_ids =
+        column_ids_.size() != 0 ? column_ids_ : full_column_ids_;
+    auto &tuple_to_key_column = index_metadata->GetTupleToIndexMapping();
+
+    index_only_ = true;
+    for (auto column_id : output_column_ids) {
+      if (tuple_to_key_column[column_id] == INVALID_OID) {
+        index_only_ = false;
+        index_only_key_columns_.clear();
+        break;
+      }
+      index_only_key_columns_.push_back(tuple_to_key_column[column_id]);
+    }
+  }
+
   return true;
 }
 
@@ -510,7 +535,16 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // Grab info from plan node
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
-  if (0 == key_column_ids_.size()) {
+  if (index_only_ == true) {
+    bool status = ExecIndexOnlyScan(tuple_location_ptrs);
+    if (status == false) return false;
+
+    // All entries were answered from the index
+    if (tuple_location_ptrs.size() == 0) {
+      done_ = true;
+      return true;
+    }
+  } else if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_location_ptrs);
   } else {
     // Limit clause accelerate
@@ -743,6 +777,98 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   return true;
 }
 
+bool IndexScanExecutor::ExecIndexOnlyScan(
+    std::vector<ItemPointer *> &tuple_location_ptrs) {
+  LOG_TRACE("ExecIndexOnlyScan");
+
+  std::vector<ItemPointer *> entry_ptrs;
+  std::vector<std::unique_ptr<storage::Tuple>> entry_keys;
+
+  if (index_->ScanWithKeys(values_, key_column_ids_, expr_types_,
+                           ScanDirectionType::FORWARD, entry_ptrs, entry_keys,
+                           &index_predicate_.GetConjunctionList()[0],
+                           executor_context_->GetPool()) == false) {
+    // The index type can not return its keys, visit the table instead
+    index_->Scan(values_, key_column_ids_, expr_types_,
+                 ScanDirectionType::FORWARD, tuple_location_ptrs,
+                 &index_predicate_.GetConjunctionList()[0]);
+    return true;
+  }
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::vector<const storage::Tuple *> index_only_keys;
+
+  for (size_t entry_itr = 0; entry_itr < entry_ptrs.size(); entry_itr++) {
+    ItemPointer *tuple_location_ptr = entry_ptrs[entry_itr];
+    const storage::Tuple *key = entry_keys[entry_itr].get();
+
+    // The scan range is closed and covers all included values, so check
+    // the exact key conditions on the entry itself
+    if (index_->Compare(*key, key_column_ids_, expr_types_, values_) ==
+        false) {
+      continue;
+    }
+
+    // Visibility hint: the entry holds the values of the visible version if
+    // the latest version is visible and the version chain never changed its
+    // key or included columns. Only the tile group header is read.
+    ItemPointer tuple_location = *tuple_location_ptr;
+    auto tile_group_header =
+        manager.GetTileGroup(tuple_location.block)->GetHeader();
+
+    if (transaction_manager.IsVisible(current_txn, tile_group_header,
+                                      tuple_location.offset) !=
+            VisibilityType::OK ||
+        index_->HasCoveredUpdate(tuple_location_ptr) == true) {
+      tuple_location_ptrs.push_back(tuple_location_ptr);
+      continue;
+    }
+
+    auto res = transaction_manager.PerformRead(current_txn, tuple_location);
+    if (!res) {
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+      return res;
+    }
+
+    index_only_keys.push_back(key);
+  }
+
+  LOG_TRACE("Answered %lu of %lu entries from index %s",
+            index_only_keys.size(), entry_ptrs.size(),
+            index_->GetName().c_str());
+
+  if (index_only_keys.size() == 0) {
+    return true;
+  }
+  index_only_tuple_count_ += index_only_keys.size();
+
+  // Materialize the output columns from the index keys
+  auto &output_column_ids =
+      column_ids_.size() != 0 ? column_ids_ : full_column_ids_;
+  std::unique_ptr<catalog::Schema> output_schema(
+      catalog::Schema::CopySchema(table_->GetSchema(), output_column_ids));
+  std::shared_ptr<storage::Tile> output_tile(storage::TileFactory::GetTempTile(
+      *output_schema, index_only_keys.size()));
+
+  for (oid_t tuple_itr = 0; tuple_itr < index_only_keys.size(); tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < index_only_key_columns_.size();
+         column_itr++) {
+      output_tile->SetValue(index_only_keys[tuple_itr]->GetValue(
+                                index_only_key_columns_[column_itr]),
+                            tuple_itr, column_itr);
+    }
+  }
+
+  result_.push_back(LogicalTileFactory::WrapTiles({output_tile}));
+
+  return true;
+}
+
 void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
     std::vector<ItemPointer> &tuple_locations) {
   while (left_open_) {
@@ -14,14 +14,10 @@
 #include <vector>
 
 #include "common/logger.h"
-#include "type/value.h"
-#include "executor/logical_tile.h"
 #include "executor/populate_index_executor.h"
 #include "executor/executor_context.h"
 #include "planner/populate_index_plan.h"
-#include "expression/tuple_value_expression.h"
 #include "storage/data_table.h"
-#include "storage/tile.h"
 
 namespace peloton {
 namespace executor {
@@ -54,48 +50,22 @@ bool PopulateIndexExecutor::DInit() {
 bool PopulateIndexExecutor::DExecute() {
   LOG_TRACE("Populate Index Executor");
   PL_ASSERT(executor_context_ != nullptr);
-  auto current_txn = executor_context_->GetTransaction();
-  auto executor_pool = executor_context_->GetPool();
   if (done_ == false) {
-    //Get the output from seq_scan
-    while (children_[0]->Execute()) {
-      child_tiles_.emplace_back(children_[0]->GetOutput());
-    }
-
-    if (child_tiles_.size() == 0) {
-      LOG_TRACE("PopulateIndex Executor : false -- no child tiles ");
-      return false;
-    }
-
-    auto target_table_schema = target_table_->GetSchema();
-
-    std::unique_ptr<storage::Tuple> tuple(
-        new storage::Tuple(target_table_schema, true));
-
-    // Go over the logical tile and insert in the index the values
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
-      for (oid_t tuple_id : *tile) {
-        expression::ContainerTuple<LogicalTile> cur_tuple(tile, tuple_id);
-
-        // Materialize the logical tile tuple
-        for (oid_t column_itr = 0; column_itr < column_ids_.size();
-             column_itr++) {
-          type::Value val = (cur_tuple.GetValue(column_itr));
-          tuple->SetValue(column_ids_[column_itr], val, executor_pool);
-        }
-
-        ItemPointer location(tile->GetBaseTile(0)->GetTileGroup()->GetTileGroupId(),
-                             tuple_id);
-
-        // insert tuple into the index.
-        ItemPointer *index_entry_ptr = nullptr;
-        target_table_->InsertInIndexes(tuple.get(), location, current_txn,
-                                       &index_entry_ptr);
-      }
+    // The child creates the index
+    children_[0]->Execute();
+
+    // The index being populated is the one just added to the table
+    auto index_count = target_table_->GetIndexCount();
+    PL_ASSERT(index_count > 0);
+    auto target_index = target_table_->GetIndex(index_count - 1);
+
+    // The index is already attached to the table, so tuples inserted from
+    // now on are indexed by their writers. The tile groups that exist at
+    // this point are indexed by a pool of workers.
+    auto tile_group_count = target_table_->GetTileGroupCount();
+    if (target_table_->PopulateIndex(target_index.get(), 0, tile_group_count,
+                                     0, true) == false) {
+      LOG_ERROR("Failed to populate index %s", target_index->GetName().c_str());
     }
 
     done_ = true;
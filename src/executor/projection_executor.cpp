@@ -13,12 +13,16 @@
 
 #include "executor/projection_executor.h"
 
+#include <algorithm>
+
 #include "planner/projection_plan.h"
 #include "common/logger.h"
 #include "type/types.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "common/container_tuple.h"
+#include "expression/vector_batch.h"
 #include "storage/tile.h"
 #include "storage/data_table.h"
 
@@ -75,19 +79,62 @@ bool ProjectionExecutor::DExecute() {
     std::shared_ptr<storage::Tile> dest_tile(
         storage::TileFactory::GetTempTile(*schema_, num_tuples));
 
-    // Create projections tuple-at-a-time from original tile
-    oid_t new_tuple_id = 0;
+    std::vector<oid_t> old_tuple_ids;
     for (oid_t old_tuple_id : *source_tile) {
-      storage::Tuple *buffer = new storage::Tuple(schema_, true);
-      expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
-                                                    old_tuple_id);
-      project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
+      old_tuple_ids.push_back(old_tuple_id);
+    }
 
-      // Insert projected tuple into the new tile
-      dest_tile.get()->InsertTuple(new_tuple_id, buffer);
+    type::AbstractPool *pool = nullptr;
+    if (executor_context_ != nullptr) pool = executor_context_->GetPool();
 
-      delete buffer;
-      new_tuple_id++;
+    auto &target_list = project_info_->GetTargetList();
+    oid_t new_tuple_id = 0;
+    for (size_t offset = 0; offset < old_tuple_ids.size();
+         offset += DEFAULT_VECTOR_SIZE) {
+      auto end = std::min(offset + DEFAULT_VECTOR_SIZE, old_tuple_ids.size());
+      expression::VectorBatch batch(
+          source_tile.get(), std::vector<oid_t>(old_tuple_ids.begin() + offset,
+                                                old_tuple_ids.begin() + end));
+
+      // Evaluate the targets with batch kernels a batch of tuples at a time
+      std::vector<expression::ColumnVector> batch_values(target_list.size());
+      std::vector<bool> batch_targets(target_list.size());
+      for (size_t target_idx = 0; target_idx < target_list.size();
+           target_idx++) {
+        auto expr = target_list[target_idx].second;
+        batch_targets[target_idx] = expr->EvaluateBatch(
+            batch, batch_values[target_idx], executor_context_);
+      }
+
+      // Create projections tuple-at-a-time from original tile
+      for (size_t row = 0; row < batch.GetSize(); row++) {
+        storage::Tuple *buffer = new storage::Tuple(schema_, true);
+        expression::ContainerTuple<LogicalTile> tuple(
+            source_tile.get(), batch.GetTupleIds()[row]);
+        project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_,
+                                &batch_targets);
+
+        for (size_t target_idx = 0; target_idx < target_list.size();
+             target_idx++) {
+          if (batch_targets[target_idx] == false) {
+            continue;
+          }
+
+          auto col_id = target_list[target_idx].first;
+          auto &values = batch_values[target_idx];
+          if (schema_->GetType(col_id) == values.GetTypeId()) {
+            values.Store(row, buffer->GetDataPtr(col_id));
+          } else {
+            buffer->SetValue(col_id, values.GetValue(row), pool);
+          }
+        }
+
+        // Insert projected tuple into the new tile
+        dest_tile.get()->InsertTuple(new_tuple_id, buffer);
+
+        delete buffer;
+        new_tuple_id++;
+      }
     }
 
     // Wrap physical tile in logical tile and return it
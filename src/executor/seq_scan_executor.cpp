@@ -16,12 +16,14 @@
 #include <utility>
 #include <vector>
 #include <numeric>
+#include <algorithm>
 
 #include "type/types.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/executor_context.h"
 #include "expression/abstract_expression.h"
+#include "expression/vector_batch.h"
 #include "common/container_tuple.h"
 #include "planner/create_plan.h"
 #include "storage/data_table.h"
@@ -94,14 +96,26 @@ bool SeqScanExecutor::DExecute() {
       std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
 
       if (predicate_ != nullptr) {
-        // Invalidate tuples that don't satisfy the predicate.
+        std::vector<oid_t> tuple_ids;
         for (oid_t tuple_id : *tile) {
-          expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
-          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-          if (eval.IsFalse()) {
-            // if (predicate_->Evaluate(&tuple, nullptr, executor_context_)
-            //        .IsFalse()) {
-            tile->RemoveVisibility(tuple_id);
+          tuple_ids.push_back(tuple_id);
+        }
+
+        // Invalidate tuples that don't satisfy the predicate, a batch of
+        // tuples at a time.
+        for (size_t offset = 0; offset < tuple_ids.size();
+             offset += DEFAULT_VECTOR_SIZE) {
+          auto end = std::min(offset + DEFAULT_VECTOR_SIZE, tuple_ids.size());
+          expression::VectorBatch batch(
+              tile.get(), std::vector<oid_t>(tuple_ids.begin() + offset,
+                                             tuple_ids.begin() + end));
+          expression::ColumnVector eval;
+          batch.EvaluatePredicate(predicate_, eval, executor_context_);
+
+          for (size_t row = 0; row < batch.GetSize(); row++) {
+            if (eval.IsFalse(row)) {
+              tile->RemoveVisibility(batch.GetTupleIds()[row]);
+            }
           }
         }
       }
@@ -160,46 +174,52 @@ bool SeqScanExecutor::DExecute() {
       // and applying the predicate.
       std::vector<oid_t> position_list;
       for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-
         auto visibility = transaction_manager.IsVisible(
             current_txn, tile_group_header, tuple_id);
 
         // check transaction visibility
         if (visibility == VisibilityType::OK) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(current_txn, location,
-                                                       acquire_owner);
-            if (!res) {
-              transaction_manager.SetTransactionResult(current_txn,
-                                                       ResultType::FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval =
-                predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(current_txn, location,
-                                                         acquire_owner);
-              if (!res) {
-                transaction_manager.SetTransactionResult(current_txn,
-                                                         ResultType::FAILURE);
-                return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
-              }
+          position_list.push_back(tuple_id);
+        }
+      }
+
+      // if the tuple is visible, then perform predicate evaluation, a batch
+      // of tuples at a time.
+      if (predicate_ != nullptr) {
+        std::vector<oid_t> visible_tuples(std::move(position_list));
+        position_list.clear();
+
+        for (size_t offset = 0; offset < visible_tuples.size();
+             offset += DEFAULT_VECTOR_SIZE) {
+          auto end =
+              std::min(offset + DEFAULT_VECTOR_SIZE, visible_tuples.size());
+          expression::VectorBatch batch(
+              tile_group.get(),
+              std::vector<oid_t>(visible_tuples.begin() + offset,
+                                 visible_tuples.begin() + end));
+          expression::ColumnVector eval;
+          LOG_TRACE("Evaluate predicate for %lu tuples", batch.GetSize());
+          batch.EvaluatePredicate(predicate_, eval, executor_context_);
+
+          for (size_t row = 0; row < batch.GetSize(); row++) {
+            if (eval.IsTrue(row)) {
+              position_list.push_back(batch.GetTupleIds()[row]);
             }
           }
         }
       }
 
+      for (oid_t tuple_id : position_list) {
+        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+        auto res = transaction_manager.PerformRead(current_txn, location,
+                                                   acquire_owner);
+        if (!res) {
+          transaction_manager.SetTransactionResult(current_txn,
+                                                   ResultType::FAILURE);
+          return res;
+        }
+      }
+
       // Don't return empty tiles
       if (position_list.size() == 0) {
         continue;
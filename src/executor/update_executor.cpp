@@ -19,6 +19,7 @@
 #include "common/container_tuple.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "logging/log_manager.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
@@ -121,6 +122,14 @@ bool UpdateExecutor::PerformUpdatePrimaryKey(bool is_owner, oid_t tile_group_id,
 
   return true;
 }
+void UpdateExecutor::RecordUpdatedColumns(
+    concurrency::Transaction *current_txn, const ItemPointer &location) {
+  if (logging::LogManager::GetInstance().IsInLoggingMode() == false) {
+    return;
+  }
+  current_txn->RecordUpdatedColumns(location, project_info_->GetTargetList());
+}
+
 /**
  * @brief updates a set of columns
  * @return true on success, false otherwise.
@@ -177,6 +186,7 @@ bool UpdateExecutor::DExecute() {
         // Current rb segment is OK, just overwrite the tuple in place
         tile_group->CopyTuple(new_tuple.get(), physical_tuple_id);
         transaction_manager.PerformUpdate(current_txn, old_location);
+        RecordUpdatedColumns(current_txn, old_location);
 
       } else if (transaction_manager.IsOwnable(current_txn, tile_group_header,
                                                physical_tuple_id)) {
@@ -230,6 +240,7 @@ bool UpdateExecutor::DExecute() {
 //        LOG_INFO("perform update old location: %u, %u", old_location.block, old_location.offset);
 //        LOG_INFO("perform update new location: %u, %u", new_location.block, new_location.offset);
         transaction_manager.PerformUpdate(current_txn, old_location, new_location);
+        RecordUpdatedColumns(current_txn, new_location);
 
       // TODO: Why don't we also do this in the if branch above?
       executor_context_->num_processed += 1;  // updated one
@@ -292,6 +303,7 @@ bool UpdateExecutor::DExecute() {
                                   executor_context_);
 
           transaction_manager.PerformUpdate(current_txn, old_location);
+          RecordUpdatedColumns(current_txn, old_location);
         }
       }
         // if we have already got the
@@ -391,6 +403,7 @@ bool UpdateExecutor::DExecute() {
                       new_location.offset);
             transaction_manager.PerformUpdate(current_txn, old_location,
                                               new_location);
+            RecordUpdatedColumns(current_txn, new_location);
 
             // TODO: Why don't we also do this in the if branch above?
             executor_context_->num_processed += 1;  // updated one
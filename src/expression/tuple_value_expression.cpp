@@ -13,6 +13,7 @@
 #include <string>
 #include "common/abstract_tuple.h"
 #include "expression/tuple_value_expression.h"
+#include "expression/vector_batch.h"
 #include "util/hash_util.h"
 
 namespace peloton {
@@ -29,6 +30,22 @@ type::Value TupleValueExpression::Evaluate(
   }
 }
 
+bool TupleValueExpression::EvaluateBatch(
+    VectorBatch &batch, ColumnVector &result,
+    UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
+  // the tuples of a batch only take the place of the left tuple
+  if (tuple_idx_ != 0) {
+    return false;
+  }
+
+  auto column = batch.GetColumn(value_idx_);
+  if (column == nullptr) {
+    return false;
+  }
+  result = *column;
+  return true;
+}
+
 hash_t TupleValueExpression::Hash() const {
   hash_t hash = HashUtil::Hash(&exp_type_);
   hash = HashUtil::CombineHashes(hash,
@@ -0,0 +1,519 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vector_batch.cpp
+//
+// Identification: src/expression/vector_batch.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/vector_batch.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "common/container_tuple.h"
+#include "executor/logical_tile.h"
+#include "expression/abstract_expression.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace expression {
+
+//===--------------------------------------------------------------------===//
+// Column Vector
+//===--------------------------------------------------------------------===//
+
+bool ColumnVector::IsVectorType(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+    case type::Type::DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void ColumnVector::Reset(type::Type::TypeId type_id, size_t size) {
+  PL_ASSERT(IsVectorType(type_id));
+  type_id_ = type_id;
+  if (type_id == type::Type::DECIMAL) {
+    decimals_.resize(size);
+    integers_.clear();
+  } else {
+    integers_.resize(size);
+    decimals_.clear();
+  }
+  nulls_.resize(size);
+}
+
+bool ColumnVector::Fill(const type::Value &value, size_t size) {
+  if (IsVectorType(value.GetTypeId()) == false) {
+    return false;
+  }
+
+  Reset(value.GetTypeId(), size);
+  if (value.IsNull()) {
+    std::fill(nulls_.begin(), nulls_.end(), 1);
+  } else if (IsDecimal()) {
+    std::fill(decimals_.begin(), decimals_.end(), value.GetAs<double>());
+    std::fill(nulls_.begin(), nulls_.end(), 0);
+  } else {
+    int64_t integer = 0;
+    switch (type_id_) {
+      case type::Type::BOOLEAN:
+      case type::Type::TINYINT:
+        integer = value.GetAs<int8_t>();
+        break;
+      case type::Type::SMALLINT:
+        integer = value.GetAs<int16_t>();
+        break;
+      case type::Type::INTEGER:
+        integer = value.GetAs<int32_t>();
+        break;
+      default:
+        integer = value.GetAs<int64_t>();
+        break;
+    }
+    std::fill(integers_.begin(), integers_.end(), integer);
+    std::fill(nulls_.begin(), nulls_.end(), 0);
+  }
+  return true;
+}
+
+void ColumnVector::Load(size_t row, const char *location) {
+  switch (type_id_) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT: {
+      int8_t value = *reinterpret_cast<const int8_t *>(location);
+      integers_[row] = value;
+      nulls_[row] = (value == type::PELOTON_INT8_NULL);
+      break;
+    }
+    case type::Type::SMALLINT: {
+      int16_t value = *reinterpret_cast<const int16_t *>(location);
+      integers_[row] = value;
+      nulls_[row] = (value == type::PELOTON_INT16_NULL);
+      break;
+    }
+    case type::Type::INTEGER: {
+      int32_t value = *reinterpret_cast<const int32_t *>(location);
+      integers_[row] = value;
+      nulls_[row] = (value == type::PELOTON_INT32_NULL);
+      break;
+    }
+    case type::Type::BIGINT: {
+      int64_t value = *reinterpret_cast<const int64_t *>(location);
+      integers_[row] = value;
+      nulls_[row] = (value == type::PELOTON_INT64_NULL);
+      break;
+    }
+    case type::Type::DECIMAL: {
+      double value = *reinterpret_cast<const double *>(location);
+      decimals_[row] = value;
+      nulls_[row] = (value == type::PELOTON_DECIMAL_NULL);
+      break;
+    }
+    default:
+      PL_ASSERT(false);
+  }
+}
+
+void ColumnVector::Store(size_t row, char *location) const {
+  bool is_null = IsNull(row);
+  switch (type_id_) {
+    case type::Type::BOOLEAN:
+      *reinterpret_cast<int8_t *>(location) =
+          is_null ? type::PELOTON_BOOLEAN_NULL : (int8_t)integers_[row];
+      break;
+    case type::Type::TINYINT:
+      *reinterpret_cast<int8_t *>(location) =
+          is_null ? type::PELOTON_INT8_NULL : (int8_t)integers_[row];
+      break;
+    case type::Type::SMALLINT:
+      *reinterpret_cast<int16_t *>(location) =
+          is_null ? type::PELOTON_INT16_NULL : (int16_t)integers_[row];
+      break;
+    case type::Type::INTEGER:
+      *reinterpret_cast<int32_t *>(location) =
+          is_null ? type::PELOTON_INT32_NULL : (int32_t)integers_[row];
+      break;
+    case type::Type::BIGINT:
+      *reinterpret_cast<int64_t *>(location) =
+          is_null ? type::PELOTON_INT64_NULL : integers_[row];
+      break;
+    case type::Type::DECIMAL:
+      *reinterpret_cast<double *>(location) =
+          is_null ? type::PELOTON_DECIMAL_NULL : decimals_[row];
+      break;
+    default:
+      PL_ASSERT(false);
+  }
+}
+
+type::Value ColumnVector::GetValue(size_t row) const {
+  if (IsNull(row)) {
+    return type::ValueFactory::GetNullValueByType(type_id_);
+  }
+
+  switch (type_id_) {
+    case type::Type::BOOLEAN:
+      return type::ValueFactory::GetBooleanValue((int8_t)integers_[row]);
+    case type::Type::TINYINT:
+      return type::ValueFactory::GetTinyIntValue((int8_t)integers_[row]);
+    case type::Type::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue((int16_t)integers_[row]);
+    case type::Type::INTEGER:
+      return type::ValueFactory::GetIntegerValue((int32_t)integers_[row]);
+    case type::Type::BIGINT:
+      return type::ValueFactory::GetBigIntValue(integers_[row]);
+    case type::Type::DECIMAL:
+      return type::ValueFactory::GetDecimalValue(decimals_[row]);
+    default:
+      throw Exception("Invalid type of a column vector.");
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Vector Batch
+//===--------------------------------------------------------------------===//
+
+VectorBatch::VectorBatch(storage::TileGroup *tile_group,
+                         std::vector<oid_t> &&tuple_ids)
+    : tile_group_(tile_group), tuple_ids_(std::move(tuple_ids)) {
+  PL_ASSERT(tuple_ids_.size() <= DEFAULT_VECTOR_SIZE);
+}
+
+VectorBatch::VectorBatch(executor::LogicalTile *logical_tile,
+                         std::vector<oid_t> &&tuple_ids)
+    : logical_tile_(logical_tile), tuple_ids_(std::move(tuple_ids)) {
+  PL_ASSERT(tuple_ids_.size() <= DEFAULT_VECTOR_SIZE);
+}
+
+const ColumnVector *VectorBatch::GetColumn(oid_t column_id) {
+  auto entry = columns_.find(column_id);
+  if (entry != columns_.end()) {
+    return entry->second.get();
+  }
+
+  std::unique_ptr<ColumnVector> column(new ColumnVector());
+  bool loaded = (tile_group_ != nullptr)
+                    ? LoadTileGroupColumn(column_id, *column)
+                    : LoadLogicalTileColumn(column_id, *column);
+  if (loaded == false) {
+    column.reset();
+  }
+
+  auto column_ptr = column.get();
+  columns_[column_id] = std::move(column);
+  return column_ptr;
+}
+
+bool VectorBatch::LoadTileGroupColumn(oid_t column_id, ColumnVector &column) {
+  oid_t tile_offset, tile_column_id;
+  tile_group_->LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  auto tile = tile_group_->GetTile(tile_offset);
+  auto schema = tile->GetSchema();
+
+  auto type_id = schema->GetType(tile_column_id);
+  if (ColumnVector::IsVectorType(type_id) == false) {
+    return false;
+  }
+
+  size_t column_offset = schema->GetOffset(tile_column_id);
+  column.Reset(type_id, tuple_ids_.size());
+  for (size_t row = 0; row < tuple_ids_.size(); row++) {
+    column.Load(row, tile->GetTupleLocation(tuple_ids_[row]) + column_offset);
+  }
+  return true;
+}
+
+bool VectorBatch::LoadLogicalTileColumn(oid_t column_id,
+                                        ColumnVector &column) {
+  auto &column_info = logical_tile_->GetColumnInfo(column_id);
+  auto tile = column_info.base_tile.get();
+  auto schema = tile->GetSchema();
+
+  auto type_id = schema->GetType(column_info.origin_column_id);
+  if (ColumnVector::IsVectorType(type_id) == false) {
+    return false;
+  }
+
+  auto &position_list =
+      logical_tile_->GetPositionLists()[column_info.position_list_idx];
+  size_t column_offset = schema->GetOffset(column_info.origin_column_id);
+  column.Reset(type_id, tuple_ids_.size());
+  for (size_t row = 0; row < tuple_ids_.size(); row++) {
+    oid_t base_tuple_id = position_list[tuple_ids_[row]];
+    // the outer joins fill in missing tuples with nulls
+    if (base_tuple_id == NULL_OID) {
+      column.SetNull(row);
+    } else {
+      column.Load(row, tile->GetTupleLocation(base_tuple_id) + column_offset);
+    }
+  }
+  return true;
+}
+
+void VectorBatch::EvaluatePredicate(const AbstractExpression *predicate,
+                                    ColumnVector &result,
+                                    executor::ExecutorContext *context) {
+  if (predicate->EvaluateBatch(*this, result, context) &&
+      result.GetTypeId() == type::Type::BOOLEAN) {
+    return;
+  }
+
+  result.Reset(type::Type::BOOLEAN, tuple_ids_.size());
+  for (size_t row = 0; row < tuple_ids_.size(); row++) {
+    type::Value eval;
+    if (tile_group_ != nullptr) {
+      ContainerTuple<storage::TileGroup> tuple(tile_group_, tuple_ids_[row]);
+      eval = predicate->Evaluate(&tuple, nullptr, context);
+    } else {
+      ContainerTuple<executor::LogicalTile> tuple(logical_tile_,
+                                                  tuple_ids_[row]);
+      eval = predicate->Evaluate(&tuple, nullptr, context);
+    }
+
+    if (eval.IsTrue()) {
+      result.SetInteger(row, 1);
+    } else if (eval.IsFalse()) {
+      result.SetInteger(row, 0);
+    } else {
+      result.SetNull(row);
+    }
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Vector Kernels
+//===--------------------------------------------------------------------===//
+
+static inline bool IsNumericVector(const ColumnVector &vector) {
+  return vector.GetTypeId() != type::Type::BOOLEAN;
+}
+
+// Integers that fit the type without being its null value
+static inline bool IsInRange(type::Type::TypeId type_id, int64_t value) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+      return value >= type::PELOTON_INT8_MIN && value <= type::PELOTON_INT8_MAX;
+    case type::Type::SMALLINT:
+      return value >= type::PELOTON_INT16_MIN &&
+             value <= type::PELOTON_INT16_MAX;
+    case type::Type::INTEGER:
+      return value >= type::PELOTON_INT32_MIN &&
+             value <= type::PELOTON_INT32_MAX;
+    default:
+      return value >= type::PELOTON_INT64_MIN;
+  }
+}
+
+// Integers are compared as integers, and as decimals with a decimal
+template <template <class> class Compare>
+static void CompareLoop(const ColumnVector &left, const ColumnVector &right,
+                        ColumnVector &result) {
+  size_t size = left.GetSize();
+  if (left.IsDecimal() || right.IsDecimal()) {
+    Compare<double> compare;
+    for (size_t row = 0; row < size; row++) {
+      result.SetInteger(row, compare(left.GetDecimal(row),
+                                     right.GetDecimal(row)));
+    }
+  } else {
+    Compare<int64_t> compare;
+    for (size_t row = 0; row < size; row++) {
+      result.SetInteger(row, compare(left.GetInteger(row),
+                                     right.GetInteger(row)));
+    }
+  }
+
+  for (size_t row = 0; row < size; row++) {
+    if (left.IsNull(row) || right.IsNull(row)) {
+      result.SetNull(row);
+    }
+  }
+}
+
+bool VectorKernels::Compare(ExpressionType type, const ColumnVector &left,
+                            const ColumnVector &right, ColumnVector &result) {
+  if (IsNumericVector(left) == false || IsNumericVector(right) == false) {
+    return false;
+  }
+
+  PL_ASSERT(left.GetSize() == right.GetSize());
+  result.Reset(type::Type::BOOLEAN, left.GetSize());
+
+  switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+      CompareLoop<std::equal_to>(left, right, result);
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      CompareLoop<std::not_equal_to>(left, right, result);
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      CompareLoop<std::less>(left, right, result);
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      CompareLoop<std::greater>(left, right, result);
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      CompareLoop<std::less_equal>(left, right, result);
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      CompareLoop<std::greater_equal>(left, right, result);
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool VectorKernels::Arithmetic(ExpressionType type, const ColumnVector &left,
+                               const ColumnVector &right,
+                               ColumnVector &result) {
+  if (IsNumericVector(left) == false || IsNumericVector(right) == false) {
+    return false;
+  }
+
+  PL_ASSERT(left.GetSize() == right.GetSize());
+  size_t size = left.GetSize();
+
+  // the result has the wider type of the two, as in the value arithmetic
+  auto result_type = std::max(left.GetTypeId(), right.GetTypeId());
+  result.Reset(result_type, size);
+
+  for (size_t row = 0; row < size; row++) {
+    if (left.IsNull(row) || right.IsNull(row)) {
+      result.SetNull(row);
+      continue;
+    }
+
+    if (result.IsDecimal()) {
+      double x = left.GetDecimal(row);
+      double y = right.GetDecimal(row);
+      switch (type) {
+        case ExpressionType::OPERATOR_PLUS:
+          result.SetDecimal(row, x + y);
+          break;
+        case ExpressionType::OPERATOR_MINUS:
+          result.SetDecimal(row, x - y);
+          break;
+        case ExpressionType::OPERATOR_MULTIPLY:
+          result.SetDecimal(row, x * y);
+          break;
+        case ExpressionType::OPERATOR_DIVIDE:
+          if (y == 0) {
+            return false;
+          }
+          result.SetDecimal(row, x / y);
+          break;
+        default:
+          return false;
+      }
+      continue;
+    }
+
+    int64_t x = left.GetInteger(row);
+    int64_t y = right.GetInteger(row);
+    int64_t value;
+    bool overflow = false;
+    switch (type) {
+      case ExpressionType::OPERATOR_PLUS:
+        overflow = __builtin_add_overflow(x, y, &value);
+        break;
+      case ExpressionType::OPERATOR_MINUS:
+        overflow = __builtin_sub_overflow(x, y, &value);
+        break;
+      case ExpressionType::OPERATOR_MULTIPLY:
+        overflow = __builtin_mul_overflow(x, y, &value);
+        break;
+      case ExpressionType::OPERATOR_DIVIDE:
+        if (y == 0) {
+          return false;
+        }
+        value = x / y;
+        break;
+      default:
+        return false;
+    }
+
+    if (overflow || IsInRange(result_type, value) == false) {
+      return false;
+    }
+    result.SetInteger(row, value);
+  }
+  return true;
+}
+
+bool VectorKernels::Conjunction(ExpressionType type, const ColumnVector &left,
+                                const ColumnVector &right,
+                                ColumnVector &result) {
+  if (left.GetTypeId() != type::Type::BOOLEAN ||
+      right.GetTypeId() != type::Type::BOOLEAN) {
+    return false;
+  }
+
+  PL_ASSERT(left.GetSize() == right.GetSize());
+  size_t size = left.GetSize();
+  result.Reset(type::Type::BOOLEAN, size);
+
+  switch (type) {
+    case ExpressionType::CONJUNCTION_AND:
+      for (size_t row = 0; row < size; row++) {
+        if (left.IsTrue(row) && right.IsTrue(row)) {
+          result.SetInteger(row, 1);
+        } else if (left.IsFalse(row) || right.IsFalse(row)) {
+          result.SetInteger(row, 0);
+        } else {
+          result.SetNull(row);
+        }
+      }
+      break;
+    case ExpressionType::CONJUNCTION_OR:
+      for (size_t row = 0; row < size; row++) {
+        if (left.IsFalse(row) && right.IsFalse(row)) {
+          result.SetInteger(row, 0);
+        } else if (left.IsTrue(row) || right.IsTrue(row)) {
+          result.SetInteger(row, 1);
+        } else {
+          result.SetNull(row);
+        }
+      }
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool VectorKernels::Not(const ColumnVector &child, ColumnVector &result) {
+  if (child.GetTypeId() != type::Type::BOOLEAN) {
+    return false;
+  }
+
+  size_t size = child.GetSize();
+  result.Reset(type::Type::BOOLEAN, size);
+  for (size_t row = 0; row < size; row++) {
+    if (child.IsTrue(row)) {
+      result.SetInteger(row, 0);
+    } else if (child.IsFalse(row)) {
+      result.SetInteger(row, 1);
+    } else {
+      result.SetNull(row);
+    }
+  }
+  return true;
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -11,16 +11,29 @@
 //===----------------------------------------------------------------------===//
 
 #include "gc/transaction_level_gc_manager.h"
+#include "index/index.h"
 #include "storage/tuple.h"
 #include "storage/database.h"
+#include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "catalog/manager.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "common/container_tuple.h"
 
 namespace peloton {
 namespace gc {
 
+// recycled slots taken by this backend. The gc holds on to the cache
+// after the backend exits, until it handed the slots back
+thread_local static std::shared_ptr<FreeSlotCache> local_free_slot_cache;
+
+static uint64_t GetSteadyClockMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
 
 bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
   auto &manager = catalog::Manager::GetInstance();
@@ -49,6 +62,8 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
 void TransactionLevelGCManager::Running(const int &thread_id) {
   PL_ASSERT(is_running_ == true);
   uint32_t backoff_shifts = 0;
+  auto last_compaction = std::chrono::steady_clock::now();
+  auto last_cache_flush = std::chrono::steady_clock::now();
   while (true) {
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     auto max_cid = txn_manager.GetMaxCommittedCid();
@@ -59,13 +74,33 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
       continue;
     }
 
+    gc_locks_[thread_id].Lock();
+
     int reclaimed_count = Reclaim(thread_id, max_cid);
 
     int unlinked_count = Unlink(thread_id, max_cid);
 
+    gc_locks_[thread_id].Unlock();
+
     if (is_running_ == false) {
       return;
     }
+
+    if (thread_id == 0 && compaction_enabled_ == true &&
+        std::chrono::steady_clock::now() - last_compaction >=
+            std::chrono::milliseconds(COMPACTION_INTERVAL_MS)) {
+      CompactTileGroups();
+      last_compaction = std::chrono::steady_clock::now();
+    }
+
+    // slots cached by idle backends are not left unused
+    if (thread_id == 0 &&
+        std::chrono::steady_clock::now() - last_cache_flush >=
+            std::chrono::milliseconds(FREE_SLOT_CACHE_IDLE_MS)) {
+      FlushFreeSlotCaches();
+      last_cache_flush = std::chrono::steady_clock::now();
+    }
+
     if (reclaimed_count == 0 && unlinked_count == 0) {
       // sleep at most 0.8192 s
       if (backoff_shifts < 13) {
@@ -84,33 +119,110 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<GCSet> gc_set, const cid_t &timestamp) {
   // Add the garbage context to the lock-free queue
   std::shared_ptr<GarbageContext> gc_context(new GarbageContext(gc_set, timestamp));
-  unlink_queues_[HashToThread(gc_context->timestamp_)]->Enqueue(gc_context);
+  unsigned int thread_id = HashToThread(gc_context->timestamp_);
+  queued_version_count_ += gc_context->version_count_;
+  queue_depths_[thread_id]++;
+  unlink_queues_[thread_id]->Enqueue(gc_context);
+
+  // the committing backend does a bounded share of the gc thread's work,
+  // so that garbage does not pile up when gc threads fall behind
+  if (cooperative_mode_ == true) {
+    CooperativeCollect(thread_id);
+  }
+
+  if (writer_throttle_ == true) {
+    ThrottleWriter();
+  }
+}
+
+// executed by a backend at commit, after it left its epoch, such that the
+// delay holds back its next transaction but not the gc.
+void TransactionLevelGCManager::ThrottleWriter() {
+  size_t backlog = GetBacklogVersionCount();
+  size_t threshold = std::max(throttle_threshold_, (size_t)1);
+  if (backlog <= threshold) {
+    return;
+  }
+
+  uint64_t delay_us = std::min((uint64_t)THROTTLE_DELAY_US * backlog / threshold,
+                               (uint64_t)MAX_THROTTLE_DELAY_US);
+  throttled_txn_count_++;
+
+  LOG_TRACE("Delaying writer by %lu us, %lu versions waiting for gc",
+            delay_us, backlog);
+  std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
 }
 
-int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid) {
+// executed by a backend at commit. the gc thread's queues are skipped if
+// the gc thread or another backend is working on them.
+int TransactionLevelGCManager::CooperativeCollect(const int &thread_id) {
+  if (gc_locks_[thread_id].TryLock() == false) {
+    return 0;
+  }
+
+  int collected_count = 0;
+
+  auto max_cid = concurrency::TransactionManagerFactory::GetInstance().GetMaxCommittedCid();
+  if (max_cid != MAX_CID) {
+    collected_count += Reclaim(thread_id, max_cid, COOPERATIVE_ATTEMPT_COUNT);
+    collected_count += Unlink(thread_id, max_cid, COOPERATIVE_ATTEMPT_COUNT);
+  }
+
+  gc_locks_[thread_id].Unlock();
+
+  LOG_TRACE("Backend collected %d garbage contexts of gc thread %d",
+            collected_count, thread_id);
+  return collected_count;
+}
+
+int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid,
+                                      const size_t max_attempt_count) {
   
   int tuple_counter = 0;
 
+  // index entries of the unlinked versions, deleted in a batch per index
+  StaleIndexEntries stale_entries;
+
   // check if any garbage can be unlinked from indexes.
-  // every time we garbage collect at most MAX_ATTEMPT_COUNT tuples.
+  // every time we garbage collect at most max_attempt_count tuples.
   std::vector<std::shared_ptr<GarbageContext>> garbages;
 
+  // versions that are not yet older than all snapshots may be invisible to
+  // all running transactions nonetheless
+  bool trim_versions =
+      version_trimming_ == true &&
+      concurrency::TransactionManagerFactory::GetProtocol() ==
+          ConcurrencyType::TIMESTAMP_ORDERING;
+  concurrency::ActiveSnapshots snapshots;
+  if (trim_versions == true) {
+    concurrency::EpochManagerFactory::GetInstance().GetActiveSnapshots(
+        snapshots);
+  }
+
   // First iterate the local unlink queue
-  local_unlink_queues_[thread_id].remove_if(
-    [this, &garbages, &tuple_counter, max_cid](const std::shared_ptr<GarbageContext>& garbage_ctx) -> bool {
-      bool res = garbage_ctx->timestamp_ < max_cid;
-      if (res == true) {
-        DeleteFromIndexes(garbage_ctx);
-        // Add to the garbage map
-
-        garbages.push_back(garbage_ctx);
-        tuple_counter++;
+  size_t attempt_count = 0;
+  auto &local_unlink_queue = local_unlink_queues_[thread_id];
+  for (auto garbage_itr = local_unlink_queue.begin();
+       garbage_itr != local_unlink_queue.end() &&
+       attempt_count < max_attempt_count;
+       ++attempt_count) {
+    auto garbage_ctx = *garbage_itr;
+    if (garbage_ctx->timestamp_ < max_cid) {
+      DeleteFromIndexes(garbage_ctx, stale_entries);
+      // Add to the garbage map
+
+      garbages.push_back(garbage_ctx);
+      tuple_counter++;
+      garbage_itr = local_unlink_queue.erase(garbage_itr);
+    } else {
+      if (trim_versions == true && garbage_ctx->trimmed_ == false) {
+        TrimVersionChains(garbage_ctx, snapshots);
       }
-      return res;
+      ++garbage_itr;
     }
-  );
+  }
 
-  for (size_t i = 0; i < MAX_ATTEMPT_COUNT; ++i) {
+  for (size_t i = 0; i < max_attempt_count; ++i) {
 
     std::shared_ptr<GarbageContext> garbage_ctx;
     // if there's no more tuples in the queue, then break.
@@ -124,19 +236,26 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
       // it means that no active transactions can read it.
       // so we can unlink it.
       // we need to delete all the tuples from the indexes to which it belongs as well.
-      DeleteFromIndexes(garbage_ctx);
+      DeleteFromIndexes(garbage_ctx, stale_entries);
       // Add to the garbage map
       garbages.push_back(garbage_ctx);
       tuple_counter++;
 
     } else {
       // if a tuple cannot be reclaimed, then add it back to the list.
+      if (trim_versions == true) {
+        TrimVersionChains(garbage_ctx, snapshots);
+      }
       local_unlink_queues_[thread_id].push_back(garbage_ctx);
     }
   }  // end for
 
+  DeleteStaleIndexEntries(stale_entries);
+
   auto safe_max_cid = concurrency::TransactionManagerFactory::GetInstance().GetNextCommitId();
   for(auto& item : garbages){
+      unlinked_version_count_ += item->version_count_;
+      queued_version_count_ -= item->version_count_;
       reclaim_maps_[thread_id].insert(std::make_pair(safe_max_cid, item));
   }
   LOG_TRACE("Marked %d tuples as garbage", tuple_counter);
@@ -144,19 +263,26 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
 }
 
 // executed by a single thread. so no synchronization is required.
-int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_cid) {
+int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_cid,
+                                       const size_t max_attempt_count) {
   int gc_counter = 0;
 
   // we delete garbage in the free list
   auto garbage_ctx_entry = reclaim_maps_[thread_id].begin();
-  while (garbage_ctx_entry != reclaim_maps_[thread_id].end()) {
+  while (garbage_ctx_entry != reclaim_maps_[thread_id].end() &&
+         (size_t)gc_counter < max_attempt_count) {
     const cid_t garbage_ts = garbage_ctx_entry->first;
     auto garbage_ctx = garbage_ctx_entry->second;
 
     // if the timestamp of the garbage is older than the current max_cid,
     // recycle it
     if (garbage_ts < max_cid) {
-      AddToRecycleMap(garbage_ctx);
+      chain_trim_lock_.Lock();
+      size_t reclaimed_bytes = AddToRecycleMap(garbage_ctx);
+      chain_trim_lock_.Unlock();
+
+      RecordReclaim(garbage_ctx, reclaimed_bytes);
+      queue_depths_[thread_id]--;
 
       // Remove from the original map
       garbage_ctx_entry = reclaim_maps_[thread_id].erase(garbage_ctx_entry);
@@ -171,7 +297,9 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_ci
 }
 
 // Multiple GC thread share the same recycle map
-void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext> garbage_ctx) {
+size_t TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext> garbage_ctx) {
+  size_t reclaimed_bytes = 0;
+
   for (auto &entry : *(garbage_ctx->gc_set_.get())) {
 
     auto &manager = catalog::Manager::GetInstance();
@@ -179,7 +307,7 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
 
     // During the resetting, a table may be deconstructed because of the DROP TABLE request
     if (tile_group == nullptr) {
-      return;
+      return reclaimed_bytes;
     }
 
     PL_ASSERT(tile_group != nullptr);
@@ -190,8 +318,18 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
 
     oid_t table_id = table->GetOid();
 
+    size_t tuple_length = 0;
+    for (auto &tile_schema : tile_group->GetTileSchemas()) {
+      tuple_length += tile_schema.GetLength();
+    }
+
     for (auto &element : entry.second) {
 
+      // the tile group was released by compaction
+      if (element.first >= tile_group->GetAllocatedTupleCount()) {
+        continue;
+      }
+
       // as this transaction has been committed, we should reclaim older versions.
       ItemPointer location(entry.first, element.first); 
       
@@ -199,14 +337,65 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
       if (ResetTuple(location) == false) {
         continue;
       }
+      reclaimed_bytes += tuple_length;
       // if the entry for table_id exists.
-      if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-        recycle_queue_map_[table_id]->Enqueue(location);
+      auto recycle_queue = recycle_queue_map_.find(table_id);
+      if (recycle_queue != recycle_queue_map_.end() &&
+          tile_group->GetHeader()->RecycleTupleSlot(location.offset) == true) {
+        recycle_queue->second->Enqueue(entry.first);
       }
 
     }
+
+    if (compaction_enabled_ == true) {
+      AddCompactionCandidate(tile_group.get());
+    }
   }
 
+  return reclaimed_bytes;
+}
+
+void TransactionLevelGCManager::RecordReclaim(
+    const std::shared_ptr<GarbageContext> &garbage_ctx,
+    const size_t reclaimed_bytes) {
+  unlinked_version_count_ -= garbage_ctx->version_count_;
+  reclaimed_version_count_ += garbage_ctx->version_count_;
+  reclaimed_bytes_ += reclaimed_bytes;
+  reclaimed_ctx_count_++;
+
+  uint64_t latency_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - garbage_ctx->recycle_time_)
+          .count();
+  total_reclaim_latency_us_ += latency_us;
+
+  uint64_t max_latency_us = max_reclaim_latency_us_.load();
+  while (latency_us > max_latency_us &&
+         max_reclaim_latency_us_.compare_exchange_weak(max_latency_us,
+                                                       latency_us) == false) {
+  }
+}
+
+// counters are read one by one, so they may be off by the contexts being
+// moved meanwhile.
+GCMetrics TransactionLevelGCManager::GetMetrics() const {
+  GCMetrics metrics;
+  metrics.queued_version_count_ = queued_version_count_.load();
+  metrics.unlinked_version_count_ = unlinked_version_count_.load();
+  for (auto &queue_depth : queue_depths_) {
+    metrics.queue_depths_.push_back(queue_depth.load());
+  }
+  metrics.reclaimed_version_count_ = reclaimed_version_count_.load();
+  metrics.reclaimed_bytes_ = reclaimed_bytes_.load();
+
+  size_t reclaimed_ctx_count = reclaimed_ctx_count_.load();
+  if (reclaimed_ctx_count != 0) {
+    metrics.average_reclaim_latency_us_ =
+        (double)total_reclaim_latency_us_.load() / reclaimed_ctx_count;
+  }
+  metrics.max_reclaim_latency_us_ = max_reclaim_latency_us_.load();
+  metrics.throttled_txn_count_ = throttled_txn_count_.load();
+  return metrics;
 }
 
 // this function returns a free tuple slot, if one exists
@@ -216,19 +405,166 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
     return INVALID_ITEMPOINTER;
   }
-  ItemPointer location;
   PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
   auto recycle_queue = recycle_queue_map_[table_id];
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto &cache = GetFreeSlotCache();
+  cache.lock_.Lock();
+  cache.last_use_ms_ = GetSteadyClockMs();
+  auto &free_slot_cache = cache.slots_[table_id];
+
+  ItemPointer location = INVALID_ITEMPOINTER;
+  while (location.IsNull() == true) {
+    if (free_slot_cache.empty() == true &&
+        RefillFreeSlotCache(*recycle_queue, free_slot_cache) == false) {
+      break;
+    }
 
-  if (recycle_queue->Dequeue(location) == true) {
-    LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
-              location.offset, table_id);
-    return location;
+    ItemPointer cached_location = free_slot_cache.back();
+    free_slot_cache.pop_back();
+
+    // the tile group may have been dropped or retired since the slot was
+    // cached
+    auto tile_group = manager.GetTileGroup(cached_location.block);
+    if (tile_group != nullptr &&
+        tile_group->GetHeader()->IsRetired() == false) {
+      LOG_TRACE("Reuse tuple(%u, %u) in table %u", cached_location.block,
+                cached_location.offset, table_id);
+      location = cached_location;
+    }
+  }
+
+  cache.lock_.Unlock();
+  return location;
+}
+
+FreeSlotCache &TransactionLevelGCManager::GetFreeSlotCache() {
+  if (local_free_slot_cache == nullptr) {
+    local_free_slot_cache.reset(new FreeSlotCache());
+
+    free_slot_caches_lock_.Lock();
+    free_slot_caches_.push_back(local_free_slot_cache);
+    free_slot_caches_lock_.Unlock();
+  }
+  return *local_free_slot_cache;
+}
+
+// a backend that is using its cache is skipped. an exited backend only
+// shares its cache with the gc, which drops it once it is empty.
+int TransactionLevelGCManager::FlushFreeSlotCaches(const uint64_t idle_ms) {
+  int flushed_count = 0;
+  uint64_t now_ms = GetSteadyClockMs();
+
+  free_slot_caches_lock_.Lock();
+  auto cache_itr = free_slot_caches_.begin();
+  while (cache_itr != free_slot_caches_.end()) {
+    auto &cache = *cache_itr;
+    bool exited = cache.use_count() == 1;
+    if ((exited == true || cache->last_use_ms_ + idle_ms <= now_ms) &&
+        cache->lock_.TryLock() == true) {
+      flushed_count += FlushFreeSlotCache(*cache);
+      cache->lock_.Unlock();
+    }
+
+    if (exited == true) {
+      cache_itr = free_slot_caches_.erase(cache_itr);
+    } else {
+      ++cache_itr;
+    }
+  }
+  free_slot_caches_lock_.Unlock();
+
+  LOG_TRACE("Handed %d cached slots back", flushed_count);
+  return flushed_count;
+}
+
+// the slots go back to the bitmaps of their tile groups, which are put on
+// the queue of their table unless they are on it already
+int TransactionLevelGCManager::FlushFreeSlotCache(
+    FreeSlotCache &free_slot_cache) {
+  auto &manager = catalog::Manager::GetInstance();
+  int flushed_count = 0;
+
+  for (auto &table_slots : free_slot_cache.slots_) {
+    auto recycle_queue = recycle_queue_map_.find(table_slots.first);
+    if (recycle_queue == recycle_queue_map_.end()) {
+      continue;
+    }
+
+    for (auto &location : table_slots.second) {
+      oid_t tile_group_id = location.block;
+      auto tile_group = manager.GetTileGroup(tile_group_id);
+      if (tile_group == nullptr) {
+        continue;
+      }
+
+      if (tile_group->GetHeader()->RecycleTupleSlot(location.offset) ==
+          true) {
+        recycle_queue->second->Enqueue(tile_group_id);
+      }
+      flushed_count++;
+    }
+  }
+
+  free_slot_cache.slots_.clear();
+  return flushed_count;
+}
+
+// takes the lowest recycled slots of the next tile group on the queue.
+// the tile group goes back on the queue if it has slots left, so other
+// backends can use them as well.
+bool TransactionLevelGCManager::RefillFreeSlotCache(
+    LockFreeQueue<oid_t> &recycle_queue,
+    std::vector<ItemPointer> &free_slot_cache) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  oid_t tile_group_id;
+  std::vector<oid_t> tuple_slot_ids;
+  while (recycle_queue.Dequeue(tile_group_id) == true) {
+    auto tile_group = manager.GetTileGroup(tile_group_id);
+    if (tile_group == nullptr || tile_group->GetHeader()->IsRetired() == true) {
+      continue;
+    }
+
+    auto tile_group_header = tile_group->GetHeader();
+    tile_group_header->TakeRecycledTupleSlots(tuple_slot_ids,
+                                              FREE_SLOT_CACHE_SIZE);
+    if (tile_group_header->FinishTakingRecycledTupleSlots() == true) {
+      recycle_queue.Enqueue(tile_group_id);
+    }
+
+    if (tuple_slot_ids.empty() == false) {
+      // the cache is used from the back, lowest offset first
+      for (auto slot_itr = tuple_slot_ids.rbegin();
+           slot_itr != tuple_slot_ids.rend(); ++slot_itr) {
+        free_slot_cache.emplace_back(tile_group_id, *slot_itr);
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void TransactionLevelGCManager::DeregisterTable(const oid_t &table_id) {
+  // Remove dropped tables
+  if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
+    recycle_queue_map_.erase(table_id);
+  }
+
+  // caches of other backends are dropped lazily, since their tile groups
+  // no longer exist
+  if (local_free_slot_cache != nullptr) {
+    local_free_slot_cache->lock_.Lock();
+    local_free_slot_cache->slots_.erase(table_id);
+    local_free_slot_cache->lock_.Unlock();
   }
-  return INVALID_ITEMPOINTER;
 }
 
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
+  gc_locks_[thread_id].Lock();
+
   while(!unlink_queues_[thread_id]->IsEmpty() || !local_unlink_queues_[thread_id].empty()) {
     Unlink(thread_id, MAX_CID);
   }
@@ -237,25 +573,36 @@ void TransactionLevelGCManager::ClearGarbage(int thread_id) {
     Reclaim(thread_id, MAX_CID);
   }
 
+  gc_locks_[thread_id].Unlock();
+
   return;
 }
 
-void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx) {
+void TransactionLevelGCManager::DeleteFromIndexes(
+    const std::shared_ptr<GarbageContext> &garbage_ctx,
+    StaleIndexEntries &stale_entries) {
 
   for (auto entry : *(garbage_ctx->gc_set_.get())) {
+    auto tile_group = catalog::Manager::GetInstance().GetTileGroup(entry.first);
+    if (tile_group == nullptr) {
+      continue;
+    }
+
     for (auto &element : entry.second) {
+      if (element.first >= tile_group->GetAllocatedTupleCount()) {
+        continue;
+      }
+
+      // only old versions are stored in the gc set.
+      // so we can safely get indirection from the indirection array.
+      ItemPointer *indirection =
+          tile_group->GetHeader()->GetIndirection(element.first);
+
       if (element.second == true) {
-        // only old versions are stored in the gc set.
-        // so we can safely get indirection from the indirection array.
-        auto tile_group = catalog::Manager::GetInstance().GetTileGroup(entry.first);
-        if (tile_group != nullptr){
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-
-          DeleteTupleFromIndexes(indirection);
-        }
+        DeleteTupleFromIndexes(indirection, stale_entries);
+      } else {
+        CollectStaleIndexEntries(tile_group.get(), element.first, indirection,
+                                 stale_entries);
       }
     }
   }
@@ -263,7 +610,8 @@ void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageC
 }
 
 // delete a tuple from all its indexes it belongs to.
-void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection) {
+void TransactionLevelGCManager::DeleteTupleFromIndexes(
+    ItemPointer *indirection, StaleIndexEntries &stale_entries) {
   // do nothing if indirection is null
   if (indirection == nullptr){
     return;
@@ -295,11 +643,502 @@ void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection)
       new storage::Tuple(index_schema, true));
     key->SetFromTuple(&expired_tuple, indexed_columns, index->GetPool());
 
-    index->DeleteEntry(key.get(), indirection);
+    stale_entries[index].emplace_back(std::move(key), indirection,
+                                      INVALID_ITEMPOINTER);
+  }
+}
+
+// an update inserts an entry for the new version into every secondary
+// index whose key it changes, while the entry for the old key stays. the
+// entry of a version replaced by an update, or of an aborted version, is
+// stale once no newer version of the chain has the same key. the versions
+// seen by running transactions are all newer than this one, so only the
+// versions between the latest one and this one are compared.
+void TransactionLevelGCManager::CollectStaleIndexEntries(
+    storage::TileGroup *tile_group, const oid_t &tuple_slot_id,
+    ItemPointer *indirection, StaleIndexEntries &stale_entries) {
+  if (indirection == nullptr) {
+    return;
+  }
 
+  storage::DataTable *table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  if (table == nullptr || table->GetIndexCount() == 0) {
+    return;
   }
+
+  bool newest_to_oldest =
+      concurrency::TransactionManagerFactory::GetProtocol() ==
+      ConcurrencyType::TIMESTAMP_ORDERING;
+
+  auto &manager = catalog::Manager::GetInstance();
+
+  // versions are not reset while their chain is visited
+  chain_trim_lock_.Lock();
+
+  ItemPointer latest_version = *indirection;
+
+  // a writer owning the latest version may be inserting an entry with the
+  // same key right now, which would then not be added again. keep the
+  // entries in doubt
+  std::vector<std::pair<std::shared_ptr<storage::TileGroup>, oid_t>>
+      newer_versions;
+  bool complete = false;
+  ItemPointer version = latest_version;
+  for (size_t version_itr = 0; version_itr < MAX_STALE_CHECK_LENGTH;
+       ++version_itr) {
+    if (version.IsNull() == true ||
+        (version.block == tile_group->GetTileGroupId() &&
+         version.offset == tuple_slot_id)) {
+      complete = true;
+      break;
+    }
+
+    auto version_tile_group = manager.GetTileGroup(version.block);
+    if (version_tile_group == nullptr ||
+        version.offset >= version_tile_group->GetAllocatedTupleCount()) {
+      break;
+    }
+
+    auto version_header = version_tile_group->GetHeader();
+    txn_id_t txn_id = version_header->GetTransactionId(version.offset);
+    if (version_itr == 0 && txn_id != INITIAL_TXN_ID) {
+      break;
+    }
+
+    // older versions were reset already
+    if (txn_id == INVALID_TXN_ID) {
+      complete = true;
+      break;
+    }
+
+    newer_versions.emplace_back(version_tile_group, oid_t(version.offset));
+    version = newest_to_oldest
+                  ? version_header->GetNextItemPointer(version.offset)
+                  : version_header->GetPrevItemPointer(version.offset);
+  }
+
+  if (complete == false || newer_versions.empty() == true) {
+    chain_trim_lock_.Unlock();
+    return;
+  }
+
+  expression::ContainerTuple<storage::TileGroup> garbage_tuple(tile_group,
+                                                               tuple_slot_id);
+
+  // the entries of the older versions are gone once those were reset
+  auto tile_group_header = tile_group->GetHeader();
+  ItemPointer older_version =
+      newest_to_oldest ? tile_group_header->GetNextItemPointer(tuple_slot_id)
+                       : tile_group_header->GetPrevItemPointer(tuple_slot_id);
+  bool oldest_version = older_version.IsNull();
+  if (oldest_version == false) {
+    auto older_tile_group = manager.GetTileGroup(older_version.block);
+    oldest_version =
+        older_tile_group != nullptr &&
+        older_tile_group->GetHeader()->GetTransactionId(
+            older_version.offset) == INVALID_TXN_ID;
+  }
+
+  for (size_t idx = 0; idx < table->GetIndexCount(); ++idx) {
+    auto index = table->GetIndex(idx);
+
+    // updates never insert into the primary key index
+    if (index->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
+      continue;
+    }
+
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+
+    auto same_key = [&indexed_columns](
+        const expression::ContainerTuple<storage::TileGroup> &lhs,
+        const expression::ContainerTuple<storage::TileGroup> &rhs) {
+      for (auto column_id : indexed_columns) {
+        if (lhs.GetValue(column_id).CompareEquals(rhs.GetValue(column_id)) !=
+            type::CMP_TRUE) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    expression::ContainerTuple<storage::TileGroup> latest_tuple(
+        newer_versions.front().first.get(), newer_versions.front().second);
+
+    bool key_found = false;
+    // whether all the versions left have the key of the latest one
+    bool last_stale =
+        oldest_version == true && index->GetMetadata()->HasIncludedColumns();
+    for (auto &newer_version : newer_versions) {
+      expression::ContainerTuple<storage::TileGroup> newer_tuple(
+          newer_version.first.get(), newer_version.second);
+
+      if (key_found == false && same_key(garbage_tuple, newer_tuple) == true) {
+        key_found = true;
+      }
+      if (last_stale == true && same_key(latest_tuple, newer_tuple) == false) {
+        last_stale = false;
+      }
+    }
+
+    if (key_found == true) {
+      continue;
+    }
+
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    key->SetFromTuple(&garbage_tuple, indexed_columns, index->GetPool());
+
+    stale_entries[index].emplace_back(std::move(key), indirection,
+                                      latest_version, last_stale);
+  }
+
+  chain_trim_lock_.Unlock();
+}
+
+// deletes the collected entries in one batch per index. an entry of a
+// live version chain is put back if a writer took ownership of the chain
+// since it was found to be stale, as the writer may rely on it.
+int TransactionLevelGCManager::DeleteStaleIndexEntries(
+    StaleIndexEntries &stale_entries) {
+  int delete_count = 0;
+  auto &manager = catalog::Manager::GetInstance();
+
+  for (auto &index_entries : stale_entries) {
+    auto &index = index_entries.first;
+
+    std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entry_list;
+    entry_list.reserve(index_entries.second.size());
+    for (auto &stale_entry : index_entries.second) {
+      entry_list.emplace_back(stale_entry.key_.get(), stale_entry.indirection_);
+    }
+
+    delete_count += index->BulkDeleteEntries(entry_list);
+
+    for (auto &stale_entry : index_entries.second) {
+      ItemPointer latest_version = stale_entry.latest_version_;
+      if (latest_version.IsNull() == true) {
+        // the whole chain is gone
+        index->ClearCoveredUpdate(stale_entry.indirection_);
+        continue;
+      }
+
+      // cleared before the owner is checked: a writer taking ownership
+      // later marks the chain again before inserting its entry
+      if (stale_entry.last_stale_ == true) {
+        index->ClearCoveredUpdate(stale_entry.indirection_);
+      }
+
+      ItemPointer current_version = *(stale_entry.indirection_);
+      auto tile_group = manager.GetTileGroup(current_version.block);
+      if (current_version.block == latest_version.block &&
+          current_version.offset == latest_version.offset &&
+          tile_group != nullptr &&
+          tile_group->GetHeader()->GetTransactionId(current_version.offset) ==
+              INITIAL_TXN_ID) {
+        continue;
+      }
+
+      index->InsertEntry(stale_entry.key_.get(), stale_entry.indirection_);
+      if (stale_entry.last_stale_ == true) {
+        index->MarkCoveredUpdate(stale_entry.indirection_);
+      }
+    }
+  }
+
+  stale_entries.clear();
+
+  LOG_TRACE("Deleted %d stale index entries", delete_count);
+  return delete_count;
+}
+
+//===--------------------------------------------------------------------===//
+// Version chain trimming
+//===--------------------------------------------------------------------===//
+
+// deleted versions are left for regular gc, which unlinks them from the
+// indexes.
+void TransactionLevelGCManager::TrimVersionChains(
+    const std::shared_ptr<GarbageContext> &garbage_ctx,
+    const concurrency::ActiveSnapshots &snapshots) {
+  bool trimmed = true;
+  for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+    for (auto &element : entry.second) {
+      if (element.second == true) {
+        continue;
+      }
+      if (TrimVersion(ItemPointer(entry.first, element.first), snapshots) ==
+          false) {
+        trimmed = false;
+      }
+    }
+  }
+  garbage_ctx->trimmed_ = trimmed;
+}
+
+// links a version replaced by an update out of its newest-to-oldest chain
+// if no snapshot may see it. returns false if it may be trimmed later.
+bool TransactionLevelGCManager::TrimVersion(
+    const ItemPointer &location, const concurrency::ActiveSnapshots &snapshots) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(location.block);
+  if (tile_group == nullptr ||
+      location.offset >= tile_group->GetAllocatedTupleCount()) {
+    return true;
+  }
+
+  // aborted versions are not linked into chains
+  auto tile_group_header = tile_group->GetHeader();
+  cid_t begin_cid = tile_group_header->GetBeginCommitId(location.offset);
+  cid_t end_cid = tile_group_header->GetEndCommitId(location.offset);
+  if (tile_group_header->GetTransactionId(location.offset) != INITIAL_TXN_ID ||
+      begin_cid == MAX_CID || end_cid == MAX_CID) {
+    return true;
+  }
+
+  if (snapshots.MayBeVisible(begin_cid, end_cid) == true) {
+    return false;
+  }
+
+  chain_trim_lock_.Lock();
+
+  ItemPointer newer = tile_group_header->GetPrevItemPointer(location.offset);
+  ItemPointer older = tile_group_header->GetNextItemPointer(location.offset);
+
+  // the newer version links to this one unless it was reset. readers that
+  // already passed it still find the older version through this one
+  auto newer_tile_group =
+      newer.IsNull() ? nullptr : manager.GetTileGroup(newer.block);
+  if (newer_tile_group != nullptr &&
+      newer.offset < newer_tile_group->GetAllocatedTupleCount()) {
+    auto newer_header = newer_tile_group->GetHeader();
+    ItemPointer newer_next = newer_header->GetNextItemPointer(newer.offset);
+
+    if (newer_next.block == location.block &&
+        newer_next.offset == location.offset) {
+      // the older version links back to this one unless it was reset, in
+      // which case the chain ends here
+      auto older_tile_group =
+          older.IsNull() ? nullptr : manager.GetTileGroup(older.block);
+      storage::TileGroupHeader *older_header = nullptr;
+      if (older_tile_group != nullptr &&
+          older.offset < older_tile_group->GetAllocatedTupleCount()) {
+        older_header = older_tile_group->GetHeader();
+        ItemPointer older_prev = older_header->GetPrevItemPointer(older.offset);
+        if (older_prev.block != location.block ||
+            older_prev.offset != location.offset) {
+          older_header = nullptr;
+        }
+      }
+
+      if (older_header != nullptr) {
+        older_header->SetPrevItemPointer(older.offset, newer);
+        COMPILER_MEMORY_FENCE;
+        newer_header->SetNextItemPointer(newer.offset, older);
+      } else {
+        newer_header->SetNextItemPointer(newer.offset, INVALID_ITEMPOINTER);
+      }
+
+      LOG_TRACE("Trimmed version(%u, %u)", location.block, location.offset);
+    }
+  }
+
+  chain_trim_lock_.Unlock();
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Tile group compaction
+//===--------------------------------------------------------------------===//
+
+// called by the gc when it recycles slots of the tile group
+void TransactionLevelGCManager::AddCompactionCandidate(
+    storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+  if (tile_group_header->IsRetired() == true) {
+    return;
+  }
+
+  oid_t slot_count = tile_group->GetAllocatedTupleCount();
+  if (tile_group_header->GetRecycledTupleCount() <
+      slot_count * (1 - compaction_threshold_)) {
+    return;
+  }
+
+  compaction_lock_.Lock();
+  compaction_candidates_.insert(tile_group->GetTileGroupId());
+  compaction_lock_.Unlock();
+}
+
+// a tile group is compacted if it is full, such that it is no longer
+// active, and few of its slots hold versions
+bool TransactionLevelGCManager::IsSparse(storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t slot_count = tile_group->GetAllocatedTupleCount();
+  if (tile_group_header->GetCurrentNextTupleSlot() < slot_count) {
+    return false;
+  }
+
+  oid_t live_count = 0;
+  for (oid_t tuple_slot_id = 0; tuple_slot_id < slot_count; ++tuple_slot_id) {
+    if (tile_group_header->GetTransactionId(tuple_slot_id) != INVALID_TXN_ID) {
+      live_count++;
+    }
+  }
+
+  return live_count <= slot_count * compaction_threshold_;
+}
+
+int TransactionLevelGCManager::CompactTileGroups() {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::unordered_set<oid_t> candidates;
+  compaction_lock_.Lock();
+  candidates.swap(compaction_candidates_);
+  compaction_lock_.Unlock();
+
+  for (auto tile_group_id : candidates) {
+    auto tile_group = manager.GetTileGroup(tile_group_id);
+    if (tile_group == nullptr || tile_group->GetHeader()->IsRetired() == true ||
+        IsSparse(tile_group.get()) == false) {
+      continue;
+    }
+
+    // no slot of the tile group is handed out from now on. backends that
+    // took one before may still fill it until their transactions end
+    tile_group->GetHeader()->Retire();
+    retired_tile_groups_[tile_group_id] = txn_manager.GetNextCommitId();
+    LOG_TRACE("Retired tile group %u", tile_group_id);
+  }
+
+  // read before the slots are checked, see below
+  auto max_cid = txn_manager.GetMaxCommittedCid();
+
+  int released_count = 0;
+  for (auto itr = retired_tile_groups_.begin();
+       itr != retired_tile_groups_.end();) {
+    auto tile_group = manager.GetTileGroup(itr->first);
+
+    // the table has been dropped
+    if (tile_group == nullptr) {
+      itr = retired_tile_groups_.erase(itr);
+      continue;
+    }
+
+    oid_t remaining_count = MoveLiveTuples(tile_group.get());
+
+    // the old versions of moved tuples are reset by the gc once no
+    // transaction can read them. the tile group is released once all slots
+    // are reset and the transactions that ran at its retirement ended
+    if (remaining_count == 0 && max_cid != MAX_CID && itr->second < max_cid) {
+      storage::DataTable *table =
+          dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+      PL_ASSERT(table != nullptr);
+
+      table->ReleaseTileGroup(itr->first);
+      LOG_TRACE("Released tile group %u", itr->first);
+
+      itr = retired_tile_groups_.erase(itr);
+      released_count++;
+    } else {
+      ++itr;
+    }
+  }
+
+  return released_count;
 }
 
+// moves the latest versions out of a retired tile group. returns the number
+// of slots that still hold versions
+oid_t TransactionLevelGCManager::MoveLiveTuples(storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+  oid_t slot_count = tile_group_header->GetCurrentNextTupleSlot();
+
+  oid_t remaining_count = 0;
+  for (oid_t tuple_slot_id = 0; tuple_slot_id < slot_count; ++tuple_slot_id) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot_id);
+    if (tuple_txn_id == INVALID_TXN_ID) {
+      continue;
+    }
+
+    remaining_count++;
+
+    // older versions are left to the gc, and versions owned by running
+    // transactions to the next pass
+    if (tuple_txn_id != INITIAL_TXN_ID ||
+        tile_group_header->GetBeginCommitId(tuple_slot_id) == MAX_CID ||
+        tile_group_header->GetEndCommitId(tuple_slot_id) != MAX_CID) {
+      continue;
+    }
+
+    ItemPointer *indirection = tile_group_header->GetIndirection(tuple_slot_id);
+    if (indirection != nullptr && (indirection->block != tile_group_id ||
+                                   indirection->offset != tuple_slot_id)) {
+      continue;
+    }
+
+    MoveTuple(tile_group, tuple_slot_id);
+  }
+
+  return remaining_count;
+}
+
+// copies a tuple into a new version in another tile group with a
+// transaction of its own, as an update that changes no column
+bool TransactionLevelGCManager::MoveTuple(storage::TileGroup *tile_group,
+                                          const oid_t &tuple_slot_id) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto tile_group_header = tile_group->GetHeader();
+
+  storage::DataTable *table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  PL_ASSERT(table != nullptr);
+
+  ItemPointer old_location(tile_group->GetTileGroupId(), tuple_slot_id);
+
+  auto txn = txn_manager.BeginTransaction();
+
+  if (txn_manager.IsOwnable(txn, tile_group_header, tuple_slot_id) == false ||
+      txn_manager.AcquireOwnership(txn, tile_group_header, tuple_slot_id) ==
+          false) {
+    txn_manager.AbortTransaction(txn);
+    return false;
+  }
+
+  // the slot is neither recycled in a retired tile group nor in the active
+  // tile groups, which are not full
+  ItemPointer new_location = table->AcquireVersion();
+  if (new_location.IsNull() == true) {
+    LOG_TRACE("Could not acquire a version to move tuple(%u, %u) to",
+              old_location.block, old_location.offset);
+    txn_manager.YieldOwnership(txn, old_location.block, tuple_slot_id);
+    txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+    txn_manager.AbortTransaction(txn);
+    return false;
+  }
+  auto new_tile_group = manager.GetTileGroup(new_location.block);
+
+  oid_t column_count = table->GetSchema()->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; ++column_itr) {
+    type::Value value = tile_group->GetValue(tuple_slot_id, column_itr);
+    new_tile_group->SetValue(value, new_location.offset, column_itr);
+  }
+
+  // the indexes point to the indirection of the tuple, which is swung to
+  // the new version. the commit logs the move as an update of all columns
+  // from the old to the new location, such that recovery, which replays
+  // records by location, finds the tuple where the move put it
+  txn_manager.PerformUpdate(txn, old_location, new_location);
+
+  auto result = txn_manager.CommitTransaction(txn);
+
+  LOG_TRACE("Moved tuple(%u, %u) to (%u, %u)", old_location.block,
+            old_location.offset, new_location.block, new_location.offset);
+  return result == ResultType::SUCCESS;
+}
 
 }  // namespace gc
 }  // namespace peloton
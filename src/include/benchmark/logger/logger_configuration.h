@@ -84,12 +84,24 @@ class configuration {
 
   // asynchronous_mode
   AsynchronousType asynchronous_mode;
+
+  // group commit intervals to sweep, in us
+  std::vector<int> sweep_commit_intervals;
+
+  // backend counts to sweep
+  std::vector<int> sweep_backend_counts;
+
+  // csv file with one row per run of the sweep
+  std::string sweep_output_file;
 };
 
 void Usage(FILE *out);
 
 void ParseArguments(int argc, char *argv[], configuration &state);
 
+// whether the workload is run for several settings
+bool IsSweep(const configuration &state);
+
 }  // namespace logger
 }  // namespace benchmark
 }  // namespace peloton
@@ -56,6 +56,15 @@ void DoRecovery();
 
 void BuildLog();
 
+// snapshot the log counters once the database is loaded
+void MarkLoadDone();
+
+//===--------------------------------------------------------------------===//
+// GROUP COMMIT SWEEP
+//===--------------------------------------------------------------------===//
+
+void RunSweep();
+
 }  // namespace logger
 }  // namespace benchmark
 }  // namespace peloton
@@ -85,6 +85,9 @@ class configuration {
   // number of gc threads
   int gc_backend_count;
 
+  // backends collect garbage at commit
+  bool gc_cooperative;
+
   // number of loaders
   int loader_count;
   double projectivity;
@@ -88,6 +88,10 @@ class IndexTuner {
     tile_groups_indexed_per_iteration = tile_groups_indexed_per_iteration_;
   }
 
+  void SetIndexBuildThreadCount(const size_t &index_build_thread_count_) {
+    index_build_thread_count = index_build_thread_count_;
+  }
+
   void SetIndexUtilityThreshold(const double &index_utility_threshold_) {
     index_utility_threshold = index_utility_threshold_;
   }
@@ -160,9 +164,12 @@ class IndexTuner {
   // frequency with which index analysis happens
   oid_t analyze_sample_count_threshold = 1;
 
-  // # of tile groups to be indexed per iteration
+  // # of tile groups to be indexed per iteration (and per build thread)
   oid_t tile_groups_indexed_per_iteration = 10;
 
+  // # of threads building an index (0 = hardware concurrency)
+  size_t index_build_thread_count = 0;
+
   // alpha (weight for old samples)
   double alpha = 0.2;
 
@@ -184,6 +191,10 @@ class IndexTuner {
 
   oid_t tile_groups_indexed_;
 
+  // epoch in which an index was last added. Builds are postponed till all
+  // transactions of that epoch (which may not maintain the index) are done
+  uint64_t index_added_epoch_id_ = 0;
+
   // visibility mode
   bool visibility_mode_ = false;
 };
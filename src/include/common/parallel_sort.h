@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// parallel_sort.h
+//
+// Identification: src/include/common/parallel_sort.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace peloton {
+
+// Inputs smaller than this are sorted by the calling thread
+static const size_t PARALLEL_SORT_MIN_RUN_SIZE = 64 * 1024;
+
+/*
+ * ParallelSort() - Sort a random access range with multiple threads
+ *
+ * The range is cut into one run per thread, each run is sorted by its own
+ * thread and then adjacent runs are merged pairwise (also in parallel) until
+ * a single sorted run remains. If thread_count is 0 the hardware concurrency
+ * is used.
+ */
+template <typename RandomIt, typename Compare>
+void ParallelSort(RandomIt first, RandomIt last, Compare cmp,
+                  size_t thread_count = 0) {
+  size_t item_count = static_cast<size_t>(std::distance(first, last));
+
+  if (thread_count == 0) {
+    thread_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  thread_count =
+      std::min(thread_count, item_count / PARALLEL_SORT_MIN_RUN_SIZE + 1);
+
+  if (thread_count <= 1) {
+    std::sort(first, last, cmp);
+    return;
+  }
+
+  // run_bounds[i] and run_bounds[i + 1] delimit the i-th run
+  std::vector<RandomIt> run_bounds;
+  for (size_t i = 0; i < thread_count; i++) {
+    run_bounds.push_back(first + (item_count * i) / thread_count);
+  }
+  run_bounds.push_back(last);
+
+  std::vector<std::thread> sort_threads;
+  for (size_t i = 0; i < thread_count; i++) {
+    sort_threads.emplace_back([&run_bounds, &cmp, i]() {
+      std::sort(run_bounds[i], run_bounds[i + 1], cmp);
+    });
+  }
+  for (auto &sort_thread : sort_threads) {
+    sort_thread.join();
+  }
+
+  // Merge adjacent runs until only one run remains
+  while (run_bounds.size() > 2) {
+    std::vector<RandomIt> merged_bounds;
+    std::vector<std::thread> merge_threads;
+
+    size_t run_count = run_bounds.size() - 1;
+    for (size_t i = 0; i < run_count; i += 2) {
+      merged_bounds.push_back(run_bounds[i]);
+      if (i + 1 < run_count) {
+        RandomIt run_first = run_bounds[i];
+        RandomIt run_middle = run_bounds[i + 1];
+        RandomIt run_last = run_bounds[i + 2];
+        merge_threads.emplace_back([run_first, run_middle, run_last, &cmp]() {
+          std::inplace_merge(run_first, run_middle, run_last, cmp);
+        });
+      }
+    }
+    merged_bounds.push_back(last);
+
+    for (auto &merge_thread : merge_threads) {
+      merge_thread.join();
+    }
+
+    run_bounds = std::move(merged_bounds);
+  }
+}
+
+}  // End peloton namespace
@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// simd_util.h
+//
+// Identification: src/include/common/simd_util.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <immintrin.h>
+
+namespace peloton {
+
+/*
+ * SimdHasAVX2() - Whether the running CPU supports AVX2
+ *
+ * The build only assumes the x86-64 baseline (SSE2), so AVX2 code paths are
+ * compiled with a target attribute and selected at runtime
+ */
+inline bool SimdHasAVX2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+/*
+ * FindFirstMismatchSSE2() - Returns the offset of the first byte that
+ *                           differs in two buffers, or len if they are equal
+ *
+ * 16 bytes are compared per step; the tail is compared byte by byte
+ */
+inline size_t FindFirstMismatchSSE2(const void *lhs, const void *rhs,
+                                    const size_t len) {
+  const unsigned char *lhs_p = static_cast<const unsigned char *>(lhs);
+  const unsigned char *rhs_p = static_cast<const unsigned char *>(rhs);
+
+  size_t offset = 0;
+  for (; offset + 16 <= len; offset += 16) {
+    __m128i lhs_v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs_p + offset));
+    __m128i rhs_v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs_p + offset));
+
+    // One bit per byte, set if the bytes are equal
+    uint32_t equal_mask =
+        static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs_v, rhs_v)));
+    if (equal_mask != 0xFFFFU) {
+      return offset + __builtin_ctz(~equal_mask);
+    }
+  }
+
+  for (; offset < len; offset++) {
+    if (lhs_p[offset] != rhs_p[offset]) {
+      return offset;
+    }
+  }
+
+  return len;
+}
+
+/*
+ * FindFirstMismatchAVX2() - Same as FindFirstMismatchSSE2() with 32 byte
+ *                           steps. Only call this if SimdHasAVX2() is true
+ */
+__attribute__((target("avx2"))) inline size_t FindFirstMismatchAVX2(
+    const void *lhs, const void *rhs, const size_t len) {
+  const unsigned char *lhs_p = static_cast<const unsigned char *>(lhs);
+  const unsigned char *rhs_p = static_cast<const unsigned char *>(rhs);
+
+  size_t offset = 0;
+  for (; offset + 32 <= len; offset += 32) {
+    __m256i lhs_v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs_p + offset));
+    __m256i rhs_v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs_p + offset));
+
+    uint32_t equal_mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs_v, rhs_v)));
+    if (equal_mask != 0xFFFFFFFFU) {
+      return offset + __builtin_ctz(~equal_mask);
+    }
+  }
+
+  return offset + FindFirstMismatchSSE2(lhs_p + offset, rhs_p + offset,
+                                        len - offset);
+}
+
+// Buffers shorter than this are not worth the indirect AVX2 call
+static const size_t SIMD_AVX2_MIN_LENGTH = 64;
+
+/*
+ * FindFirstMismatch() - Returns the offset of the first byte that differs in
+ *                       two buffers, or len if they are equal
+ */
+inline size_t FindFirstMismatch(const void *lhs, const void *rhs,
+                                const size_t len) {
+  if (len >= SIMD_AVX2_MIN_LENGTH && SimdHasAVX2() == true) {
+    return FindFirstMismatchAVX2(lhs, rhs, len);
+  }
+
+  return FindFirstMismatchSSE2(lhs, rhs, len);
+}
+
+/*
+ * SimdCompareBytes() - Compares two buffers with the semantics of memcmp()
+ */
+inline int SimdCompareBytes(const void *lhs, const void *rhs,
+                            const size_t len) {
+  size_t offset = FindFirstMismatch(lhs, rhs, len);
+  if (offset == len) {
+    return 0;
+  }
+
+  return static_cast<int>(static_cast<const unsigned char *>(lhs)[offset]) -
+         static_cast<int>(static_cast<const unsigned char *>(rhs)[offset]);
+}
+
+}  // End peloton namespace
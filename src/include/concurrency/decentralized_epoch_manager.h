@@ -14,6 +14,7 @@
 #pragma once
 
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "common/macros.h"
@@ -101,6 +102,12 @@ public:
 
   virtual uint64_t GetMaxCommittedEpochId() override;
 
+  virtual uint64_t GetCurrentEpochId() override {
+    return GetCurrentGlobalEpoch();
+  }
+
+  virtual void GetActiveSnapshots(ActiveSnapshots &snapshots) override;
+
 private:
 
   inline uint64_t ExtractEpochId(const cid_t cid) {
@@ -138,7 +145,7 @@ private:
   std::atomic<uint64_t> current_global_epoch_;
   std::atomic<uint32_t> next_txn_id_;
   
-  uint64_t current_global_epoch_ro_;
+  std::atomic<uint64_t> current_global_epoch_ro_;
 
   bool is_running_;
 
@@ -13,7 +13,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "type/types.h"
@@ -21,6 +23,47 @@
 namespace peloton {
 namespace concurrency {
 
+/*
+ * ActiveSnapshots - The snapshots that running transactions hold, and that
+ *                   transactions beginning later may take, at epoch
+ *                   granularity. A snapshot of epoch e is a commit id in
+ *                   [e << 32, (e + 1) << 32)
+ */
+struct ActiveSnapshots {
+  // inclusive epoch ranges of running transactions
+  std::vector<std::pair<uint64_t, uint64_t>> epoch_ranges;
+
+  // transactions beginning later take a snapshot of this epoch or a later one
+  uint64_t next_epoch_id = 0;
+
+  // read-only transactions beginning later take the first snapshot of this
+  // epoch or of a later one
+  uint64_t next_ro_epoch_id = 0;
+
+  // whether a version valid in [begin_cid, end_cid) may be visible to any
+  // of the snapshots
+  bool MayBeVisible(const cid_t &begin_cid, const cid_t &end_cid) const {
+    if (end_cid > (next_epoch_id << 32)) {
+      return true;
+    }
+
+    uint64_t first_ro_epoch_id =
+        std::max((begin_cid + 0xFFFFFFFF) >> 32, next_ro_epoch_id);
+    if ((first_ro_epoch_id << 32) < end_cid) {
+      return true;
+    }
+
+    for (auto &epoch_range : epoch_ranges) {
+      if (end_cid > (epoch_range.first << 32) &&
+          begin_cid < ((epoch_range.second + 1) << 32)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
 class EpochManager {
   EpochManager(const EpochManager&) = delete;
 
@@ -53,6 +96,10 @@ public:
 
   virtual uint64_t GetMaxCommittedEpochId() = 0;
 
+  virtual uint64_t GetCurrentEpochId() = 0;
+
+  virtual void GetActiveSnapshots(ActiveSnapshots &snapshots) = 0;
+
 };
 
 }
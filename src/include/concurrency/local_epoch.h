@@ -13,44 +13,35 @@
 
 #pragma once
 
-#include <thread>
-#include <queue>
-#include <vector>
-#include <unordered_map>
-#include <functional>
+#include <atomic>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "common/platform.h"
 
 namespace peloton {
 namespace concurrency {
 
-struct Epoch {
-  Epoch(const uint64_t epoch_id, const size_t txn_count):
-    epoch_id_(epoch_id),
-    txn_count_(txn_count) {}
-
-  Epoch(const Epoch& epoch) {
-    this->epoch_id_ = epoch.epoch_id_;
-    this->txn_count_ = epoch.txn_count_;
-  }
-
-  uint64_t epoch_id_;
-  size_t txn_count_;
-};
-
-struct EpochCompare {
-  bool operator()(const std::shared_ptr<Epoch> &lhs, const std::shared_ptr<Epoch> &rhs) {
-    return lhs->epoch_id_ > rhs->epoch_id_;
-  }
-};
-
+// number of epochs a thread counts transactions for separately. a
+// transaction that is more than this many epochs younger than the oldest
+// running one of its thread is counted with the oldest one, which only
+// delays gc until the oldest one ends.
+#define EPOCH_RING_SIZE 64
+
+/*
+ * LocalEpoch - The running transactions of a thread, per epoch
+ *
+ * Transactions are counted in a fixed ring of slots indexed by epoch id.
+ * Each slot packs the epoch id in its upper and the transaction count in
+ * its lower 32 bits, such that entering and exiting an epoch is a single
+ * compare-and-swap without allocation or locking. The gc takes the minimum
+ * over the slots to find the epochs that no running transaction belongs to
+ */
 class LocalEpoch {
 
 public:
-  LocalEpoch(const size_t thread_id) : 
-    epoch_lower_bound_(UINT64_MAX), 
-    thread_id_(thread_id) {}
+  LocalEpoch(const size_t thread_id);
 
   bool EnterEpoch(const uint64_t epoch_id);
 
@@ -60,15 +51,47 @@ public:
   
   uint64_t GetMaxCommittedEpochId(const uint64_t current_epoch_id);
 
+  // Appends the inclusive epoch ranges of the running transactions
+  void GetActiveEpochRanges(
+      const uint64_t current_epoch_id,
+      std::vector<std::pair<uint64_t, uint64_t>> &epoch_ranges) const;
+
 private:
-  Spinlock epoch_lock_;
-  
-  uint64_t epoch_lower_bound_;
+  // set in a slot that counts transactions of younger epochs as well
+  static const uint64_t SLOT_SHARED_FLAG = 0x80000000;
+
+  static inline uint64_t PackSlot(const uint64_t epoch_id,
+                                  const uint64_t txn_count) {
+    return (epoch_id << 32) | txn_count;
+  }
+
+  static inline uint64_t GetSlotEpochId(const uint64_t slot) {
+    return slot >> 32;
+  }
+
+  static inline uint64_t GetSlotTxnCount(const uint64_t slot) {
+    return slot & (SLOT_SHARED_FLAG - 1);
+  }
+
+  static inline bool IsSlotShared(const uint64_t slot) {
+    return (slot & SLOT_SHARED_FLAG) != 0;
+  }
+
+  void IncreaseTxnCount(const uint64_t epoch_id);
+
+  void DecreaseTxnCount(const uint64_t epoch_id);
+
+  // returns UINT64_MAX if no transaction is running
+  uint64_t GetMinActiveEpochId() const;
+
+private:
+  // epochs at or below the bound were reported as committed to the gc. a
+  // transaction must not enter them anymore
+  std::atomic<uint64_t> epoch_lower_bound_;
 
   size_t thread_id_;
-  
-  std::priority_queue<std::shared_ptr<Epoch>, std::vector<std::shared_ptr<Epoch>>, EpochCompare> epoch_queue_;
-  std::unordered_map<uint64_t, std::shared_ptr<Epoch>> epoch_map_;
+
+  std::atomic<uint64_t> epoch_slots_[EPOCH_RING_SIZE];
 };
 
 }
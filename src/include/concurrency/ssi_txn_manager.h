@@ -18,10 +18,13 @@
 #include "libcuckoo/cuckoohash_map.hh"
 
 #include <map>
+#include <vector>
 
 namespace peloton {
 namespace concurrency {
 
+struct ReadList;
+
 struct SsiTxnContext {
   SsiTxnContext(Transaction *t)
       : transaction_(t),
@@ -42,6 +45,9 @@ struct SsiTxnContext {
   bool is_abort_;
   bool is_finish_;  // is commit finished
   Spinlock lock_;
+
+  // reader list nodes of this transaction, freed with the context
+  std::vector<ReadList *> readers_;
 };
 
 extern thread_local SsiTxnContext *current_ssi_txn_ctx;
@@ -63,17 +69,10 @@ struct SIReadLock {
 
 class SsiTxnManager: public TransactionManager {
  public:
-  SsiTxnManager() : stopped(false), cleaned(false){
-    gc_cid = 0;
-//    vacuum = std::thread(&SsiTxnManager::CleanUpBg, this);
-  }
+  SsiTxnManager() {}
 
   virtual ~SsiTxnManager() {
     LOG_INFO("Deconstruct SSI manager");
-//    if(!stopped) {
-//      stopped = true;
-//      vacuum.join();
-//    }
   }
 
   static SsiTxnManager &GetInstance();
@@ -171,6 +170,14 @@ class SsiTxnManager: public TransactionManager {
 
   virtual void EndReadonlyTransaction(Transaction *current_txn);
 
+  // Unlinks and frees contexts of finished transactions that no running
+  // transaction overlaps anymore, at most max_count of each. Called at the
+  // end of every transaction; returns 0 if another thread is cleaning up
+  size_t CleanUp(const size_t max_count = CLEANUP_BATCH_SIZE);
+
+  // Contexts of finished transactions that are not freed yet
+  size_t GetRetainedTxnCount();
+
  private:
   std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> next_txn_id_;
@@ -182,17 +189,22 @@ class SsiTxnManager: public TransactionManager {
   // Transaction contexts
   cuckoohash_map<txn_id_t, SsiTxnContext *> txn_table_;
 
-  cuckoohash_map<cid_t, SsiTxnContext *> end_txn_table_;
+  // Contexts of finished transactions, by the epoch they finished in. A
+  // context keeps its reader list nodes until all transactions of that
+  // epoch ended, which includes all transactions that overlapped it. It is
+  // then unlinked from the transaction table and the reader lists, and freed
+  // once the transactions running at that time ended as well, as they may
+  // still hold a pointer to it.
+  Spinlock end_txn_lock_;
+  std::multimap<uint64_t, SsiTxnContext *> end_txn_table_;
+
+  // Unlinked contexts, by the epoch they were unlinked in. Protected by
+  // clean_mutex_
+  std::multimap<uint64_t, SsiTxnContext *> unlinked_txn_table_;
 
-  cid_t gc_cid;
   // SIReadLocks
   typedef std::map<oid_t, std::unique_ptr<SIReadLock>> TupleReadlocks;
   std::map<std::pair<oid_t, oid_t>, std::unique_ptr<SIReadLock>> sireadlocks;
-  // Used to make the vacuum thread stop
-  bool stopped;
-  bool cleaned;
-  // Vacuum thread, GC over 20 ms
-  std::thread vacuum;
 
   // init reserved area of a tuple
   // creator txnid | lock (for read list) | read list head
@@ -239,6 +251,7 @@ class SsiTxnManager: public TransactionManager {
   // Add the current txn into the reader list of a tuple
   void AddSIReader(storage::TileGroup *tile_group, const oid_t &tuple_id) {
     ReadList *reader = new ReadList(current_ssi_txn_ctx);
+    current_ssi_txn_ctx->readers_.push_back(reader);
 
     GetReadLock(tile_group->GetHeader(), tuple_id);
     ReadList **headp = (ReadList **)(
@@ -248,9 +261,10 @@ class SsiTxnManager: public TransactionManager {
     ReleaseReadLock(tile_group->GetHeader(), tuple_id);
   }
 
-  // Remove reader from the reader list of a tuple
+  // Unlink reader from the reader list of a tuple. The list is gone if the
+  // gc reset the tuple meanwhile. The node is freed with its context
   void RemoveSIReader(storage::TileGroupHeader *tile_group_header,
-                      const oid_t &tuple_id, txn_id_t txn_id) {
+                      const oid_t &tuple_id, SsiTxnContext *txn_ctx) {
 //    LOG_DEBUG("Acquire read lock");
     GetReadLock(tile_group_header, tuple_id);
 //    LOG_DEBUG("Acquired");
@@ -262,13 +276,10 @@ class SsiTxnManager: public TransactionManager {
     fake_header.next = *headp;
     auto prev = &fake_header;
     auto next = prev->next;
-    bool find = false;
 
     while (next != nullptr) {
-      if (next->txn_ctx->transaction_->GetTransactionId() == txn_id) {
-        find = true;
+      if (next->txn_ctx == txn_ctx) {
         prev->next = next->next;
-        delete next;
         break;
       }
       prev = next;
@@ -278,9 +289,6 @@ class SsiTxnManager: public TransactionManager {
     *headp = fake_header.next;
 
     ReleaseReadLock(tile_group_header, tuple_id);
-    if (find == false) {
-      assert(false);
-    }
   }
 
   ReadList *GetReaderList(
@@ -308,11 +316,15 @@ class SsiTxnManager: public TransactionManager {
     txn_ctx->out_conflict_ = true;
   }
 
-  void RemoveReader(Transaction *txn);
+  void RemoveReader(SsiTxnContext *txn_ctx);
+
+  // Hand the context of a finished transaction over to CleanUp()
+  void RetireTxnContext(SsiTxnContext *txn_ctx);
+
+  void FreeTxnContext(SsiTxnContext *txn_ctx);
 
-  // Free contexts for SSI manager
-  void CleanUpBg();
-  void CleanUp();
+  // contexts unlinked and freed per call of CleanUp()
+  static const size_t CLEANUP_BATCH_SIZE = 64;
 
   static const int CREATOR_OFFSET = 0;
   static const int LOCK_OFFSET = (CREATOR_OFFSET + sizeof(txn_id_t));
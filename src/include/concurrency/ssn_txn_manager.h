@@ -18,10 +18,13 @@
 #include "libcuckoo/cuckoohash_map.hh"
 
 #include <map>
+#include <vector>
 
 namespace peloton {
 namespace concurrency {
 
+struct ReadnList;
+
 struct SsnTxnContext {
   SsnTxnContext(Transaction *t)
       : transaction_(t),
@@ -61,6 +64,9 @@ struct SsnTxnContext {
   bool is_finish_;  // is commit finished
   bool is_comitting_;
   Spinlock lock_;
+
+  // reader list nodes of this transaction, freed with the context
+  std::vector<ReadnList *> readers_;
 };
 
 extern thread_local SsnTxnContext *current_ssn_txn_ctx;
@@ -163,6 +169,14 @@ class SsnTxnManager: public TransactionManager {
 
   virtual void EndReadonlyTransaction(Transaction *current_txn);
 
+  // Unlinks and frees contexts of finished transactions that no running
+  // transaction overlaps anymore, at most max_count of each. Called at the
+  // end of every transaction; returns 0 if another thread is cleaning up
+  size_t CleanUp(const size_t max_count = CLEANUP_BATCH_SIZE);
+
+  // Contexts of finished transactions that are not freed yet
+  size_t GetRetainedTxnCount();
+
  private:
   std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> next_txn_id_;
@@ -174,7 +188,18 @@ class SsnTxnManager: public TransactionManager {
   // Transaction contexts
   cuckoohash_map<txn_id_t, SsnTxnContext *> txn_table_;
 
-  cuckoohash_map<cid_t, SsnTxnContext *> end_txn_table_;
+  // Contexts of finished transactions, by the epoch they finished in. A
+  // context keeps its reader list nodes and stamps until all transactions
+  // of that epoch ended, which includes all transactions that overlapped
+  // it. It is then unlinked from the transaction table and the reader
+  // lists, and freed once the transactions running at that time ended as
+  // well, as they may still hold a pointer to it.
+  Spinlock end_txn_lock_;
+  std::multimap<uint64_t, SsnTxnContext *> end_txn_table_;
+
+  // Unlinked contexts, by the epoch they were unlinked in. Protected by
+  // clean_mutex_
+  std::multimap<uint64_t, SsnTxnContext *> unlinked_txn_table_;
 
   // init reserved area of a tuple
   // creator txnid | lock (for read list) | read list head
@@ -235,6 +260,7 @@ class SsnTxnManager: public TransactionManager {
   // Add the current txn into the reader list of a tuple
   void AddSsnReader(storage::TileGroup *tile_group, const oid_t &tuple_id) {
     ReadnList *reader = new ReadnList(current_ssn_txn_ctx);
+    current_ssn_txn_ctx->readers_.push_back(reader);
 
     GetReadSsnLock(tile_group->GetHeader(), tuple_id);
     ReadnList **headp = (ReadnList **)(
@@ -244,9 +270,10 @@ class SsnTxnManager: public TransactionManager {
     ReleaseReadSsnLock(tile_group->GetHeader(), tuple_id);
   }
 
-  // Remove reader from the reader list of a tuple
+  // Unlink reader from the reader list of a tuple. The list is gone if the
+  // gc reset the tuple meanwhile. The node is freed with its context
   void RemoveSsnReader(storage::TileGroupHeader *tile_group_header,
-                      const oid_t &tuple_id, txn_id_t txn_id) {
+                      const oid_t &tuple_id, SsnTxnContext *txn_ctx) {
 //    LOG_DEBUG("Acquire read lock");
     GetReadSsnLock(tile_group_header, tuple_id);
 //    LOG_DEBUG("Acquired");
@@ -259,13 +286,10 @@ class SsnTxnManager: public TransactionManager {
     fake_header.next = *headp;
     auto prev = &fake_header;
     auto next = prev->next;
-    bool find = false;
 
     while (next != nullptr) {
-      if (next->txn_ctx->transaction_->GetTransactionId() == txn_id) {
-        find = true;
+      if (next->txn_ctx == txn_ctx) {
         prev->next = next->next;
-        delete next;
         break;
       }
       prev = next;
@@ -275,9 +299,6 @@ class SsnTxnManager: public TransactionManager {
     *headp = fake_header.next;
 
     ReleaseReadSsnLock(tile_group_header, tuple_id);
-    if (find == false) {
-      assert(false);
-    }
   }
 
   ReadnList *GetReaderList(
@@ -311,7 +332,15 @@ class SsnTxnManager: public TransactionManager {
     return txn_ctx->cstamp;
   }
 
-  void RemoveSsnReader(Transaction *txn);
+  void RemoveSsnReader(SsnTxnContext *txn_ctx);
+
+  // Hand the context of a finished transaction over to CleanUp()
+  void RetireTxnContext(SsnTxnContext *txn_ctx);
+
+  void FreeTxnContext(SsnTxnContext *txn_ctx);
+
+  // contexts unlinked and freed per call of CleanUp()
+  static const size_t CLEANUP_BATCH_SIZE = 64;
 
   //cstamp of the tuple
   static const int CREATOR_OFFSET = 0;
@@ -107,6 +107,12 @@ class Transaction : public Printable {
 
   RWType GetRWType(const ItemPointer &);
 
+  // Record the columns an update changed in the version at the location
+  void RecordUpdatedColumns(const ItemPointer &, const TargetList &);
+
+  // Returns nullptr if the changed columns were not recorded
+  const std::vector<oid_t> *GetUpdatedColumns(const ItemPointer &) const;
+
   inline const ReadWriteSet &GetReadWriteSet() { return rw_set_; }
 
   inline std::shared_ptr<GCSet> GetGCSetPtr() {
@@ -154,6 +160,11 @@ class Transaction : public Printable {
 
   ReadWriteSet rw_set_;
 
+  // columns changed by updates, by new version. lets the log manager log
+  // only the changed columns.
+  std::unordered_map<oid_t, std::unordered_map<oid_t, std::vector<oid_t>>>
+      updated_columns_;
+
   // this set contains data location that needs to be gc'd in the transaction.
   std::shared_ptr<GCSet> gc_set_;
 
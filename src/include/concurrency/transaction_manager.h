@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction.h"
@@ -161,18 +162,27 @@ class TransactionManager {
 
   txn_id_t GetNextTransactionId() { return next_txn_id_++; }
 
-  void SetDirtyRange(std::pair<cid_t, cid_t> dirty_range) {
-    this->dirty_range_ = dirty_range;
+  // set by recovery before any transaction runs
+  void SetDirtyRanges(const std::vector<std::pair<cid_t, cid_t>> &dirty_ranges) {
+    this->dirty_ranges_ = dirty_ranges;
+  }
+
+  const std::vector<std::pair<cid_t, cid_t>> &GetDirtyRanges() const {
+    return dirty_ranges_;
   }
 
  protected:
   inline bool CidIsInDirtyRange(cid_t cid) {
-    return ((cid > dirty_range_.first) & (cid <= dirty_range_.second));
+    for (auto &dirty_range : dirty_ranges_) {
+      if ((cid > dirty_range.first) & (cid <= dirty_range.second)) {
+        return true;
+      }
+    }
+    return false;
   }
-  // invisible range after failure and recovery;
+  // invisible ranges after failures and recoveries, one per crash;
   // first value is exclusive, last value is inclusive
-  std::pair<cid_t, cid_t> dirty_range_ =
-      std::make_pair(INVALID_CID, INVALID_CID);
+  std::vector<std::pair<cid_t, cid_t>> dirty_ranges_;
 
  private:
   std::atomic<cid_t> next_cid_;
@@ -39,6 +39,18 @@ DECLARE_string(socket_family);
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
 
+// Standby the log is streamed to
+DECLARE_string(replication_standby_address);
+
+// Replication mode
+DECLARE_string(replication_mode);
+
+// Port of the log stream
+DECLARE_uint64(replication_port);
+
+// Replay the log stream of a primary
+DECLARE_bool(replication_standby);
+
 //===----------------------------------------------------------------------===//
 // ERROR REPORTING AND LOGGING
 //===----------------------------------------------------------------------===//
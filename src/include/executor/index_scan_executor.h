@@ -44,6 +44,9 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   void ResetState();
 
+  // Number of tuples answered from the index keys alone
+  size_t GetIndexOnlyTupleCount() const { return index_only_tuple_count_; }
+
  protected:
   bool DInit();
 
@@ -67,6 +70,11 @@ class IndexScanExecutor : public AbstractScanExecutor {
   // conditions on key columns
   bool CheckKeyConditions(const ItemPointer &tuple_location);
 
+  // Scan an index with included columns and answer the entries whose
+  // version chain passes the visibility hint from the index alone. The
+  // remaining entries are returned in tuple_location_ptrs
+  bool ExecIndexOnlyScan(std::vector<ItemPointer *> &tuple_location_ptrs);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -129,6 +137,14 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   // whether order by is descending
   bool descend_ = false;
+
+  // whether the output columns can be read from the index key
+  bool index_only_ = false;
+
+  // index key column of each output column (if index_only_)
+  std::vector<oid_t> index_only_key_columns_;
+
+  size_t index_only_tuple_count_ = 0;
 };
 
 }  // namespace executor
@@ -27,8 +27,8 @@ namespace executor {
 /**
  * The executor class that populates a newly created index
  *
- * It should have a SeqScanExecutor as a child, for retrieving data
- * to be inputted the index. 
+ * Its child creates the index. The tile groups of the table are then read
+ * directly by the parallel index build of the table.
  */
 class PopulateIndexExecutor : public AbstractExecutor {
  public:
@@ -47,9 +47,6 @@ class PopulateIndexExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
-  /** @brief Input tiles from child node */
-  std::vector<std::unique_ptr<LogicalTile>> child_tiles_;
-
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
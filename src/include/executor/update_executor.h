@@ -19,6 +19,11 @@
 #include "planner/update_plan.h"
 
 namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}
+
 namespace executor {
 
 class UpdateExecutor : public AbstractExecutor {
@@ -39,6 +44,11 @@ class UpdateExecutor : public AbstractExecutor {
 
   bool DExecute();
 
+  // Remember the columns updated in the version at the location, such that
+  // only those are logged at commit
+  void RecordUpdatedColumns(concurrency::Transaction *current_txn,
+                            const ItemPointer &location);
+
  private:
   storage::DataTable *target_table_ = nullptr;
   const planner::ProjectInfo *project_info_ = nullptr;
@@ -36,6 +36,9 @@ class Value;
 
 namespace expression {
 
+class ColumnVector;
+class VectorBatch;
+
 //===----------------------------------------------------------------------===//
 // AbstractExpression
 //
@@ -56,6 +59,19 @@ class AbstractExpression : public Printable {
                                const AbstractTuple *tuple2,
                                executor::ExecutorContext *context) const = 0;
 
+  /**
+   * Evaluate the expression for all the tuples of a batch, which take the
+   * place of tuple1. Returns false if there is no batch kernel for the
+   * expression and its inputs, the caller then evaluates the tuples of the
+   * batch one at a time.
+   */
+  virtual bool EvaluateBatch(
+      UNUSED_ATTRIBUTE VectorBatch &batch,
+      UNUSED_ATTRIBUTE ColumnVector &result,
+      UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
+    return false;
+  }
+
   /**
    * Return true if this expression or any descendent has a value that should be
    * substituted with a parameter.
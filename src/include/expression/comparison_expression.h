@@ -14,6 +14,7 @@
 
 #include "common/sql_node_visitor.h"
 #include "expression/abstract_expression.h"
+#include "expression/vector_batch.h"
 #include "type/value_factory.h"
 
 namespace peloton {
@@ -63,6 +64,17 @@ class ComparisonExpression : public AbstractExpression {
     }
   }
 
+  bool EvaluateBatch(VectorBatch &batch, ColumnVector &result,
+                     executor::ExecutorContext *context) const override {
+    PL_ASSERT(children_.size() == 2);
+    ColumnVector vl, vr;
+    if (children_[0]->EvaluateBatch(batch, vl, context) == false ||
+        children_[1]->EvaluateBatch(batch, vr, context) == false) {
+      return false;
+    }
+    return VectorKernels::Compare(exp_type_, vl, vr, result);
+  }
+
   AbstractExpression *Copy() const override {
     return new ComparisonExpression(*this);
   }
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "expression/abstract_expression.h"
+#include "expression/vector_batch.h"
 #include "common/sql_node_visitor.h"
 
 namespace peloton {
@@ -57,6 +58,17 @@ class ConjunctionExpression : public AbstractExpression {
     }
   }
 
+  bool EvaluateBatch(VectorBatch &batch, ColumnVector &result,
+                     executor::ExecutorContext *context) const override {
+    PL_ASSERT(children_.size() == 2);
+    ColumnVector vl, vr;
+    if (children_[0]->EvaluateBatch(batch, vl, context) == false ||
+        children_[1]->EvaluateBatch(batch, vr, context) == false) {
+      return false;
+    }
+    return VectorKernels::Conjunction(exp_type_, vl, vr, result);
+  }
+
   AbstractExpression *Copy() const override {
     return new ConjunctionExpression(*this);
   }
@@ -14,6 +14,7 @@
 
 #include "common/sql_node_visitor.h"
 #include "expression/abstract_expression.h"
+#include "expression/vector_batch.h"
 #include "util/hash_util.h"
 
 namespace peloton {
@@ -37,6 +38,12 @@ class ConstantValueExpression : public AbstractExpression {
     return value_;
   }
 
+  bool EvaluateBatch(
+      VectorBatch &batch, ColumnVector &result,
+      UNUSED_ATTRIBUTE executor::ExecutorContext *context) const override {
+    return result.Fill(value_, batch.GetSize());
+  }
+
   virtual void DeduceExpressionName() override {
     if (!alias.empty())
       return;
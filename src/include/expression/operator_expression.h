@@ -13,6 +13,7 @@
 #pragma once
 
 #include "expression/abstract_expression.h"
+#include "expression/vector_batch.h"
 #include "common/sql_node_visitor.h"
 #include "type/value_factory.h"
 
@@ -68,6 +69,25 @@ class OperatorExpression : public AbstractExpression {
     }
   }
 
+  bool EvaluateBatch(VectorBatch &batch, ColumnVector &result,
+                     executor::ExecutorContext *context) const override {
+    if (exp_type_ == ExpressionType::OPERATOR_NOT) {
+      PL_ASSERT(children_.size() == 1);
+      ColumnVector vl;
+      if (children_[0]->EvaluateBatch(batch, vl, context) == false) {
+        return false;
+      }
+      return VectorKernels::Not(vl, result);
+    }
+    PL_ASSERT(children_.size() == 2);
+    ColumnVector vl, vr;
+    if (children_[0]->EvaluateBatch(batch, vl, context) == false ||
+        children_[1]->EvaluateBatch(batch, vr, context) == false) {
+      return false;
+    }
+    return VectorKernels::Arithmetic(exp_type_, vl, vr, result);
+  }
+
   void DeduceExpressionType() {
     // if we are a decimal or int we should take the highest type id of both
     // children
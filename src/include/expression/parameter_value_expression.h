@@ -13,6 +13,7 @@
 #pragma once
 
 #include "expression/abstract_expression.h"
+#include "expression/vector_batch.h"
 #include "executor/executor_context.h"
 #include "common/sql_node_visitor.h"
 
@@ -38,6 +39,11 @@ class ParameterValueExpression : public AbstractExpression {
     return context->GetParams().at(value_idx_);
   }
 
+  bool EvaluateBatch(VectorBatch &batch, ColumnVector &result,
+                     executor::ExecutorContext *context) const override {
+    return result.Fill(context->GetParams().at(value_idx_), batch.GetSize());
+  }
+
   AbstractExpression *Copy() const override {
     return new ParameterValueExpression(value_idx_);
   }
@@ -51,6 +51,10 @@ class TupleValueExpression : public AbstractExpression {
       const AbstractTuple *tuple1, const AbstractTuple *tuple2,
       executor::ExecutorContext *context) const override;
 
+  virtual bool EvaluateBatch(
+      VectorBatch &batch, ColumnVector &result,
+      executor::ExecutorContext *context) const override;
+
   virtual void DeduceExpressionName() override {
     if (!alias.empty())
       return;
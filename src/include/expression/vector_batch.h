@@ -0,0 +1,204 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vector_batch.h
+//
+// Identification: src/include/expression/vector_batch.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+// number of tuples the executors evaluate expressions on at a time
+#define DEFAULT_VECTOR_SIZE 1024
+
+namespace peloton {
+
+namespace executor {
+class ExecutorContext;
+class LogicalTile;
+}
+
+namespace storage {
+class TileGroup;
+}
+
+namespace expression {
+
+class AbstractExpression;
+
+//===--------------------------------------------------------------------===//
+// Column Vector
+//===--------------------------------------------------------------------===//
+
+/*
+ * ColumnVector - The values of a column or of an expression for the tuples
+ * of a batch
+ *
+ * Booleans and integers of every width are kept as int64_t, decimals as
+ * double, with a null flag per value. The other types have no vector
+ * representation, expressions on them are evaluated tuple-at-a-time.
+ */
+class ColumnVector {
+ public:
+  ColumnVector() : type_id_(type::Type::INVALID) {}
+
+  static bool IsVectorType(type::Type::TypeId type_id);
+
+  // resize the vector for the values of a batch, they are left undefined
+  void Reset(type::Type::TypeId type_id, size_t size);
+
+  // set all the values to the value, returns false if its type has no vector
+  // representation
+  bool Fill(const type::Value &value, size_t size);
+
+  // read the value of a row from the storage format of the vector type
+  void Load(size_t row, const char *location);
+
+  // write the value of a row in the storage format of the vector type
+  void Store(size_t row, char *location) const;
+
+  type::Value GetValue(size_t row) const;
+
+  inline type::Type::TypeId GetTypeId() const { return type_id_; }
+
+  inline size_t GetSize() const { return nulls_.size(); }
+
+  inline bool IsDecimal() const { return type_id_ == type::Type::DECIMAL; }
+
+  inline bool IsNull(size_t row) const { return nulls_[row] != 0; }
+
+  inline bool IsTrue(size_t row) const {
+    return nulls_[row] == 0 && integers_[row] == 1;
+  }
+
+  inline bool IsFalse(size_t row) const {
+    return nulls_[row] == 0 && integers_[row] == 0;
+  }
+
+  inline int64_t GetInteger(size_t row) const { return integers_[row]; }
+
+  inline double GetDecimal(size_t row) const {
+    return IsDecimal() ? decimals_[row] : (double)integers_[row];
+  }
+
+  inline void SetNull(size_t row) { nulls_[row] = 1; }
+
+  inline void SetInteger(size_t row, int64_t value) {
+    integers_[row] = value;
+    nulls_[row] = 0;
+  }
+
+  inline void SetDecimal(size_t row, double value) {
+    decimals_[row] = value;
+    nulls_[row] = 0;
+  }
+
+ private:
+  type::Type::TypeId type_id_;
+
+  // booleans and integers
+  std::vector<int64_t> integers_;
+
+  // decimals
+  std::vector<double> decimals_;
+
+  std::vector<uint8_t> nulls_;
+};
+
+//===--------------------------------------------------------------------===//
+// Vector Batch
+//===--------------------------------------------------------------------===//
+
+/*
+ * VectorBatch - Up to DEFAULT_VECTOR_SIZE tuples of a tile group or a logical
+ * tile, whose expressions are evaluated together
+ *
+ * The tuple ids are the selection vector of the batch, the tuple slots of a
+ * tile group or the visible tuples of a logical tile. The columns are read
+ * from the tiles into column vectors once an expression needs them.
+ */
+class VectorBatch {
+ public:
+  VectorBatch(const VectorBatch &) = delete;
+  VectorBatch &operator=(const VectorBatch &) = delete;
+
+  VectorBatch(storage::TileGroup *tile_group, std::vector<oid_t> &&tuple_ids);
+
+  VectorBatch(executor::LogicalTile *logical_tile,
+              std::vector<oid_t> &&tuple_ids);
+
+  inline size_t GetSize() const { return tuple_ids_.size(); }
+
+  inline const std::vector<oid_t> &GetTupleIds() const { return tuple_ids_; }
+
+  // the values of the column, nullptr if its type has no vector
+  // representation
+  const ColumnVector *GetColumn(oid_t column_id);
+
+  // evaluate a predicate for the tuples of the batch, tuple-at-a-time if it
+  // has no batch kernel for them
+  void EvaluatePredicate(const AbstractExpression *predicate,
+                         ColumnVector &result,
+                         executor::ExecutorContext *context);
+
+ private:
+  // return false if the column type has no vector representation
+  bool LoadTileGroupColumn(oid_t column_id, ColumnVector &column);
+
+  bool LoadLogicalTileColumn(oid_t column_id, ColumnVector &column);
+
+  // one of them is set
+  storage::TileGroup *tile_group_ = nullptr;
+
+  executor::LogicalTile *logical_tile_ = nullptr;
+
+  std::vector<oid_t> tuple_ids_;
+
+  // the columns read so far, nullptr for the ones that can not be read
+  std::unordered_map<oid_t, std::unique_ptr<ColumnVector>> columns_;
+};
+
+//===--------------------------------------------------------------------===//
+// Vector Kernels
+//===--------------------------------------------------------------------===//
+
+/*
+ * VectorKernels - Typed loops behind the batch evaluation of expressions
+ *
+ * They return false if they have no loop for the types of their inputs, or
+ * if a value needs the error handling of the tuple-at-a-time evaluation,
+ * like an overflow or a division by zero. The batch is then evaluated
+ * tuple-at-a-time, which raises the same exception as before.
+ */
+class VectorKernels {
+ public:
+  // COMPARE_* on numeric vectors
+  static bool Compare(ExpressionType type, const ColumnVector &left,
+                      const ColumnVector &right, ColumnVector &result);
+
+  // OPERATOR_PLUS, OPERATOR_MINUS, OPERATOR_MULTIPLY and OPERATOR_DIVIDE on
+  // numeric vectors
+  static bool Arithmetic(ExpressionType type, const ColumnVector &left,
+                         const ColumnVector &right, ColumnVector &result);
+
+  // CONJUNCTION_AND and CONJUNCTION_OR on boolean vectors
+  static bool Conjunction(ExpressionType type, const ColumnVector &left,
+                          const ColumnVector &right, ColumnVector &result);
+
+  // OPERATOR_NOT on a boolean vector
+  static bool Not(const ColumnVector &child, ColumnVector &result);
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -33,12 +33,17 @@ class GCManagerFactory {
     }
   }
 
-  static void Configure(const int thread_count = 1) { 
+  // If cooperative is true, backends collect garbage at commit and the gc
+  // threads only act as a fallback
+  static void Configure(const int thread_count = 1,
+                        const bool cooperative = false) {
     if (thread_count == 0) {
       gc_type_ = GarbageCollectionType::OFF;
     } else {
       gc_type_ = GarbageCollectionType::ON;
       gc_thread_count_ = thread_count;
+      TransactionLevelGCManager::GetInstance(gc_thread_count_)
+          .SetCooperativeMode(cooperative);
     }
   }
 
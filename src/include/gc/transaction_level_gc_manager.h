@@ -12,8 +12,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <vector>
 #include <list>
@@ -21,35 +24,153 @@
 #include "type/types.h"
 #include "common/logger.h"
 #include "common/init.h"
+#include "common/platform.h"
 #include "common/thread_pool.h"
 #include "gc/gc_manager.h"
+#include "concurrency/epoch_manager.h"
+#include "storage/tuple.h"
 
 #include "container/lock_free_queue.h"
 
 namespace peloton {
+
+namespace index {
+class Index;
+}
+
 namespace gc {
 
 #define MAX_QUEUE_LENGTH 100000
 #define MAX_ATTEMPT_COUNT 100000
 
+// garbage contexts a backend handles per commit in cooperative mode
+#define COOPERATIVE_ATTEMPT_COUNT 64
+
+// recycled slots a backend takes from a tile group at a time
+#define FREE_SLOT_CACHE_SIZE 32
+
+// how long the recycled slots a backend took may stay unused before gc
+// thread 0 hands them back to their tables
+#define FREE_SLOT_CACHE_IDLE_MS 100
+
+// how often gc thread 0 compacts sparse tile groups
+#define COMPACTION_INTERVAL_MS 1000
+
+// default fraction of live tuples below which a tile group is compacted
+#define DEFAULT_COMPACTION_THRESHOLD 0.1
+
+// versions the gc compares an expired version with to tell whether its
+// index entries are still needed. entries of longer chains are kept
+#define MAX_STALE_CHECK_LENGTH 64
+
+// default number of versions waiting for the gc above which committing
+// writers are delayed, if throttling is enabled
+#define DEFAULT_THROTTLE_THRESHOLD 1000000
+
+// delay of a writer at the threshold, growing with the backlog up to the
+// maximum
+#define THROTTLE_DELAY_US 10
+#define MAX_THROTTLE_DELAY_US 10000
+
 
 struct GarbageContext {
-  GarbageContext() : timestamp_(INVALID_CID) {}
+  GarbageContext()
+      : timestamp_(INVALID_CID), trimmed_(false), version_count_(0) {}
   GarbageContext(std::shared_ptr<GCSet> gc_set, 
                  const cid_t &timestamp) {
     gc_set_ = gc_set;
     timestamp_ = timestamp;
+    trimmed_ = false;
+    version_count_ = 0;
+    for (auto &entry : *gc_set_) {
+      version_count_ += entry.second.size();
+    }
+    recycle_time_ = std::chrono::steady_clock::now();
   }
 
   std::shared_ptr<GCSet> gc_set_;
   cid_t timestamp_;
+
+  // whether the versions were linked out of their version chains
+  bool trimmed_;
+
+  size_t version_count_;
+
+  // when the transaction handed its versions to the gc
+  std::chrono::steady_clock::time_point recycle_time_;
 };
 
+// a snapshot of the gc's backlog and progress
+struct GCMetrics {
+  // versions handed to the gc that are not unlinked yet
+  size_t queued_version_count_ = 0;
+
+  // versions unlinked from the indexes whose slots are not reclaimed yet
+  size_t unlinked_version_count_ = 0;
+
+  // garbage contexts each gc thread has not reclaimed yet
+  std::vector<size_t> queue_depths_;
+
+  size_t reclaimed_version_count_ = 0;
+
+  // inlined tuple storage reclaimed. varlen values are not accounted
+  size_t reclaimed_bytes_ = 0;
+
+  // time from commit to reclamation
+  double average_reclaim_latency_us_ = 0.0;
+  uint64_t max_reclaim_latency_us_ = 0;
+
+  // commits delayed by the writer throttle
+  size_t throttled_txn_count_ = 0;
+};
+
+// an index entry that no live version needs anymore
+struct StaleIndexEntry {
+  StaleIndexEntry(std::unique_ptr<storage::Tuple> key,
+                  ItemPointer *indirection, const ItemPointer &latest_version,
+                  bool last_stale = false)
+      : key_(std::move(key)),
+        indirection_(indirection),
+        latest_version_(latest_version),
+        last_stale_(last_stale) {}
+
+  std::unique_ptr<storage::Tuple> key_;
+  ItemPointer *indirection_;
+
+  // the latest version of the chain when the entry was found to be stale,
+  // or INVALID_ITEMPOINTER if the whole chain was deleted
+  ItemPointer latest_version_;
+
+  // whether the chain has no other stale entry in the index, such that the
+  // index no longer needs to report it as updated
+  bool last_stale_;
+};
+
+// recycled slots taken by a backend, per table. Backends take a few slots
+// of one tile group at a time, such that inserts neither contend on the
+// table's queue nor scatter over many tile groups
+struct FreeSlotCache {
+  // held by the backend while it takes a slot, and by the gc while it hands
+  // the slots of an idle backend back
+  Spinlock lock_;
+
+  std::unordered_map<oid_t, std::vector<ItemPointer>> slots_;
+
+  // when the backend last took a slot, in ms of the steady clock
+  std::atomic<uint64_t> last_use_ms_{0};
+};
+
+// stale entries collected over an unlink pass, per index
+typedef std::unordered_map<std::shared_ptr<index::Index>,
+                           std::vector<StaleIndexEntry>> StaleIndexEntries;
+
 class TransactionLevelGCManager : public GCManager {
 public:
   TransactionLevelGCManager(int thread_count) 
     : gc_thread_count_(thread_count),
-      reclaim_maps_(thread_count) {
+      reclaim_maps_(thread_count),
+      gc_locks_(thread_count),
+      queue_depths_(thread_count) {
 
     unlink_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
@@ -93,22 +214,75 @@ public:
 
   virtual void RecycleTransaction(std::shared_ptr<GCSet> gc_set, const cid_t &timestamp) override;
 
+  // In cooperative mode the backend committing a transaction also unlinks
+  // and reclaims expired versions queued for the same gc thread, and gc
+  // threads only pick up what backends leave behind
+  void SetCooperativeMode(const bool cooperative) {
+    cooperative_mode_ = cooperative;
+  }
+
+  bool IsCooperativeMode() const { return cooperative_mode_; }
+
+  // With compaction enabled, gc thread 0 moves the live tuples out of full
+  // tile groups whose fraction of live tuples dropped to the threshold, and
+  // releases the tile groups once their old versions are reclaimed
+  void SetCompaction(const bool enabled,
+                     const double threshold = DEFAULT_COMPACTION_THRESHOLD) {
+    compaction_threshold_ = threshold;
+    compaction_enabled_ = enabled;
+  }
+
+  bool IsCompactionEnabled() const { return compaction_enabled_; }
+
+  // With version trimming enabled, versions that are newer than the oldest
+  // snapshot but visible to no running transaction are linked out of their
+  // version chains, such that a long-running transaction does not let
+  // chains grow without bound. Their slots are still reset once they are
+  // older than all snapshots, as readers may be traversing them.
+  // Only the timestamp ordering protocol keeps newest-to-oldest chains
+  // this relies on
+  void SetVersionTrimming(const bool enabled) { version_trimming_ = enabled; }
+
+  bool IsVersionTrimmingEnabled() const { return version_trimming_; }
+
+  // With the writer throttle enabled, a transaction handing versions to
+  // the gc while more than threshold versions are waiting to be reclaimed
+  // is delayed at commit, in proportion to the backlog, such that the gc
+  // catches up with bursts of updates
+  void SetWriterThrottle(const bool enabled,
+                         const size_t threshold = DEFAULT_THROTTLE_THRESHOLD) {
+    throttle_threshold_ = threshold;
+    writer_throttle_ = enabled;
+  }
+
+  bool IsWriterThrottleEnabled() const { return writer_throttle_; }
+
+  // Versions waiting to be unlinked or reclaimed
+  size_t GetBacklogVersionCount() const {
+    return queued_version_count_.load() + unlinked_version_count_.load();
+  }
+
+  GCMetrics GetMetrics() const;
+
+  // Runs one compaction pass and returns the number of released tile
+  // groups. Called by gc thread 0, must not run concurrently
+  int CompactTileGroups();
+
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  // Hands the recycled slots of backends that took none for idle_ms, or
+  // that exited, back to their tables. Returns the number of slots
+  int FlushFreeSlotCaches(const uint64_t idle_ms = FREE_SLOT_CACHE_IDLE_MS);
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
     if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
-      std::shared_ptr<LockFreeQueue<ItemPointer>> recycle_queue(new LockFreeQueue<ItemPointer>(MAX_QUEUE_LENGTH));
+      std::shared_ptr<LockFreeQueue<oid_t>> recycle_queue(new LockFreeQueue<oid_t>(MAX_QUEUE_LENGTH));
       recycle_queue_map_[table_id] = recycle_queue;
     }
   }
 
-  virtual void DeregisterTable(const oid_t &table_id) override {
-    // Remove dropped tables
-    if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-      recycle_queue_map_.erase(table_id);
-    }
-  }
+  virtual void DeregisterTable(const oid_t &table_id) override;
 
   virtual size_t GetTableCount() override {
     return recycle_queue_map_.size();
@@ -124,17 +298,59 @@ private:
 
   void Running(const int &thread_id);
 
-  int Unlink(const int &thread_id, const cid_t &max_cid);
+  int Unlink(const int &thread_id, const cid_t &max_cid,
+             const size_t max_attempt_count = MAX_ATTEMPT_COUNT);
+
+  int Reclaim(const int &thread_id, const cid_t &max_cid,
+              const size_t max_attempt_count = MAX_ATTEMPT_COUNT);
+
+  int CooperativeCollect(const int &thread_id);
 
-  int Reclaim(const int &thread_id, const cid_t &max_cid);
+  // returns the number of bytes reclaimed
+  size_t AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
 
-  void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
+  void RecordReclaim(const std::shared_ptr<GarbageContext> &garbage_ctx,
+                     const size_t reclaimed_bytes);
+
+  void ThrottleWriter();
 
   bool ResetTuple(const ItemPointer &);
 
-  void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
+  bool RefillFreeSlotCache(LockFreeQueue<oid_t> &recycle_queue,
+                           std::vector<ItemPointer> &free_slot_cache);
+
+  // the cache of the calling backend, registered on first use
+  FreeSlotCache &GetFreeSlotCache();
+
+  // called with the lock of the cache held
+  int FlushFreeSlotCache(FreeSlotCache &free_slot_cache);
+
+  void DeleteFromIndexes(const std::shared_ptr<GarbageContext> &garbage_ctx,
+                         StaleIndexEntries &stale_entries);
+
+  void DeleteTupleFromIndexes(ItemPointer *indirection,
+                              StaleIndexEntries &stale_entries);
+
+  void CollectStaleIndexEntries(storage::TileGroup *tile_group,
+                                const oid_t &tuple_slot_id,
+                                ItemPointer *indirection,
+                                StaleIndexEntries &stale_entries);
+
+  int DeleteStaleIndexEntries(StaleIndexEntries &stale_entries);
+
+  void TrimVersionChains(const std::shared_ptr<GarbageContext> &garbage_ctx,
+                         const concurrency::ActiveSnapshots &snapshots);
+
+  bool TrimVersion(const ItemPointer &location,
+                   const concurrency::ActiveSnapshots &snapshots);
 
-  void DeleteTupleFromIndexes(ItemPointer *indirection);
+  void AddCompactionCandidate(storage::TileGroup *tile_group);
+
+  bool IsSparse(storage::TileGroup *tile_group);
+
+  oid_t MoveLiveTuples(storage::TileGroup *tile_group);
+
+  bool MoveTuple(storage::TileGroup *tile_group, const oid_t &tuple_slot_id);
 
 private:
   //===--------------------------------------------------------------------===//
@@ -157,9 +373,63 @@ private:
   // # reclaim_maps == # gc_threads
   std::vector<std::multimap<cid_t, std::shared_ptr<GarbageContext>>> reclaim_maps_;
 
-  // queues for to-be-reused tuples.
+  // queues of tile groups that have recycled tuple slots. the slots
+  // themselves are tracked by a bitmap in each tile group header, and a
+  // tile group is on its queue at most once.
   // # recycle_queue_maps == # tables
-  std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>> recycle_queue_map_;
+  std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<oid_t>>> recycle_queue_map_;
+
+  // the recycled slot caches of all backends, including exited ones whose
+  // slots were not handed back yet
+  Spinlock free_slot_caches_lock_;
+  std::vector<std::shared_ptr<FreeSlotCache>> free_slot_caches_;
+
+  // locks protecting the local unlink queue and the reclaim map of each gc
+  // thread, which backends also work on in cooperative mode.
+  // # gc_locks == # gc_threads
+  std::vector<Spinlock> gc_locks_;
+
+  // whether backends collect garbage at commit
+  volatile bool cooperative_mode_ = false;
+
+  volatile bool version_trimming_ = false;
+
+  // serializes linking versions out of chains with resetting slots, such
+  // that a trimmed version's neighbors are not reused meanwhile
+  Spinlock chain_trim_lock_;
+
+  volatile bool compaction_enabled_ = false;
+
+  double compaction_threshold_ = DEFAULT_COMPACTION_THRESHOLD;
+
+  // tile groups that turned sparse since the last compaction pass
+  Spinlock compaction_lock_;
+  std::unordered_set<oid_t> compaction_candidates_;
+
+  // tile groups being compacted, with the commit id at their retirement.
+  // only accessed by the compaction pass
+  std::unordered_map<oid_t, cid_t> retired_tile_groups_;
+
+  volatile bool writer_throttle_ = false;
+
+  size_t throttle_threshold_ = DEFAULT_THROTTLE_THRESHOLD;
+
+  //===--------------------------------------------------------------------===//
+  // Metrics
+  //===--------------------------------------------------------------------===//
+
+  // garbage contexts not reclaimed yet.
+  // # queue_depths == # gc_threads
+  std::vector<std::atomic<size_t>> queue_depths_;
+
+  std::atomic<size_t> queued_version_count_{0};
+  std::atomic<size_t> unlinked_version_count_{0};
+  std::atomic<size_t> reclaimed_version_count_{0};
+  std::atomic<size_t> reclaimed_bytes_{0};
+  std::atomic<size_t> reclaimed_ctx_count_{0};
+  std::atomic<uint64_t> total_reclaim_latency_us_{0};
+  std::atomic<uint64_t> max_reclaim_latency_us_{0};
+  std::atomic<size_t> throttled_txn_count_{0};
 
 };
 }
@@ -7338,6 +7338,216 @@ before_switch:
     return ret;
   }
 
+  /*
+   * IsEmptyLayout() - Returns true if the tree still has its initial layout
+   *
+   * The initial layout is a root inner node with a single separator that
+   * points to the first leaf, which is a base node without any item and
+   * without a delta chain on top of it
+   */
+  bool IsEmptyLayout() {
+    const BaseNode *root_node_p = GetNode(root_id.load());
+    if((root_node_p == nullptr) || \
+       (root_node_p->GetType() != NodeType::InnerType) || \
+       (root_node_p->GetItemCount() != 1)) {
+      return false;
+    }
+
+    const BaseNode *leaf_node_p = GetNode(first_leaf_id);
+    if((leaf_node_p == nullptr) || \
+       (leaf_node_p->GetType() != NodeType::LeafType) || \
+       (leaf_node_p->GetItemCount() != 0)) {
+      return false;
+    }
+
+    return true;
+  }
+
+  /*
+   * BulkLoad() - Build the tree bottom-up from sorted key-value pairs
+   *
+   * Items must be sorted by key, and duplicated key-value pairs must be
+   * adjacent to each other. Leaf nodes are filled up to the split
+   * threshold (items sharing the same key never straddle two leaves, which
+   * is the same invariant GetSplitSibling() maintains), then each inner level
+   * is built from the low keys of the level below until a single root
+   * remains. Duplicated key-value pairs are skipped, as Insert() would do.
+   *
+   * This function only works on an empty tree (see IsEmptyLayout()) and
+   * returns false otherwise. It must be called in a single threaded
+   * environment since the old root and leaf are freed directly rather
+   * than through the epoch manager.
+   */
+  bool BulkLoad(const std::vector<KeyValuePair> &item_list) {
+    if(item_list.size() == 0UL) {
+      return true;
+    }
+
+    if(IsEmptyLayout() == false) {
+      return false;
+    }
+
+    // Frees the initial root and its only leaf and invalidates both NodeIDs
+    // We reuse first_leaf_id for the left most leaf since the iterator
+    // always starts at FIRST_LEAF_NODE_ID
+    FreeNodeByNodeID(root_id.load());
+
+    // This is the current level being built: one low key pair per node
+    // (first element) together with the node pointer (second element)
+    std::vector<std::pair<KeyNodeIDPair, const BaseNode *>> level_list{};
+
+    // Item range [start, end) of each leaf node on the leaf level
+    std::vector<std::pair<size_t, size_t>> leaf_range_list{};
+
+    size_t start_index = 0;
+    while(start_index < item_list.size()) {
+      size_t end_index = \
+        std::min(start_index + LEAF_NODE_SIZE_UPPER_THRESHOLD,
+                 item_list.size());
+
+      // Do not separate the same key on two leaf nodes
+      while((end_index < item_list.size()) && \
+            (KeyCmpEqual(item_list[end_index - 1].first,
+                         item_list[end_index].first) == true)) {
+        end_index++;
+      }
+
+      leaf_range_list.push_back(std::make_pair(start_index, end_index));
+      start_index = end_index;
+    }
+
+    // NodeIDs are assigned before nodes are built since the high key of
+    // a node carries the NodeID of its right sibling
+    std::vector<NodeID> node_id_list{};
+    for(size_t i = 0;i < leaf_range_list.size();i++) {
+      node_id_list.push_back((i == 0) ? first_leaf_id : GetNextNodeID());
+    }
+
+    for(size_t i = 0;i < leaf_range_list.size();i++) {
+      size_t leaf_start = leaf_range_list[i].first;
+      size_t leaf_end = leaf_range_list[i].second;
+
+      // Left most leaf has -Inf as low key; otherwise it is the first key
+      KeyNodeIDPair low_key_pair = \
+        (i == 0) ? std::make_pair(KeyType(), INVALID_NODE_ID) : \
+                   std::make_pair(item_list[leaf_start].first,
+                                  ~INVALID_NODE_ID);
+
+      // Right most leaf has +Inf as high key which is identified by
+      // INVALID_NODE_ID
+      KeyNodeIDPair high_key_pair = \
+        (i == leaf_range_list.size() - 1) ? \
+          std::make_pair(KeyType(), INVALID_NODE_ID) : \
+          std::make_pair(item_list[leaf_range_list[i + 1].first].first,
+                         node_id_list[i + 1]);
+
+      // Skip duplicated key-value pairs (they are adjacent in the input)
+      auto is_duplicate = [this, &item_list, leaf_start](size_t j) {
+        return (j > leaf_start) && \
+               (KeyCmpEqual(item_list[j - 1].first,
+                            item_list[j].first) == true) && \
+               (ValueCmpEqual(item_list[j - 1].second,
+                              item_list[j].second) == true);
+      };
+
+      int item_count = 0;
+      for(size_t j = leaf_start;j < leaf_end;j++) {
+        if(is_duplicate(j) == false) {
+          item_count++;
+        }
+      }
+
+      LeafNode *leaf_node_p = \
+        reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::\
+          Get(item_count,
+              NodeType::LeafType,
+              0,
+              item_count,
+              low_key_pair,
+              high_key_pair));
+
+      for(size_t j = leaf_start;j < leaf_end;j++) {
+        if(is_duplicate(j) == false) {
+          leaf_node_p->PushBack(item_list[j]);
+        }
+      }
+
+      InstallNewNode(node_id_list[i], leaf_node_p);
+
+      level_list.push_back(
+        std::make_pair(std::make_pair(item_list[leaf_start].first,
+                                      node_id_list[i]),
+                       leaf_node_p));
+    }
+
+    // Build inner levels until there is only one node which becomes the
+    // root. Even for a single leaf we need an inner node as root
+    bool is_leaf_level = true;
+    while((level_list.size() > 1) || (is_leaf_level == true)) {
+      is_leaf_level = false;
+
+      size_t node_count = \
+        (level_list.size() + INNER_NODE_SIZE_UPPER_THRESHOLD - 1) / \
+        INNER_NODE_SIZE_UPPER_THRESHOLD;
+
+      std::vector<NodeID> inner_id_list{};
+      for(size_t i = 0;i < node_count;i++) {
+        // When there is only one node on this level it becomes the new root
+        // and reuses the root NodeID
+        inner_id_list.push_back((node_count == 1) ? root_id.load() : \
+                                                    GetNextNodeID());
+      }
+
+      std::vector<std::pair<KeyNodeIDPair, const BaseNode *>> \
+        upper_level_list{};
+
+      for(size_t i = 0;i < node_count;i++) {
+        size_t sep_start = i * INNER_NODE_SIZE_UPPER_THRESHOLD;
+        size_t sep_end = \
+          std::min(sep_start + INNER_NODE_SIZE_UPPER_THRESHOLD,
+                   level_list.size());
+        int sep_count = static_cast<int>(sep_end - sep_start);
+
+        // The first separator of the left most node on each level has -Inf
+        // as its key, which is never looked at by the search procedure
+        KeyNodeIDPair low_key_pair = \
+          (i == 0) ? std::make_pair(KeyType(), level_list[0].first.second) : \
+                     level_list[sep_start].first;
+
+        KeyNodeIDPair high_key_pair = \
+          (i == node_count - 1) ? \
+            std::make_pair(KeyType(), INVALID_NODE_ID) : \
+            std::make_pair(level_list[sep_end].first.first,
+                           inner_id_list[i + 1]);
+
+        InnerNode *inner_node_p = \
+          reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::\
+            Get(sep_count,
+                NodeType::InnerType,
+                0,
+                sep_count,
+                low_key_pair,
+                high_key_pair));
+
+        inner_node_p->PushBack(low_key_pair);
+        for(size_t j = sep_start + 1;j < sep_end;j++) {
+          inner_node_p->PushBack(level_list[j].first);
+        }
+
+        InstallNewNode(inner_id_list[i], inner_node_p);
+
+        upper_level_list.push_back(
+          std::make_pair(std::make_pair(level_list[sep_start].first.first,
+                                        inner_id_list[i]),
+                         inner_node_p));
+      }
+
+      level_list = std::move(upper_level_list);
+    }
+
+    return true;
+  }
+
   /*
    * Insert() - Insert a key-value pair
    *
@@ -75,6 +75,15 @@ class BWTreeIndex : public Index {
                        ItemPointer *value,
                        std::function<bool(const void *)> predicate);
 
+  bool BulkInsertEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entry_list,
+      const bool concurrent = false);
+
+  size_t BulkDeleteEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entry_list);
+
   void Scan(const std::vector<type::Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -102,6 +111,15 @@ class BWTreeIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result);
 
+  bool ScanWithKeys(const std::vector<type::Value> &value_list,
+                    const std::vector<oid_t> &tuple_column_id_list,
+                    const std::vector<ExpressionType> &expr_list,
+                    ScanDirectionType scan_direction,
+                    std::vector<ValueType> &result,
+                    std::vector<std::unique_ptr<storage::Tuple>> &key_result,
+                    const ConjunctionScanPredicate *csp_p,
+                    type::AbstractPool *key_pool, uint64_t limit = 0);
+
   std::string GetTypeName() const;
 
   // TODO: Implement this
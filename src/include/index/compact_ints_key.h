@@ -14,6 +14,7 @@
 
 #include <sstream>
 
+#include "common/simd_util.h"
 #include "util/string_util.h"
 
 namespace peloton {
@@ -295,11 +296,25 @@ class CompactIntsKey {
    *
    * This function has the same semantics as memcmp(). Negative result means
    * less than, positive result means greater than, and 0 means equal
+   *
+   * Since the key is stored in big endian, comparing 8 byte words in host
+   * byte order gives the same order as comparing bytes. Longer keys locate
+   * the first differing byte with vector compares
    */
   static inline int Compare(const CompactIntsKey<KeySize> &a,
                             const CompactIntsKey<KeySize> &b) {
-    return memcmp(a.key_data, b.key_data,
-                  CompactIntsKey<KeySize>::key_size_byte);
+    if (KeySize == 1) {
+      uint64_t a_word, b_word;
+      memcpy(&a_word, a.key_data, sizeof(uint64_t));
+      memcpy(&b_word, b.key_data, sizeof(uint64_t));
+
+      a_word = EightBytesToHostEndian(a_word);
+      b_word = EightBytesToHostEndian(b_word);
+      return (a_word > b_word) - (a_word < b_word);
+    }
+
+    return SimdCompareBytes(a.key_data, b.key_data,
+                            CompactIntsKey<KeySize>::key_size_byte);
   }
 
   /*
@@ -315,7 +330,9 @@ class CompactIntsKey {
    */
   static inline bool Equals(const CompactIntsKey<KeySize> &a,
                             const CompactIntsKey<KeySize> &b) {
-    return Compare(a, b) == 0;
+    return FindFirstMismatch(a.key_data, b.key_data,
+                             CompactIntsKey<KeySize>::key_size_byte) ==
+           CompactIntsKey<KeySize>::key_size_byte;
   }
 
  public:
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include "common/simd_util.h"
 #include "type/type_util.h"
 
 namespace peloton {
@@ -68,10 +69,23 @@ class GenericComparator {
                          const GenericKey<KeySize> &rhs) const {
     auto schema = lhs.schema;
 
-    type::Value lhs_value;
-    type::Value rhs_value;
+    // Columns that lie entirely in the byte-identical prefix of both keys
+    // compare equal, so the typed comparison starts from the column holding
+    // the first differing byte
+    size_t key_length = schema->GetLength();
+    size_t mismatch = FindFirstMismatch(lhs.data, rhs.data, key_length);
+    if (mismatch == key_length) {
+      return false;
+    }
 
-    for (oid_t col_itr = 0; col_itr < schema->GetColumnCount(); col_itr++) {
+    oid_t column_count = schema->GetColumnCount();
+    oid_t start_col = 0;
+    while (start_col + 1 < column_count &&
+           schema->GetOffset(start_col + 1) <= mismatch) {
+      start_col++;
+    }
+
+    for (oid_t col_itr = start_col; col_itr < column_count; col_itr++) {
       const type::Value lhs_value = (lhs.ToValue(schema, col_itr));
       const type::Value rhs_value = (rhs.ToValue(schema, col_itr));
 
@@ -162,6 +176,12 @@ class GenericEqualityChecker {
                          const GenericKey<KeySize> &rhs) const {
     auto schema = lhs.schema;
 
+    // Byte-identical keys are always equal
+    if (FindFirstMismatch(lhs.data, rhs.data, schema->GetLength()) ==
+        schema->GetLength()) {
+      return true;
+    }
+
     storage::Tuple lhTuple(schema);
     lhTuple.MoveToTuple(reinterpret_cast<const void *>(&lhs));
     storage::Tuple rhTuple(schema);
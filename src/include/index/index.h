@@ -38,6 +38,9 @@ namespace storage {
 class Tuple;
 }
 
+template <typename KeyType, typename ValueType>
+class CuckooMap;
+
 namespace index {
 
 class ConjunctionScanPredicate;
@@ -63,7 +66,9 @@ class IndexMetadata : public Printable {
                 IndexConstraintType index_constraint_type,
                 const catalog::Schema *tuple_schema,
                 const catalog::Schema *key_schema,
-                const std::vector<oid_t> &key_attrs, bool unique_keys);
+                const std::vector<oid_t> &key_attrs, bool unique_keys,
+                const std::vector<oid_t> &included_attrs =
+                    std::vector<oid_t>());
 
   ~IndexMetadata();
 
@@ -113,6 +118,21 @@ class IndexMetadata : public Printable {
    */
   inline const std::vector<oid_t> &GetKeyAttrs() const { return key_attrs; }
 
+  /*
+   * GetIncludedAttrs() - Returns the base table columns that are stored in
+   *                      the index after the key columns
+   *
+   * Included columns are only carried along to answer queries from the
+   * index alone; the key schema holds the key columns followed by them
+   */
+  inline const std::vector<oid_t> &GetIncludedAttrs() const {
+    return included_attrs;
+  }
+
+  inline bool HasIncludedColumns() const {
+    return included_attrs.empty() == false;
+  }
+
   /*
    * GetTupleToIndexMapping() - Returns the mapping relation between tuple key
    *                            column and index key columns
@@ -121,6 +141,34 @@ class IndexMetadata : public Printable {
     return tuple_attrs;
   }
 
+  /*
+   * SetPartitioning() - Spreads the index over several physical indexes
+   *
+   * HASH partitioning routes a key by the hash of its key columns into one
+   * of partition_count indexes. RANGE partitioning routes a key by its
+   * leading column: partition i holds the values below range_bounds[i] and
+   * the last partition the values from the last bound on, so there are
+   * range_bounds.size() + 1 partitions and partition_count is ignored.
+   *
+   * This must be called before the index is created by IndexFactory
+   */
+  void SetPartitioning(IndexPartitionType partition_type,
+                       size_t partition_count,
+                       const std::vector<type::Value> &range_bounds =
+                           std::vector<type::Value>());
+
+  inline IndexPartitionType GetPartitionType() const {
+    return partition_type_;
+  }
+
+  inline size_t GetPartitionCount() const { return partition_count_; }
+
+  inline const std::vector<type::Value> &GetPartitionRangeBounds() const {
+    return partition_range_bounds_;
+  }
+
+  inline bool IsPartitioned() const { return partition_count_ > 1; }
+
   inline double GetUtility() const { return utility_ratio; }
 
   inline void SetUtility(double p_utility_ratio) {
@@ -171,6 +219,9 @@ class IndexMetadata : public Printable {
   // The mapping relation between key schema and tuple schema
   std::vector<oid_t> key_attrs;
 
+  // Non-key columns stored after key_attrs in the key schema
+  std::vector<oid_t> included_attrs;
+
   // The mapping relation between tuple schema and key schema
   // i.e. if the column in tuple is not indexed, then it is set to INVALID_OID
   //      if the column in tuple is indexed, then it is the index in index_key
@@ -181,6 +232,11 @@ class IndexMetadata : public Printable {
   // Whether keys are unique (e.g. primary key)
   bool unique_keys;
 
+  // How the index is spread over physical indexes (see SetPartitioning())
+  IndexPartitionType partition_type_ = IndexPartitionType::INVALID;
+  size_t partition_count_ = 1;
+  std::vector<type::Value> partition_range_bounds_;
+
   // utility of an index
   double utility_ratio = INVALID_RATIO;
 
@@ -250,6 +306,28 @@ class Index : public Printable {
   virtual bool CondInsertEntry(const storage::Tuple *key, ItemPointer *location,
                                std::function<bool(const void *)> predicate) = 0;
 
+  // Insert a batch of key-location pairs, e.g. when loading a table or
+  // building an index on an existing table. The default implementation
+  // inserts entries one by one; index types supporting bottom-up
+  // construction override it. Returns false if the index has unique keys
+  // and the batch contains duplicated keys.
+  //
+  // If concurrent is true the index may be shared with other writers (and
+  // other batches being inserted in parallel), so entries that are already
+  // present with the same location are skipped instead of reported.
+  virtual bool BulkInsertEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entry_list,
+      const bool concurrent = false);
+
+  // Delete a batch of key-location pairs, e.g. the stale entries collected
+  // by the gc. The default implementation deletes entries one by one; index
+  // types that benefit from visiting keys in order override it. Returns the
+  // number of entries that were found and deleted
+  virtual size_t BulkDeleteEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entry_list);
+
   ///////////////////////////////////////////////////////////////////
   // Index Scan
   ///////////////////////////////////////////////////////////////////
@@ -289,6 +367,47 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  // Same as Scan(), but also returns a copy of the key of each entry in
+  // key_result (allocated from the given pool), such that included columns
+  // can be read without visiting the table. At most limit entries are
+  // returned unless limit is 0. Returns false if the index type does not
+  // support it
+  virtual bool ScanWithKeys(
+      UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+      UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+      UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+      UNUSED_ATTRIBUTE ScanDirectionType scan_direction,
+      UNUSED_ATTRIBUTE std::vector<ItemPointer *> &result,
+      UNUSED_ATTRIBUTE std::vector<std::unique_ptr<storage::Tuple>>
+          &key_result,
+      UNUSED_ATTRIBUTE const ConjunctionScanPredicate *csp_p,
+      UNUSED_ATTRIBUTE type::AbstractPool *key_pool,
+      UNUSED_ATTRIBUTE uint64_t limit = 0) {
+    return false;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Included columns
+  ///////////////////////////////////////////////////////////////////
+
+  // Record that an update changed the key or included columns of the
+  // version chain, i.e. that the chain may have several entries in this
+  // index and entries no longer tell the values of the visible version.
+  // Must be called before the entry for the new version is inserted
+  void MarkCoveredUpdate(ItemPointer *indirection);
+
+  // Visibility hint for index-only reads: false if the entries pointing
+  // to the version chain are known to hold the values of its latest version
+  bool HasCoveredUpdate(ItemPointer *indirection) const;
+
+  // Forget the updates of the version chain once the gc has removed all
+  // its entries but the ones holding the key of its latest version, or
+  // the whole chain
+  void ClearCoveredUpdate(ItemPointer *indirection);
+
+  // Number of version chains currently reported as updated
+  size_t GetCoveredUpdateCount() const;
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection
   ///////////////////////////////////////////////////////////////////
@@ -405,6 +524,10 @@ class Index : public Printable {
   // pool
   type::AbstractPool *pool = nullptr;
 
+  // version chains whose key or included columns were updated
+  // (only allocated if the index has included columns)
+  CuckooMap<ItemPointer *, bool> *covered_updates = nullptr;
+
   // This is used by index tuner
   std::atomic<size_t> indexed_tile_group_offset;
 };
@@ -0,0 +1,150 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partitioned_index.h
+//
+// Identification: src/include/index/partitioned_index.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "index/index.h"
+
+namespace peloton {
+namespace index {
+
+/*
+ * class PartitionedIndex - A logical index spread over several physical
+ *                          indexes of the same type
+ *
+ * Monotonically increasing keys make all inserts into a single tree land on
+ * its rightmost leaf. Routing keys by hash (or by ranges of the leading
+ * column, e.g. the warehouse id of TPC-C keys) into separate trees spreads
+ * them over as many insertion points as there are partitions.
+ *
+ * Operations on a single key go to the partition of the key. Scans visit
+ * every partition that may hold qualifying keys: range partitions are
+ * visited in key order, hash partitions are scanned together with their
+ * keys and merged, such that results come back in key order as from a
+ * single tree (except ScanAllKeys() on hash partitions)
+ */
+class PartitionedIndex : public Index {
+  friend class IndexFactory;
+
+ public:
+  PartitionedIndex(IndexMetadata *metadata);
+
+  ~PartitionedIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate);
+
+  bool BulkInsertEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entry_list,
+      const bool concurrent = false);
+
+  size_t BulkDeleteEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entry_list);
+
+  void Scan(const std::vector<type::Value> &value_list,
+            const std::vector<oid_t> &tuple_column_id_list,
+            const std::vector<ExpressionType> &expr_list,
+            ScanDirectionType scan_direction,
+            std::vector<ItemPointer *> &result,
+            const ConjunctionScanPredicate *csp_p);
+
+  void ScanLimit(const std::vector<type::Value> &value_list,
+                 const std::vector<oid_t> &tuple_column_id_list,
+                 const std::vector<ExpressionType> &expr_list,
+                 ScanDirectionType scan_direction,
+                 std::vector<ItemPointer *> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                 uint64_t offset);
+
+  void ScanLimitRange(const std::vector<type::Value> &value_list,
+                      const std::vector<oid_t> &tuple_column_id_list,
+                      const std::vector<ExpressionType> &expr_list,
+                      ScanDirectionType scan_direction,
+                      std::vector<ItemPointer *> &result,
+                      const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                      uint64_t offset);
+
+  void ScanAllKeys(std::vector<ItemPointer *> &result);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ItemPointer *> &result);
+
+  bool ScanWithKeys(const std::vector<type::Value> &value_list,
+                    const std::vector<oid_t> &tuple_column_id_list,
+                    const std::vector<ExpressionType> &expr_list,
+                    ScanDirectionType scan_direction,
+                    std::vector<ItemPointer *> &result,
+                    std::vector<std::unique_ptr<storage::Tuple>> &key_result,
+                    const ConjunctionScanPredicate *csp_p,
+                    type::AbstractPool *key_pool, uint64_t limit = 0);
+
+  std::string GetTypeName() const;
+
+  size_t GetMemoryFootprint();
+
+  bool NeedGC();
+
+  void PerformGC();
+
+  size_t GetPartitionCount() const { return partitions.size(); }
+
+  Index *GetPartition(size_t partition_id) const {
+    return partitions[partition_id].get();
+  }
+
+  // Returns the partition a key is routed to
+  size_t GetKeyPartition(const storage::Tuple *key) const;
+
+ private:
+  // Returns the range partition holding the given leading column value
+  size_t GetRangePartition(const type::Value &value) const;
+
+  // Returns the first and last partition that may hold keys of the scan
+  void GetScanPartitions(const ConjunctionScanPredicate *csp_p,
+                         size_t &first_partition,
+                         size_t &last_partition) const;
+
+  // Scans hash partitions with their keys and merges them in key order,
+  // keeping at most limit entries unless limit is 0
+  bool MergeScanWithKeys(
+      const std::vector<type::Value> &value_list,
+      const std::vector<oid_t> &tuple_column_id_list,
+      const std::vector<ExpressionType> &expr_list,
+      ScanDirectionType scan_direction, std::vector<ItemPointer *> &result,
+      std::vector<std::unique_ptr<storage::Tuple>> &key_result,
+      const ConjunctionScanPredicate *csp_p, type::AbstractPool *key_pool,
+      uint64_t limit);
+
+  bool MergeScan(const std::vector<type::Value> &value_list,
+                 const std::vector<oid_t> &tuple_column_id_list,
+                 const std::vector<ExpressionType> &expr_list,
+                 ScanDirectionType scan_direction,
+                 std::vector<ItemPointer *> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit);
+
+  IndexPartitionType partition_type;
+
+  // Physical indexes; each one owns a copy of the metadata
+  std::vector<std::unique_ptr<Index>> partitions;
+};
+
+}  // End index namespace
+}  // End peloton namespace
@@ -55,6 +55,9 @@ class BackendLogger : public Logger {
                                     ItemPointer delete_location,
                                     const void *data = nullptr) = 0;
 
+  // The type of the tuple records of this logger for the given operation
+  virtual LogRecordType GetTupleRecordType(LogRecordType log_record_type) = 0;
+
   void SetLoggingCidLowerBound(cid_t cid) {
     // XXX bad synchronization practice
     log_buffer_lock.Lock();
@@ -94,6 +97,13 @@ class BackendLogger : public Logger {
   // gets the Varlenpool used for log serialization
   type::AbstractPool *GetVarlenPool() { return backend_pool.get(); }
 
+  // only called by the worker thread owning this logger
+  void RecordCommitLatency(uint64_t latency_us) {
+    commit_latencies_.push_back(latency_us);
+  }
+
+  std::vector<uint64_t> &GetCommitLatencies() { return commit_latencies_; }
+
  protected:
   // the lock for the buffer being used currently
   Spinlock log_buffer_lock;
@@ -113,12 +123,12 @@ class BackendLogger : public Logger {
   // max cid for the current log buffer
   cid_t max_log_id_buffer = 0;
 
-  // temporary serialization buffer
-  CopySerializeOutput output_buffer;
-
   // the current buffer
   std::unique_ptr<LogBuffer> log_buffer_;
 
+  // whether a full buffer was handed off since the last collection
+  bool handed_off_ = false;
+
   // the pool of available buffers
   std::unique_ptr<BufferPool> available_buffer_pool_;
 
@@ -130,6 +140,9 @@ class BackendLogger : public Logger {
 
   // shutdown flag
   bool shutdown = false;
+
+  // commit latencies of the worker in microseconds, if tracked
+  std::vector<uint64_t> commit_latencies_;
 };
 
 }  // namespace logging
@@ -66,6 +66,9 @@ class Checkpoint {
 
   void InitDirectory();
 
+  // find the version of the most recent checkpoint file
+  void InitVersionNumber();
+
   // whether file access is disabled. mainly used for testing
   bool disable_file_access = false;
 
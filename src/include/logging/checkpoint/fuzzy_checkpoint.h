@@ -0,0 +1,152 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fuzzy_checkpoint.h
+//
+// Identification: src/include/logging/checkpoint/fuzzy_checkpoint.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "logging/checkpoint.h"
+
+// default number of threads scanning tile groups for a checkpoint
+#define DEFAULT_CHECKPOINT_SCANNER_COUNT 4
+
+namespace peloton {
+
+class CopySerializeInput;
+class CopySerializeOutput;
+
+namespace storage {
+class TileGroup;
+}
+
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Fuzzy Checkpoint
+//===--------------------------------------------------------------------===//
+
+/*
+ * FuzzyCheckpoint - Checkpoint of an MVCC snapshot
+ *
+ * The versions visible at the snapshot cid are scanned by several threads,
+ * one tile group at a time, while transactions keep running. A read-only
+ * epoch is held during the scan, so the gc does not reclaim the versions of
+ * the snapshot. The snapshot is the commit id of the epoch, and it is only
+ * taken once the log is durable up to it.
+ *
+ * The checkpoint file is a sequence of frames. Each frame starts with its
+ * length and type. A tile group frame holds the slots of the visible
+ * tuples followed by their values column by column. The end frame is only
+ * written once all tile groups were persisted, a checkpoint without it is
+ * ignored on recovery.
+ */
+class FuzzyCheckpoint : public Checkpoint {
+ public:
+  FuzzyCheckpoint(const FuzzyCheckpoint &) = delete;
+  FuzzyCheckpoint &operator=(const FuzzyCheckpoint &) = delete;
+  FuzzyCheckpoint(FuzzyCheckpoint &&) = delete;
+  FuzzyCheckpoint &operator=(FuzzyCheckpoint &&) = delete;
+  FuzzyCheckpoint(bool disable_file_access);
+  ~FuzzyCheckpoint();
+
+  // Inherited functions
+  void DoCheckpoint();
+
+  cid_t DoRecovery();
+
+  // Checkpoint the snapshot at the given cid
+  void TakeCheckpoint(cid_t snapshot_cid);
+
+  // Getters and Setters
+  inline void SetScannerCount(size_t scanner_count) {
+    scanner_count_ = std::max<size_t>(scanner_count, 1);
+  }
+
+  inline size_t GetScannerCount() const { return scanner_count_; }
+
+  // number of tuples written by the last checkpoint
+  inline size_t GetCheckpointedTupleCount() const {
+    return checkpointed_tuple_count_;
+  }
+
+ protected:
+  enum FrameType : char {
+    FRAME_TYPE_BEGIN = 1,
+    FRAME_TYPE_TILE_GROUP = 2,
+    FRAME_TYPE_END = 3,
+    FRAME_TYPE_TILE_IMAGE = 4
+  };
+
+  // a tile group to be scanned
+  struct ScanTask {
+    oid_t database_oid;
+    storage::DataTable *table;
+    oid_t tile_group_offset;
+  };
+
+  void ScanTileGroups(const std::vector<ScanTask> &scan_tasks,
+                      std::atomic<size_t> &next_task_itr);
+
+  // serialize the visible tuples of a tile group, returns the tuple count
+  virtual size_t SerializeTileGroup(const ScanTask &scan_task,
+                                    CopySerializeOutput &output);
+
+  // the slots of the tuples of a tile group visible at the snapshot
+  std::vector<oid_t> GetVisibleTupleSlots(storage::TileGroup *tile_group);
+
+  void RecoverTileGroup(CopySerializeInput &input);
+
+  // hand the recovered tile groups and commit id to the managers
+  cid_t FinishRecovery(cid_t commit_id);
+
+  void WriteFrame(CopySerializeOutput &output);
+
+  // the whole frame starting at the current position, empty if torn
+  std::vector<char> ReadFrame();
+
+  bool HasEndFrame();
+
+  void CreateFile();
+
+  void Cleanup();
+
+  cid_t WaitForDurableCommitId(cid_t commit_id);
+
+  FileHandle file_handle_ = INVALID_FILE_HANDLE;
+
+  // every frame starts at a multiple of it in the checkpoint file
+  size_t frame_alignment_ = 1;
+
+  // protects appends to the checkpoint file
+  std::mutex file_mutex_;
+
+  size_t scanner_count_ = DEFAULT_CHECKPOINT_SCANNER_COUNT;
+
+  // commit id of current checkpoint
+  cid_t snapshot_cid_ = 0;
+
+  std::atomic<size_t> checkpointed_tuple_count_;
+
+  // local epoch of the epoch manager the checkpoint is registered under
+  size_t epoch_thread_id_;
+
+  // Keep tracking max oid for setting next_oid in manager
+  // For active processing after recovery
+  oid_t max_oid_ = 0;
+};
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// image_checkpoint.h
+//
+// Identification: src/include/logging/checkpoint/image_checkpoint.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <memory>
+
+#include "logging/checkpoint/fuzzy_checkpoint.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Image Checkpoint
+//===--------------------------------------------------------------------===//
+
+/*
+ * ImageCheckpoint - Fuzzy checkpoint that keeps the layout of the tiles
+ *
+ * A tile image frame holds the inlined data of every tile of a tile group
+ * as it is laid out in memory, each starting at a page boundary. Recovery
+ * maps the checkpoint file privately and lets the tiles of a recovered tile
+ * group use the mapped pages directly, so restart does not copy the
+ * inlined data. Only the uninlined values are written separately and
+ * relocated into the pools of the tiles.
+ *
+ * A tile group whose layout differs from the one its table recovers with
+ * is rebuilt value by value instead.
+ */
+class ImageCheckpoint : public FuzzyCheckpoint {
+ public:
+  ImageCheckpoint(const ImageCheckpoint &) = delete;
+  ImageCheckpoint &operator=(const ImageCheckpoint &) = delete;
+  ImageCheckpoint(ImageCheckpoint &&) = delete;
+  ImageCheckpoint &operator=(ImageCheckpoint &&) = delete;
+  ImageCheckpoint(bool disable_file_access);
+  ~ImageCheckpoint();
+
+  cid_t DoRecovery();
+
+  // number of tile groups that adopted mapped data in the last recovery
+  inline size_t GetMappedTileGroupCount() const {
+    return mapped_tile_group_count_;
+  }
+
+ protected:
+  size_t SerializeTileGroup(const ScanTask &scan_task,
+                            CopySerializeOutput &output);
+
+ private:
+  void RecoverTileImage(CopySerializeInput &input, char *frame,
+                        const std::shared_ptr<void> &mapped_region);
+
+  size_t mapped_tile_group_count_ = 0;
+};
+
+}  // namespace logging
+}  // namespace peloton
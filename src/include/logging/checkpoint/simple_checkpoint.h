@@ -63,8 +63,6 @@ class SimpleCheckpoint : public Checkpoint {
 
   void Cleanup();
 
-  void InitVersionNumber();
-
   std::vector<std::shared_ptr<LogRecord>> records_;
 
   FileHandle file_handle_ = INVALID_FILE_HANDLE;
@@ -40,6 +40,12 @@ namespace logging {
 //===--------------------------------------------------------------------===//
 // Circular Buffer Pool
 //===--------------------------------------------------------------------===//
+
+/*
+ * Lock-free ring of log buffers. Put and Get claim a slot by advancing the
+ * head or the tail, the buffer itself is handed over through the slot with
+ * release/acquire ordering, so a buffer is only seen after it was written.
+ */
 class CircularBufferPool : public BufferPool {
  public:
   CircularBufferPool();
@@ -56,7 +62,7 @@ class CircularBufferPool : public BufferPool {
   unsigned int GetSize();
 
  private:
-  std::unique_ptr<LogBuffer> buffers_[BUFFER_POOL_SIZE];
+  std::atomic<LogBuffer *> buffers_[BUFFER_POOL_SIZE];
   std::atomic<unsigned int> head_;
   std::atomic<unsigned int> tail_;
 };
@@ -66,6 +66,12 @@ class FrontendLogger : public Logger {
 
   size_t GetFsyncCount() const { return fsync_count; }
 
+  size_t GetLoggedBytes() const { return logged_bytes; }
+
+  // move the commit latencies of the backend loggers into the vector, only
+  // once the workers are done
+  void CollectCommitLatencies(std::vector<uint64_t> &commit_latencies);
+
   void SetTestMode(bool test_mode) { this->test_mode_ = test_mode; }
 
   void ReplayLog(const char *, size_t len);
@@ -92,6 +98,7 @@ class FrontendLogger : public Logger {
     }
 
     fsync_count = 0;
+    logged_bytes = 0;
     max_flushed_commit_id = 0;
     max_collected_commit_id = 0;
     max_seen_commit_id = 0;
@@ -125,10 +132,14 @@ class FrontendLogger : public Logger {
   // period with which it collects log records from backend loggers
   int wait_timeout;
 
-  // stats
-  size_t fsync_count = 0;
+  // stats. The sync thread of a write ahead frontend logger updates the
+  // fsync count and the max flushed commit id while backends read them
+  std::atomic<size_t> fsync_count{0};
+
+  // bytes written to the log, after compression
+  size_t logged_bytes = 0;
 
-  cid_t max_flushed_commit_id = 0;
+  std::atomic<cid_t> max_flushed_commit_id{0};
 
   cid_t max_collected_commit_id = 0;
 
@@ -30,6 +30,7 @@
 
 #include "logging/log_record.h"
 #include "common/macros.h"
+#include "type/serializeio.h"
 
 namespace peloton {
 namespace logging {
@@ -39,6 +40,13 @@ class BackendLogger;
 //===--------------------------------------------------------------------===//
 // Log Buffer
 //===--------------------------------------------------------------------===//
+
+/*
+ * Records are serialized in place at the end of the buffer, there is no
+ * intermediate copy. A record that does not fit into the remaining space
+ * grows the buffer, the backend logger hands a buffer to its frontend
+ * logger once it is full.
+ */
 class LogBuffer {
  public:
   LogBuffer(BackendLogger *);
@@ -48,7 +56,7 @@ class LogBuffer {
   // get serialized data field
   char *GetData() { return elastic_data_.get(); }
 
-  // serialize and write a log record to buffer
+  // serialize a log record at the end of the buffer
   bool WriteRecord(LogRecord *);
 
   // clean up and reset content
@@ -61,6 +69,9 @@ class LogBuffer {
     size_ = size;
   }
 
+  // whether the buffer holds enough data to be persisted
+  inline bool IsFull() const { return size_ >= threshold_; }
+
   inline void SetMaxLogId(cid_t new_max) { max_log_id = new_max; }
 
   inline cid_t GetMaxLogId() { return max_log_id; }
@@ -68,8 +79,20 @@ class LogBuffer {
   inline BackendLogger *GetBackendLogger() { return backend_logger_; }
 
  private:
-  // write data to the log buffer, return false if not enough space
-  bool WriteData(char *data, size_t len);
+  // Serialize output writing into the buffer
+  class Output : public SerializeOutput {
+   public:
+    Output(LogBuffer &log_buffer) : log_buffer_(log_buffer) {
+      initialize(log_buffer.elastic_data_.get(), log_buffer.capacity_);
+      setPosition(log_buffer.size_);
+    }
+
+   protected:
+    void expand(size_t minimum_desired);
+
+   private:
+    LogBuffer &log_buffer_;
+  };
 
   // the size of buffer used already
   size_t size_ = 0;
@@ -77,6 +100,9 @@ class LogBuffer {
   // the total capacity of the buffer
   size_t capacity_;
 
+  // the size at which the buffer is full
+  size_t threshold_;
+
   // Dynamically adjusted data array
   std::unique_ptr<char[]> elastic_data_;
 
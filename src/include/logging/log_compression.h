@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_compression.h
+//
+// Identification: src/include/logging/log_compression.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "type/types.h"
+
+// default codec level, the fastest one of both codecs
+#define DEFAULT_LOG_COMPRESSION_LEVEL 1
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Log Compression
+//===--------------------------------------------------------------------===//
+
+/*
+ * Block compression of log buffers. The codecs are optional dependencies,
+ * a codec that was not found at build time is not supported.
+ *
+ * A compressed block is written as a record of its own :
+ *       - LogRecordType         : LOGRECORD_TYPE_COMPRESSED_BLOCK
+ *       - Frame length          : int
+ *       - Codec                 : char
+ *       - Uncompressed length   : int
+ *       - Max log id            : cid_t
+ *       - Compressed records    : char[]
+ */
+class LogCompression {
+ public:
+  // whether the codec is available in this build
+  static bool IsSupported(LogCompressionType compression_type);
+
+  // compress the data into the output, returns the compressed length or 0
+  // if the codec failed
+  static size_t Compress(LogCompressionType compression_type, int level,
+                         const char *data, size_t length,
+                         std::vector<char> &output);
+
+  // decompress exactly raw_length bytes into the output
+  static bool Decompress(LogCompressionType compression_type,
+                         const char *data, size_t length, char *output,
+                         size_t raw_length);
+
+  // size of the block header following the frame length
+  static size_t GetBlockHeaderSize() {
+    return sizeof(char) + sizeof(int32_t) + sizeof(int64_t);
+  }
+};
+
+//===--------------------------------------------------------------------===//
+// Log Compression Stats
+//===--------------------------------------------------------------------===//
+
+struct LogCompressionStats {
+  // log buffers handed to the codec
+  size_t buffer_count = 0;
+
+  // log buffers written compressed
+  size_t block_count = 0;
+
+  // bytes of the log buffers handed to the codec
+  size_t raw_bytes = 0;
+
+  // bytes written for them, including the block headers
+  size_t written_bytes = 0;
+
+  // time spent in the codec
+  uint64_t compression_time_us = 0;
+
+  double GetCompressionRatio() const {
+    if (written_bytes == 0) return 1.0;
+    return static_cast<double>(raw_bytes) / written_bytes;
+  }
+};
+
+}  // namespace logging
+}  // namespace peloton
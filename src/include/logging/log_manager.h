@@ -12,18 +12,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include "backend_logger.h"
 #include "concurrency/transaction.h"
 #include "frontend_logger.h"
 #include "loggers/wal_frontend_logger.h"
+#include "logging/log_compression.h"
 #include "logging/logger.h"
 
 #define DEFAULT_NUM_FRONTEND_LOGGERS 1
 
+#define DEFAULT_NUM_RECOVERY_THREADS 4
+
 //===--------------------------------------------------------------------===//
 // GUC Variables
 //===--------------------------------------------------------------------===//
@@ -32,6 +38,8 @@ extern peloton::LoggingType peloton_logging_mode;
 namespace peloton {
 namespace logging {
 
+class ReplicationSender;
+
 //===--------------------------------------------------------------------===//
 // Log Manager
 //===--------------------------------------------------------------------===//
@@ -128,6 +136,73 @@ class LogManager {
   // get the status of sychronus commit
   bool GetSyncCommit(void) const { return syncronization_commit; }
 
+  // Whether frontend loggers flush once per epoch instead of after every
+  // flush interval. Synchronous commits are then acknowledged with the
+  // group flush of the epoch they committed in. Requires the epoch manager
+  // to be running.
+  void SetEpochGroupCommit(bool epoch_group_commit) {
+    epoch_group_commit_ = epoch_group_commit;
+  }
+
+  // get the status of epoch group commit
+  bool GetEpochGroupCommit(void) const { return epoch_group_commit_; }
+
+  // Number of threads each frontend logger replays its committed log
+  // records with during recovery, and tables are indexed with afterwards
+  void SetRecoveryThreadCount(unsigned int recovery_thread_count) {
+    recovery_thread_count_ = std::max(recovery_thread_count, 1u);
+  }
+
+  unsigned int GetRecoveryThreadCount(void) const {
+    return recovery_thread_count_;
+  }
+
+  // Codec and level the write ahead frontend loggers compress the log
+  // buffers with before writing them. Falls back to no compression if the
+  // codec is not available in this build.
+  void SetLogCompression(LogCompressionType compression_type,
+                         int level = DEFAULT_LOG_COMPRESSION_LEVEL);
+
+  LogCompressionType GetLogCompressionType(void) const {
+    return log_compression_type_;
+  }
+
+  int GetLogCompressionLevel(void) const { return log_compression_level_; }
+
+  // compression stats summed over the frontend loggers
+  LogCompressionStats GetLogCompressionStats();
+
+  // Whether every worker records the latency of its commits, from logging
+  // the commit record until the commit is durable for synchronous commits
+  void SetCommitLatencyTracking(bool commit_latency_tracking) {
+    commit_latency_tracking_ = commit_latency_tracking;
+  }
+
+  bool GetCommitLatencyTracking(void) const {
+    return commit_latency_tracking_;
+  }
+
+  // the commit latencies recorded since the last call, in microseconds.
+  // Only call it once the workers are done.
+  std::vector<uint64_t> CollectCommitLatencies();
+
+  // fsyncs and bytes written summed over the frontend loggers
+  size_t GetFsyncCount();
+
+  // Stream the log to the standby serving it at standby_address
+  // ("ip:port"). The acknowledgements of the standby are received on
+  // local_port. Unless the replication is asynchronous, synchronous commits
+  // also wait for the standby to acknowledge them. Must be set before
+  // logging starts, with a single write ahead frontend logger.
+  bool SetReplication(const std::string &standby_address,
+                      ReplicationType replication_type, int local_port);
+
+  ReplicationSender *GetReplicationSender() {
+    return replication_sender_.get();
+  }
+
+  size_t GetLoggedBytes();
+
   // returns true if a frontend logger is active
   bool ContainsFrontendLogger(void);
 
@@ -175,9 +250,10 @@ class LogManager {
   // log the beginning of a commited transaction
   void LogBeginTransaction(cid_t commit_id);
 
-  // log an update
+  // log an update. if the updated columns are given, only those are logged
   void LogUpdate(cid_t commit_id, const ItemPointer &old_version,
-                 const ItemPointer &new_version);
+                 const ItemPointer &new_version,
+                 const std::vector<oid_t> *updated_columns = nullptr);
 
   // log an insert
   void LogInsert(cid_t commit_id, const ItemPointer &new_location);
@@ -295,6 +371,16 @@ class LogManager {
   bool syncronization_commit =
       true;  // default should be true because it is safest
 
+  bool epoch_group_commit_ = false;
+
+  unsigned int recovery_thread_count_ = DEFAULT_NUM_RECOVERY_THREADS;
+
+  LogCompressionType log_compression_type_ = LogCompressionType::NONE;
+
+  int log_compression_level_ = DEFAULT_LOG_COMPRESSION_LEVEL;
+
+  bool commit_latency_tracking_ = false;
+
   // name of log file (for wbl)
   std::string log_file_name;
 
@@ -313,6 +399,8 @@ class LogManager {
 
   bool replicating_ = false;
 
+  std::unique_ptr<ReplicationSender> replication_sender_;
+
   bool no_write_ = false;
 
   // max oid after recovery
@@ -61,7 +61,21 @@ class LogRecord {
 
   cid_t GetTransactionId() const { return cid; }
 
-  virtual bool Serialize(CopySerializeOutput &output) = 0;
+  // append the serialized record at the current position of the output
+  virtual bool SerializeTo(SerializeOutput &output) = 0;
+
+  // serialize the record into a message of its own
+  bool Serialize(CopySerializeOutput &output) {
+    output.Reset();
+    bool status = SerializeTo(output);
+
+    delete[] message;
+    message_length = output.Size();
+    message = new char[message_length];
+    PL_MEMCPY(message, output.Data(), message_length);
+
+    return status;
+  }
 
   char *GetMessage(void) const { return message; }
 
@@ -37,6 +37,8 @@ class WriteAheadBackendLogger : public BackendLogger {
                             ItemPointer insert_location,
                             ItemPointer delete_location,
                             const void *data = nullptr);
+
+  LogRecordType GetTupleRecordType(LogRecordType log_record_type);
 };
 
 }  // namespace logging
@@ -15,16 +15,24 @@
 
 #include "logging/frontend_logger.h"
 #include "logging/records/tuple_record.h"
+#include "logging/log_compression.h"
 #include "logging/log_file.h"
 #include "executor/executors.h"
 
 #include <dirent.h>
 #include <vector>
+#include <map>
 #include <set>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 extern int peloton_flush_frequency_micros;
 
+// number of committed records recovery buffers before replaying them
+#define RECOVERY_REPLAY_BATCH_SIZE 100000
+
 namespace peloton {
 
 namespace concurrency {
@@ -33,6 +41,8 @@ class Transaction;
 
 namespace logging {
 
+class ReplicationSender;
+
 typedef std::chrono::high_resolution_clock Clock;
 
 typedef std::chrono::microseconds Micros;
@@ -60,17 +70,38 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   void DoRecovery(void);
 
+  // replay a block of log records streamed from the primary, used by the
+  // standby
+  void ReplayLogBlock(const char *data, size_t length, cid_t max_commit_id);
+
+  // hand the versions the streamed blocks ended at or before
+  // max_end_commit_id to the garbage collector, returns their number
+  size_t RecycleEndedVersions(cid_t max_end_commit_id);
+
   void RecoverIndex();
 
   void StartTransactionRecovery(cid_t commit_id);
 
   void CommitTransactionRecovery(cid_t commit_id);
 
-  void InsertTuple(TupleRecord *recovery_txn);
+  void InsertTuple(TupleRecord *recovery_txn) {
+    InsertTuple(recovery_txn, max_oid);
+  }
 
-  void DeleteTuple(TupleRecord *recovery_txn);
+  void DeleteTuple(TupleRecord *recovery_txn) {
+    DeleteTuple(recovery_txn, max_oid);
+  }
 
-  void UpdateTuple(TupleRecord *recovery_txn);
+  void UpdateTuple(TupleRecord *recovery_txn) {
+    UpdateTuple(recovery_txn, max_oid);
+  }
+
+  // the tile group ids added for the tuple are tracked in max_tg
+  void InsertTuple(TupleRecord *recovery_txn, oid_t &max_tg);
+
+  void DeleteTuple(TupleRecord *recovery_txn, oid_t &max_tg);
+
+  void UpdateTuple(TupleRecord *recovery_txn, oid_t &max_tg);
 
   void AbortActiveTransactions();
 
@@ -102,16 +133,101 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   void InitSelf();
 
+  const LogCompressionStats &GetCompressionStats() const {
+    return compression_stats_;
+  }
+
   static constexpr auto wal_directory_path = "wal_log";
 
  private:
   std::string GetLogFileName(void);
 
+  // whether the collected records are due for an fsync
+  bool IsFlushDue();
+
+  // read the records of the current log file, and the next ones
+  int ReadLogRecords(cid_t start_commit_id, cid_t max_commit_id);
+
+  //===--------------------------------------------------------------------===//
+  // Replication
+  //===--------------------------------------------------------------------===//
+
+  // send the collected records to the standby once they are durable
+  void ShipReplicationBlock(ReplicationSender *replication_sender);
+
+  //===--------------------------------------------------------------------===//
+  // Pipelined Sync
+  //===--------------------------------------------------------------------===//
+
+  // the log stream of every frontend logger is synced by a thread of its
+  // own, such that the next batch is written while the last one is synced
+  void StartSyncThread();
+
+  void StopSyncThread();
+
+  void SyncLoop();
+
+  // hand the records written up to commit_id to the sync thread
+  void RequestSync(cid_t commit_id);
+
+  // wait until all the requested syncs completed
+  void WaitForSync();
+
+  bool IsSyncPipelined() const { return sync_thread_.joinable(); }
+
+  // the commit id up to which records were written and are or will be
+  // made durable
+  cid_t GetMaxSubmittedCommitId() const {
+    return IsSyncPipelined() ? max_submitted_commit_id_
+                             : max_flushed_commit_id.load();
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Compression
+  //===--------------------------------------------------------------------===//
+
+  // write the records of the log buffer, as a compressed block if the
+  // codec shrinks them
+  void WriteLogBuffer(LogBuffer *log_buffer);
+
+  // decompress the block at the current position of the log file, recovery
+  // then reads the records of the block until it is exhausted
+  bool BeginCompressedBlock();
+
+  // continue recovery from the log file after the block
+  void EndCompressedBlock();
+
+  //===--------------------------------------------------------------------===//
+  // Parallel Replay
+  //===--------------------------------------------------------------------===//
+
+  // apply the records of the committed transactions collected so far, one
+  // thread per partition
+  void ReplayCommittedTransactions();
+
+  // apply the records of a partition in commit id order
+  void ReplayPartition(std::vector<TupleRecord *> &tuple_records,
+                       oid_t &max_tg);
+
+  // remember the committed version at location if the streamed record
+  // ended it at commit_id
+  void RecordEndedVersion(const ItemPointer &location, cid_t commit_id,
+                          bool is_delete);
+
   bool RecoverTableIndexHelper(storage::DataTable *target_table,
                                cid_t start_cid);
 
-  void InsertIndexEntry(storage::Tuple *tuple, storage::DataTable *table,
-                        ItemPointer target_location);
+  // bulk insert the entries of a batch of recovered tuples
+  void InsertIndexEntries(
+      storage::DataTable *table,
+      const std::vector<std::unique_ptr<storage::Tuple>> &tuples,
+      const std::vector<ItemPointer> &target_locations);
+
+  // insert the entries of a batch the index did not take as a whole
+  size_t InsertIndexEntriesOneByOne(
+      index::Index *index,
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entry_list);
 
   //===--------------------------------------------------------------------===//
   // Member Variables
@@ -123,6 +239,11 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   // Txn table during recovery
   std::map<txn_id_t, std::vector<TupleRecord *>> recovery_txn_table;
 
+  // Records of committed txns waiting to be replayed, partitioned by table
+  std::vector<std::vector<TupleRecord *>> replay_partitions_;
+
+  size_t replay_record_count_ = 0;
+
   // Keep tracking max oid for setting next_oid in manager
   // For active processing after recovery
   oid_t max_oid = 0;
@@ -161,6 +282,61 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   TimePoint last_flush = Clock::now();
 
   Micros flush_frequency{peloton_flush_frequency_micros};
+
+  // epoch of the last flush, for epoch group commit
+  uint64_t last_flush_epoch_ = 0;
+
+  // only touched by the frontend thread
+  cid_t max_submitted_commit_id_ = 0;
+
+  std::thread sync_thread_;
+
+  // protects the members below
+  std::mutex sync_mutex_;
+
+  std::condition_variable sync_cv_;
+
+  int sync_fd_ = -1;
+
+  cid_t sync_requested_commit_id_ = 0;
+
+  cid_t synced_commit_id_ = 0;
+
+  bool sync_shutdown_ = false;
+
+  LogCompressionStats compression_stats_;
+
+  // output of the codec, reused across log buffers
+  std::vector<char> compression_buffer_;
+
+  // records of the compressed block recovery is reading
+  std::vector<char> block_data_;
+
+  // the log file recovery returns to after the block
+  FileHandle log_file_handle_;
+
+  bool in_compressed_block_ = false;
+
+  // records collected since the last block was sent to the standby
+  std::vector<char> replication_block_;
+
+  // commit id the pending block covers
+  cid_t replication_block_commit_id_ = 0;
+
+  cid_t shipped_commit_id_ = 0;
+
+  // set while the standby replays a streamed block
+  bool replaying_stream_ = false;
+
+  // commits of the streamed blocks not covered by a block yet
+  std::set<cid_t> stream_commit_ids_;
+
+  // versions ended by the streamed blocks that may still be visible to a
+  // snapshot, by the commit id that ended them
+  std::map<cid_t, GCSet> ended_versions_;
+
+  // the partitions of a block are replayed in parallel
+  std::mutex ended_versions_mutex_;
 };
 
 }  // namespace logging
@@ -46,12 +46,13 @@ class WriteBehindBackendLogger : public BackendLogger {
                             ItemPointer delete_location,
                             const void *data = nullptr);
 
-  void CollectRecordsAndClear(
-      std::vector<std::unique_ptr<LogRecord>> &frontend_queue);
+  LogRecordType GetTupleRecordType(LogRecordType log_record_type);
 
- private:
-  void SyncDataForCommit();
+  // Move the tile groups modified by logged transactions to the frontend,
+  // which syncs them before it persists their commit ids
+  void CollectTileGroupsToSync(std::unordered_set<oid_t> &tile_groups);
 
+ private:
   std::unordered_set<oid_t> tile_groups_to_sync_;
 };
 
@@ -14,6 +14,8 @@
 #pragma once
 
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "logging/frontend_logger.h"
 #include "logging/records/transaction_record.h"
@@ -23,15 +25,33 @@
 namespace peloton {
 
 namespace storage {
+class DataTable;
+class TileGroup;
 class TileGroupHeader;
 }
 
 namespace logging {
 
+struct TileGroupLayout;
+
 //===--------------------------------------------------------------------===//
 // Write Behind Frontend Logger
 //===--------------------------------------------------------------------===//
 
+/*
+ * WriteBehindFrontendLogger - Group commit of the tile groups themselves
+ *
+ * The tile groups live in a mapped data file. At every group commit the
+ * tile groups modified by the collected transactions are synced, and a
+ * record is appended to the log with the persisted commit id and a grant
+ * of commit ids that may be used until the next group commit. Versions
+ * with a commit id between the two can be dirty after a crash, recovery
+ * records the gap in the log and hides those versions.
+ *
+ * The layout of every synced tile group in the data file is recorded in a
+ * layout file next to the log, such that recovery can map the tile groups
+ * back into their tables.
+ */
 class WriteBehindFrontendLogger : public FrontendLogger {
  public:
   WriteBehindFrontendLogger(void);
@@ -52,9 +72,33 @@ class WriteBehindFrontendLogger : public FrontendLogger {
 
   std::string GetLogFileName();
 
+  size_t GetSyncedTileGroupCount() const { return synced_tile_group_count_; }
+
+  size_t GetRecoveredTileGroupCount() const {
+    return recovered_tile_group_count_;
+  }
+
+  std::string GetLayoutFileName();
+
   static constexpr auto wbl_log_path = "wbl.log";
 
  private:
+  // sync the tile groups modified by the collected transactions
+  void SyncTileGroups();
+
+  // append the layout of a tile group in the data file to the layout file,
+  // false if the tile group was not allocated from the data file
+  bool RecordTileGroupLayout(storage::TileGroup *tile_group);
+
+  // map the tile groups of the layout file back into their tables
+  void RecoverTileGroups(
+      const std::vector<std::pair<cid_t, cid_t>> &dirty_ranges);
+
+  bool RecoverTileGroup(
+      const TileGroupLayout &layout,
+      const std::vector<std::pair<cid_t, cid_t>> &dirty_ranges,
+      std::unordered_set<storage::DataTable *> &recovered_tables);
+
   //===--------------------------------------------------------------------===//
   // Member Variables
   //===--------------------------------------------------------------------===//
@@ -73,6 +117,26 @@ class WriteBehindFrontendLogger : public FrontendLogger {
 
   // Keep tracking latest cid for setting next commit in txn manager
   cid_t max_commit_id_seen = INVALID_CID;
+
+  // Tile groups to sync at the current group commit
+  std::unordered_set<oid_t> tile_groups_to_sync_;
+
+  // File pointer and descriptor of the tile group layouts
+  FILE *layout_file;
+  int layout_file_fd;
+
+  // Header offsets in the data file of the tile groups whose layout is
+  // recorded. A tile group released by the gc is recorded again.
+  std::unordered_map<oid_t, size_t> recorded_tile_groups_;
+
+  // stats
+  size_t synced_tile_group_count_ = 0;
+
+  size_t recovered_tile_group_count_ = 0;
+
+  // Persisted commit id and grant of the last record
+  cid_t last_persistent_commit_id_ = INVALID_CID;
+  cid_t last_grant_commit_id_ = INVALID_CID;
 };
 
 }  // namespace logging
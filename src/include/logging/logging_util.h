@@ -59,6 +59,11 @@ class LoggingUtil {
                                              type::AbstractPool *pool,
                                              FileHandle &file_handle);
 
+  // Builds a tuple that only holds the changed columns of a delta update
+  static storage::Tuple *ReadTupleDeltaRecordBody(
+      const catalog::Schema *schema, type::AbstractPool *pool,
+      FileHandle &file_handle, std::vector<oid_t> &column_ids);
+
   static void SkipTupleRecordBody(FileHandle &file_handle);
 
   static int GetFileSizeFromFileName(const char *);
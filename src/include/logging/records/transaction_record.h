@@ -40,7 +40,7 @@ class TransactionRecord : public LogRecord, Printable {
   // Serial/Deserialization
   //===--------------------------------------------------------------------===//
 
-  bool Serialize(CopySerializeOutput &output);
+  bool SerializeTo(SerializeOutput &output);
 
   void Deserialize(CopySerializeInput &input);
 
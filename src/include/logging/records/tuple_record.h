@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/item_pointer.h"
 #include "common/printable.h"
 #include "logging/log_record.h"
@@ -60,9 +62,9 @@ class TupleRecord : public LogRecord, Printable {
   // Serial/Deserialization
   //===--------------------------------------------------------------------===//
 
-  bool Serialize(CopySerializeOutput &output);
+  bool SerializeTo(SerializeOutput &output);
 
-  void SerializeHeader(CopySerializeOutput &output);
+  void SerializeHeader(SerializeOutput &output);
 
   void DeserializeHeader(CopySerializeInput &input);
 
@@ -82,6 +84,13 @@ class TupleRecord : public LogRecord, Printable {
 
   storage::Tuple *GetTuple();
 
+  // columns carried by a delta update, empty for all others
+  void SetColumnIds(const std::vector<oid_t> &column_ids) {
+    this->column_ids = column_ids;
+  }
+
+  const std::vector<oid_t> &GetColumnIds() const { return column_ids; }
+
   static size_t GetTupleRecordSize(void);
 
   // Get a string representation for debugging
@@ -107,6 +116,9 @@ class TupleRecord : public LogRecord, Printable {
   // tuple (for deserialize
   storage::Tuple *tuple = nullptr;
 
+  // changed columns of a delta update
+  std::vector<oid_t> column_ids;
+
   // database id
   oid_t db_oid = DEFAULT_DB_ID;
 };
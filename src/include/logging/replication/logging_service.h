@@ -0,0 +1,48 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logging_service.h
+//
+// Identification: src/include/logging/replication/logging_service.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include "peloton/proto/logging_service.pb.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Logging Service
+//===--------------------------------------------------------------------===//
+
+/*
+ * LoggingService - Rpc service of the replication stream
+ *
+ * On the standby, a request carries a chunk of a log block of the primary,
+ * which is handed to the standby. On the primary, the response of the
+ * standby acknowledges the commit id it received or replayed the stream up
+ * to.
+ */
+class LoggingService : public networking::PelotonLoggingService {
+ public:
+  virtual void LogRecordReplay(
+      ::google::protobuf::RpcController *controller,
+      const networking::LogRecordReplayRequest *request,
+      networking::LogRecordReplayResponse *response,
+      ::google::protobuf::Closure *done);
+
+  // Serve the logging service on the port, in a thread of its own. The rpc
+  // layer has a single server per process, both the primary and the standby
+  // start it once and keep it running until the process exits.
+  static bool StartServer(int port);
+};
+
+}  // namespace logging
+}  // namespace peloton
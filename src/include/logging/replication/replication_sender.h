@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// replication_sender.h
+//
+// Identification: src/include/logging/replication/replication_sender.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include "networking/rpc_channel.h"
+#include "networking/rpc_controller.h"
+#include "peloton/proto/logging_service.pb.h"
+#include "type/types.h"
+
+// size of the chunks a log block is sent in
+#define REPLICATION_CHUNK_SIZE (256 * 1024)
+
+// time a commit waits for the standby before the stream is considered broken
+#define REPLICATION_ACK_TIMEOUT_MS 10000
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Replication Sender
+//===--------------------------------------------------------------------===//
+
+/*
+ * ReplicationSender - Streams the log of the primary to a standby
+ *
+ * The write ahead frontend logger hands it the records it flushed, as blocks
+ * that hold every transaction that committed up to the commit id of the
+ * block. A block is sent as a sequence of LogRecordReplay requests, the
+ * last one of them marks the end of the block.
+ *
+ * The standby acknowledges a block once it received it, or with synchronous
+ * replication once it replayed it. Synchronous commits wait for that
+ * acknowledgement unless the replication is asynchronous. Once the standby
+ * can not be reached or does not acknowledge a commit in time, the stream is
+ * broken and no longer sent, commits then stop waiting for it.
+ */
+class ReplicationSender {
+ public:
+  ReplicationSender(const ReplicationSender &) = delete;
+  ReplicationSender &operator=(const ReplicationSender &) = delete;
+  ReplicationSender(ReplicationSender &&) = delete;
+  ReplicationSender &operator=(ReplicationSender &&) = delete;
+
+  // standby_address is the "ip:port" the standby serves the stream on
+  ReplicationSender(const std::string &standby_address,
+                    ReplicationType replication_type);
+
+  // send the records of a block, called by the frontend logger
+  void SendBlock(const char *data, size_t length, cid_t max_commit_id);
+
+  // the standby acknowledged the stream up to the commit id
+  void Acknowledge(int64_t sequence_number, cid_t commit_id);
+
+  // wait until the standby acknowledged the commit, returns false if the
+  // stream is broken
+  bool WaitForAcknowledgement(cid_t commit_id);
+
+  cid_t GetAcknowledgedCommitId();
+
+  inline ReplicationType GetReplicationType() const {
+    return replication_type_;
+  }
+
+  bool IsBroken();
+
+ private:
+  networking::ResponseType GetResponseType() const;
+
+  networking::RpcChannel channel_;
+
+  networking::RpcController controller_;
+
+  networking::PelotonLoggingService::Stub stub_;
+
+  ReplicationType replication_type_;
+
+  // only touched by the frontend logger
+  int64_t next_sequence_number_ = 0;
+
+  // protects the members below
+  std::mutex ack_mutex_;
+
+  std::condition_variable ack_cv_;
+
+  cid_t acknowledged_commit_id_ = 0;
+
+  bool broken_ = false;
+};
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// replication_standby.h
+//
+// Identification: src/include/logging/replication/replication_standby.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "peloton/proto/logging_service.pb.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}
+
+namespace logging {
+
+class WriteAheadFrontendLogger;
+
+//===--------------------------------------------------------------------===//
+// Replication Standby
+//===--------------------------------------------------------------------===//
+
+/*
+ * ReplicationStandby - Replays the log stream of a primary
+ *
+ * The standby process creates the same tables as the primary, and then
+ * serves the stream on a port. The blocks of the stream are replayed one
+ * after another by a replay thread, with the parallel replay of recovery.
+ * Replay keeps the versions it invalidates, so read-only transactions on
+ * the standby read a consistent snapshot at the commit id replayed when
+ * they began, while the replay goes on.
+ *
+ * With synchronous replication a block is acknowledged by the replay thread
+ * once it was replayed, otherwise once it was received. The rpc server
+ * never waits for the replay.
+ *
+ * The indexes are not maintained by the replay, queries on the standby
+ * read the tables with sequential scans.
+ *
+ * Snapshot transactions take their begin commit id from the stream
+ * instead of the epoch manager, so the standby tracks them itself. After
+ * each block, the versions the replay ended at or before the begin of the
+ * oldest running snapshot are handed to the garbage collector.
+ */
+class ReplicationStandby {
+ public:
+  ReplicationStandby(const ReplicationStandby &) = delete;
+  ReplicationStandby &operator=(const ReplicationStandby &) = delete;
+  ReplicationStandby(ReplicationStandby &&) = delete;
+  ReplicationStandby &operator=(ReplicationStandby &&) = delete;
+
+  // global singleton
+  static ReplicationStandby &GetInstance(void);
+
+  // serve the stream of the primary on the port, the tables of the primary
+  // must have been created before
+  bool Start(int port);
+
+  // called by the logging service with a chunk of the stream, done sends
+  // the response once it is set
+  void ReceiveChunk(const networking::LogRecordReplayRequest &request,
+                    networking::LogRecordReplayResponse *response,
+                    google::protobuf::Closure *done);
+
+  // begin a read-only transaction on the snapshot of the replayed commits
+  concurrency::Transaction *BeginSnapshotTransaction(size_t thread_id = 0);
+
+  // end a transaction begun by BeginSnapshotTransaction
+  void EndSnapshotTransaction(concurrency::Transaction *txn);
+
+  // wait until the commits up to commit_id were replayed, returns false if
+  // they were not replayed within the timeout
+  bool WaitForReplay(cid_t commit_id, uint64_t timeout_ms);
+
+  inline cid_t GetReplayedCommitId() const {
+    return replayed_commit_id_.load();
+  }
+
+ private:
+  ReplicationStandby();
+  ~ReplicationStandby();
+
+  // a block of the stream waiting to be replayed
+  struct ReplayTask {
+    std::vector<char> data;
+    cid_t max_commit_id;
+    // the acknowledgement sent once the block was replayed, if any
+    networking::LogRecordReplayResponse *response;
+    google::protobuf::Closure *done;
+  };
+
+  void ReplayLoop();
+
+  // the commit id the versions ended at or before are visible to no
+  // snapshot, called with the replay mutex held
+  cid_t GetOldestSnapshotCommitId() const;
+
+  // applies the blocks of the stream
+  std::unique_ptr<WriteAheadFrontendLogger> replayer_;
+
+  // chunks of the block being received, only touched by the rpc server
+  std::vector<char> block_data_;
+
+  std::thread replay_thread_;
+
+  // protects the members below
+  std::mutex replay_mutex_;
+
+  std::condition_variable replay_cv_;
+
+  std::deque<ReplayTask> replay_queue_;
+
+  bool replay_shutdown_ = false;
+
+  // begin commit ids of the running snapshot transactions
+  std::multiset<cid_t> snapshot_commit_ids_;
+
+  std::atomic<cid_t> replayed_commit_id_;
+};
+
+}  // namespace logging
+}  // namespace peloton
@@ -145,6 +145,13 @@ class Connection {
    */
   void MoveBufferData();
 
+  /*
+   * Send the response of a request to the rpc method with the opcode. The
+   * rpc methods send it by running done, which may happen after they
+   * returned
+   */
+  void SendResponse(uint64_t opcode, const google::protobuf::Message& response);
+
  private:
   // addr is the other side address
   NetworkAddress addr_;
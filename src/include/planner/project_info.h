@@ -59,7 +59,8 @@ class ProjectInfo {
 
   bool Evaluate(storage::Tuple *dest, const AbstractTuple *tuple1,
                 const AbstractTuple *tuple2,
-                executor::ExecutorContext *econtext) const;
+                executor::ExecutorContext *econtext,
+                const std::vector<bool> *skipped_targets = nullptr) const;
 
   bool Evaluate(AbstractTuple *dest, const AbstractTuple *tuple1,
                 const AbstractTuple *tuple2,
@@ -140,6 +140,11 @@ class DataTable : public AbstractTable {
 
   size_t GetTileGroupCount() const;
 
+  // Replaces a tile group without live tuples with an empty tile group of
+  // the same id, releasing its memory once no scan holds it anymore. The
+  // tile group keeps its offset, such that concurrent scans are unaffected
+  void ReleaseTileGroup(const oid_t &tile_group_id);
+
   // Get a tile group with given layout
   TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
 
@@ -164,6 +169,34 @@ class DataTable : public AbstractTable {
 
   oid_t GetValidIndexCount() const;
 
+  // While deferred, InsertTuple() only allocates the indirection of a new
+  // tuple and skips index maintenance. Only meant for loading a table that
+  // is not read by any transaction yet; BulkLoadIndexes() must follow.
+  void SetIndexBuildDeferred(const bool deferred) {
+    index_build_deferred_ = deferred;
+  }
+
+  bool IsIndexBuildDeferred() const { return index_build_deferred_; }
+
+  // Index the tuples of tile groups [begin_offset, end_offset) with a pool
+  // of thread_count workers (0 = hardware concurrency), each one collecting
+  // the keys of its own share of tile groups. Unless concurrent is set the
+  // runs are merged and loaded in one batch, which requires that no other
+  // thread uses the index yet. In concurrent mode the index must
+  // already be attached to the table (so that writers maintain it
+  // themselves) and each worker inserts its run on its own.
+  bool PopulateIndex(index::Index *index, const size_t begin_offset,
+                     const size_t end_offset, const size_t thread_count,
+                     const bool concurrent);
+
+  // Build the given index from the latest version of all tuples
+  bool BulkLoadIndex(index::Index *index, const size_t thread_count = 0) {
+    return PopulateIndex(index, 0, GetTileGroupCount(), thread_count, false);
+  }
+
+  // Build all indexes after a deferred load and stop deferring
+  bool BulkLoadIndexes();
+
   const std::vector<std::set<oid_t>> &GetIndexColumns() const {
     return indexes_columns_;
   }
@@ -365,6 +398,9 @@ class DataTable : public AbstractTable {
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
 
+  // skip index maintenance on insert (see SetIndexBuildDeferred())
+  bool index_build_deferred_ = false;
+
   //===--------------------------------------------------------------------===//
   // TUNING MEMBERS
   //===--------------------------------------------------------------------===//
@@ -50,6 +50,23 @@ class StorageManager {
 
   void Sync(BackendType type, void *address, size_t length);
 
+  //===--------------------------------------------------------------------===//
+  // Data file of write behind logging
+  //===--------------------------------------------------------------------===//
+
+  // Get the offset of an address in the data file, false if the address
+  // was not allocated from it
+  bool LocateInDataFile(const void *address, size_t &offset) const;
+
+  // Get the address of an offset in the data file, e.g. of a tile group
+  // left by a previous run
+  void *GetDataFileLocation(size_t offset);
+
+  // Allocate only beyond the given offset of the data file
+  void ReserveDataFile(size_t end_offset);
+
+  size_t GetDataFileOffset() const { return data_file_offset; }
+
   size_t GetMsyncCount() const { return msync_count; }
 
   size_t GetClflushCount() const { return clflush_count; }
@@ -57,6 +74,9 @@ class StorageManager {
   size_t GetAllocationCount() const { return allocation_count; }
 
  private:
+  // create or open the data file, and map it in memory
+  void MapDataFile();
+
   // data file address
   void *data_file_address;
 
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 
 #include "catalog/manager.h"
@@ -117,6 +118,12 @@ class Tile : public Printable {
   // Copy current tile in given backend and return new tile
   Tile *CopyTile(BackendType backend_type);
 
+  // Use the inlined data mapped from a checkpoint instead of the allocated
+  // one. The mapping is released with the last tile that uses it, there is
+  // none for the data file of write behind logging.
+  void AdoptMappedData(char *mapped_data,
+                       const std::shared_ptr<void> &mapped_region);
+
   //===--------------------------------------------------------------------===//
   // Size Stats
   //===--------------------------------------------------------------------===//
@@ -197,6 +204,9 @@ class Tile : public Printable {
   // set of fixed-length tuple slots
   char *data;
 
+  // the mapped checkpoint holding the data, if it was adopted
+  std::shared_ptr<void> mapped_region;
+
   // relevant tile group
   TileGroup *tile_group;
 
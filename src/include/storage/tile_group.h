@@ -96,13 +96,16 @@ class TileGroup : public Printable {
                                 const Tuple *tuple);
 
   // insert tuple at specific tuple slot
-  // used by recovery mode
-  oid_t DeleteTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id);
+  // used by recovery mode. With keep_old_version, a committed version in
+  // the slot is only invalidated, so older snapshots still see it
+  oid_t DeleteTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
+                                bool keep_old_version = false);
 
   // insert tuple at specific tuple slot
   // used by recovery mode
   oid_t UpdateTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
-                                ItemPointer new_location);
+                                ItemPointer new_location,
+                                bool keep_old_version = false);
 
   oid_t InsertTupleFromCheckpoint(oid_t tuple_slot_id, const Tuple *tuple,
                                   cid_t commit_id);
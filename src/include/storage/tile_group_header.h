@@ -15,6 +15,7 @@
 #include <atomic>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <vector>
 
@@ -133,6 +134,33 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount() const;
 
+  //===--------------------------------------------------------------------===//
+  // Recycled tuple slots
+  //===--------------------------------------------------------------------===//
+
+  // Marks a slot reset by the GC as free for reuse. Returns true if the
+  // caller must put the tile group on the free list of its table, i.e. the
+  // tile group is neither on the list nor being drained by a backend
+  bool RecycleTupleSlot(const oid_t &tuple_slot_id);
+
+  // Takes up to max_count recycled slots, lowest offsets first. Called by
+  // the backend that took the tile group off the free list, which must call
+  // FinishTakingRecycledTupleSlots() afterwards
+  size_t TakeRecycledTupleSlots(std::vector<oid_t> &tuple_slot_ids,
+                                const size_t max_count);
+
+  // Returns true if the tile group still has recycled slots and must be put
+  // back on the free list of its table
+  bool FinishTakingRecycledTupleSlots();
+
+  oid_t GetRecycledTupleCount() const { return recycled_tuple_count; }
+
+  // Stops slot recycling in a tile group that is being compacted, and drops
+  // the recycled slots that were not taken yet
+  void Retire();
+
+  bool IsRetired() const { return retired; }
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -234,6 +262,14 @@ class TileGroupHeader : public Printable {
   // Sync the contents
   void Sync();
 
+  const char *GetHeaderData() const { return data; }
+
+  size_t GetHeaderSize() const { return header_size; }
+
+  // Use the header entries left in the data file by a previous run instead
+  // of the allocated ones
+  void AdoptMappedData(char *mapped_data);
+
   //===--------------------------------------------------------------------===//
   // Utilities
   //===--------------------------------------------------------------------===//
@@ -285,6 +321,19 @@ class TileGroupHeader : public Printable {
   std::atomic<oid_t> next_tuple_slot;
 
   Spinlock tile_header_lock;
+
+  // one bit per tuple slot, set if the slot was recycled by the GC
+  std::unique_ptr<std::atomic<uint64_t>[]> recycled_slot_bitmap;
+
+  std::atomic<oid_t> recycled_tuple_count;
+
+  // whether the tile group is on the free list of its table (or a backend
+  // is taking slots from it)
+  std::atomic<bool> on_free_list;
+
+  // whether the tile group is being compacted. retired tile groups never
+  // hand out slots again
+  std::atomic<bool> retired;
 };
 
 }  // End storage namespace
@@ -454,6 +454,15 @@ std::string IndexTypeToString(IndexType type);
 IndexType StringToIndexType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const IndexType &type);
 
+enum class IndexPartitionType {
+  INVALID = INVALID_TYPE_ID,  // not partitioned
+  HASH = 1,                   // hash of the whole key
+  RANGE = 2                   // ranges of the leading key column
+};
+std::string IndexPartitionTypeToString(IndexPartitionType type);
+IndexPartitionType StringToIndexPartitionType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const IndexPartitionType &type);
+
 enum class IndexConstraintType {
   // invalid index constraint type
   INVALID = INVALID_TYPE_ID,
@@ -840,11 +849,24 @@ std::ostream &operator<<(std::ostream &os,
 enum class CheckpointType {
   INVALID = INVALID_TYPE_ID,
   NORMAL = 1,
+  FUZZY = 2,
+  IMAGE = 3,
 };
 std::string CheckpointTypeToString(CheckpointType type);
 CheckpointType StringToCheckpointType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const CheckpointType &type);
 
+// Codec the frontend loggers compress log buffers with
+enum class LogCompressionType {
+  INVALID = INVALID_TYPE_ID,
+  NONE = 1,
+  LZ4 = 2,
+  ZSTD = 3,
+};
+std::string LogCompressionTypeToString(LogCompressionType type);
+LogCompressionType StringToLogCompressionType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const LogCompressionType &type);
+
 enum ReplicationType {
   ASYNC_REPLICATION,
   SYNC_REPLICATION,
@@ -882,11 +904,14 @@ enum LogRecordType {
   LOGRECORD_TYPE_TUPLE_INSERT = 11,
   LOGRECORD_TYPE_TUPLE_DELETE = 12,
   LOGRECORD_TYPE_TUPLE_UPDATE = 13,
+  // update that only carries the changed columns
+  LOGRECORD_TYPE_TUPLE_DELTA_UPDATE = 14,
 
   // DML records for Write ahead logging
   LOGRECORD_TYPE_WAL_TUPLE_INSERT = 21,
   LOGRECORD_TYPE_WAL_TUPLE_DELETE = 22,
   LOGRECORD_TYPE_WAL_TUPLE_UPDATE = 23,
+  LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE = 24,
 
   // DML records for Write behind logging
   LOGRECORD_TYPE_WBL_TUPLE_INSERT = 31,
@@ -896,6 +921,9 @@ enum LogRecordType {
   // Record for delimiting transactions
   // includes max persistent commit_id
   LOGRECORD_TYPE_ITERATION_DELIMITER = 41,
+
+  // Compressed log buffer holding whole records
+  LOGRECORD_TYPE_COMPRESSED_BLOCK = 51,
 };
 std::string LogRecordTypeToString(LogRecordType type);
 LogRecordType StringToLogRecordType(const std::string &str);
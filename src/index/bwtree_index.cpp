@@ -12,6 +12,7 @@
 #include "index/bwtree_index.h"
 
 #include "common/logger.h"
+#include "common/parallel_sort.h"
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
 #include "statistics/stats_aggregator.h"
@@ -115,6 +116,136 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   return ret;
 }
 
+/*
+ * BulkInsertEntries() - Insert a batch of key-value pairs
+ *
+ * Keys are converted and sorted in parallel first. If the tree is still
+ * empty it is built bottom-up from the sorted run; otherwise entries are
+ * inserted one by one in key order, which still touches each leaf only once
+ * in a row. For unique indexes the batch is rejected as a whole (nothing is
+ * inserted) if it contains duplicated keys.
+ *
+ * NOTE: Building an empty tree bottom-up is not thread-safe, so the index
+ * must not be visible to other threads until this function returns. In
+ * concurrent mode the batch is only sorted (by the calling thread, since
+ * several batches are usually inserted in parallel) and inserted in key
+ * order through the latch-free insert path
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::BulkInsertEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entry_list,
+    const bool concurrent) {
+  std::vector<std::pair<KeyType, ValueType>> item_list(entry_list.size());
+  for (size_t i = 0; i < entry_list.size(); i++) {
+    item_list[i].first.SetFromKey(entry_list[i].first);
+    item_list[i].second = entry_list[i].second;
+  }
+
+  // Order by key and then by value such that duplicated key-value
+  // pairs become adjacent
+  auto item_cmp = [this](const std::pair<KeyType, ValueType> &a,
+                         const std::pair<KeyType, ValueType> &b) {
+    if (comparator(a.first, b.first) == true) {
+      return true;
+    } else if (comparator(b.first, a.first) == true) {
+      return false;
+    }
+    return std::less<ValueType>()(a.second, b.second);
+  };
+
+  if (concurrent == true) {
+    std::sort(item_list.begin(), item_list.end(), item_cmp);
+  } else {
+    ParallelSort(item_list.begin(), item_list.end(), item_cmp);
+  }
+
+  if (metadata->HasUniqueKeys() == true) {
+    for (size_t i = 1; i < item_list.size(); i++) {
+      if (equals(item_list[i - 1].first, item_list[i].first) == true) {
+        LOG_DEBUG("Duplicated key in bulk insert into unique index %s",
+                  GetName().c_str());
+        return false;
+      }
+    }
+  }
+
+  if (concurrent == true) {
+    for (auto &item : item_list) {
+      bool ret;
+      if (metadata->HasUniqueKeys() == true) {
+        bool predicate_satisfied = false;
+        ret = container.ConditionalInsert(
+            item.first, item.second, [](const void *) { return true; },
+            &predicate_satisfied);
+      } else {
+        ret = container.Insert(item.first, item.second);
+      }
+
+      // The key may have been indexed by a concurrent writer already, which
+      // is only fine if it points to the same version chain
+      if (ret == false) {
+        auto value_set = container.GetValue(item.first);
+        if (value_set.find(item.second) == value_set.end()) {
+          LOG_DEBUG("Conflicting key in bulk insert into unique index %s",
+                    GetName().c_str());
+          return false;
+        }
+      }
+    }
+  } else if (container.BulkLoad(item_list) == false) {
+    for (auto &item : item_list) {
+      container.Insert(item.first, item.second);
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    for (size_t i = 0; i < item_list.size(); i++) {
+      stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(
+          metadata);
+    }
+  }
+
+  return true;
+}
+
+/*
+ * BulkDeleteEntries() - Removes a batch of key-value pairs
+ *
+ * Entries are deleted in key order, such that consecutive deletes land on
+ * the same leaf while its delta chain is still cached
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+size_t BWTREE_INDEX_TYPE::BulkDeleteEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entry_list) {
+  std::vector<std::pair<KeyType, ValueType>> item_list(entry_list.size());
+  for (size_t i = 0; i < entry_list.size(); i++) {
+    item_list[i].first.SetFromKey(entry_list[i].first);
+    item_list[i].second = entry_list[i].second;
+  }
+
+  std::sort(item_list.begin(), item_list.end(),
+            [this](const std::pair<KeyType, ValueType> &a,
+                   const std::pair<KeyType, ValueType> &b) {
+              return comparator(a.first, b.first);
+            });
+
+  size_t delete_count = 0;
+  for (auto &item : item_list) {
+    if (container.Delete(item.first, item.second) == true) {
+      delete_count++;
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        delete_count, metadata);
+  }
+
+  return delete_count;
+}
+
 /*
  * Scan() - Scans a range inside the index using index scan optimizer
  *
@@ -190,6 +321,84 @@ void BWTREE_INDEX_TYPE::Scan(
   return;
 }
 
+/*
+ * ScanWithKeys() - Scans a range inside the index and copies out the keys
+ *
+ * The range is determined in the same way as in Scan(). Each key is decoded
+ * into a tuple of the key schema, which also holds the included columns
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ScanWithKeys(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    std::vector<std::unique_ptr<storage::Tuple>> &key_result,
+    const ConjunctionScanPredicate *csp_p, type::AbstractPool *key_pool,
+    uint64_t limit) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  auto key_schema = GetKeySchema();
+  oid_t key_column_count = key_schema->GetColumnCount();
+
+  auto add_entry = [&](const KeyType &index_key, const ValueType &value) {
+    KeyType key_copy = index_key;
+    const storage::Tuple key_tuple = key_copy.GetTupleForComparison(key_schema);
+
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    for (oid_t column_itr = 0; column_itr < key_column_count; column_itr++) {
+      key->SetValue(column_itr, key_tuple.GetValue(column_itr), key_pool);
+    }
+
+    result.push_back(value);
+    key_result.push_back(std::move(key));
+  };
+
+  // Whether the limit has been reached
+  uint64_t scanned_count = 0;
+  auto reach_limit = [&]() {
+    return limit != 0 && scanned_count++ >= limit;
+  };
+
+  if (csp_p->IsFullIndexScan() == true) {
+    for (auto scan_itr = container.Begin();
+         (scan_itr.IsEnd() == false) && (reach_limit() == false);
+         scan_itr++) {
+      add_entry(scan_itr->first, scan_itr->second);
+    }
+  } else {
+    // A point query is a range whose low key equals its high key
+    const storage::Tuple *low_key_p = csp_p->IsPointQuery() == true
+                                          ? csp_p->GetPointQueryKey()
+                                          : csp_p->GetLowKey();
+    const storage::Tuple *high_key_p = csp_p->IsPointQuery() == true
+                                           ? csp_p->GetPointQueryKey()
+                                           : csp_p->GetHighKey();
+
+    KeyType index_low_key;
+    KeyType index_high_key;
+    index_low_key.SetFromKey(low_key_p);
+    index_high_key.SetFromKey(high_key_p);
+
+    for (auto scan_itr = container.Begin(index_low_key);
+         (scan_itr.IsEnd() == false) &&
+             (container.KeyCmpLessEqual(scan_itr->first, index_high_key)) &&
+             (reach_limit() == false);
+         scan_itr++) {
+      add_entry(scan_itr->first, scan_itr->second);
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return true;
+}
+
 /*
  * ScanLimit() - Scan the index with predicate and limit/offset
  *
@@ -14,6 +14,7 @@
 #include "catalog/schema.h"
 #include "common/exception.h"
 #include "common/logger.h"
+#include "container/cuckoo_map.h"
 #include "storage/tuple.h"
 #include "type/ephemeral_pool.h"
 
@@ -53,7 +54,8 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
                              const catalog::Schema *tuple_schema,
                              const catalog::Schema *key_schema,
                              const std::vector<oid_t> &key_attrs,
-                             bool unique_keys)
+                             bool unique_keys,
+                             const std::vector<oid_t> &included_attrs)
     : name_(index_name),
       index_oid(index_oid),
       table_oid(table_oid),
@@ -63,6 +65,7 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
       tuple_schema(tuple_schema),
       key_schema(key_schema),
       key_attrs(key_attrs),
+      included_attrs(included_attrs),
       tuple_attrs(),
       unique_keys(unique_keys),
       visible_(IndexMetadata::index_default_visibility) {
@@ -83,6 +86,26 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
     tuple_attrs[tuple_column_id] = i;
   }
 
+  // Included columns follow the key columns inside the index key
+  for (oid_t i = 0; i < included_attrs.size(); i++) {
+    oid_t tuple_column_id = included_attrs[i];
+
+    PL_ASSERT(tuple_column_id < tuple_attrs.size());
+    PL_ASSERT(tuple_attrs[tuple_column_id] == INVALID_OID);
+
+    tuple_attrs[tuple_column_id] = key_attrs.size() + i;
+  }
+
+  PL_ASSERT(key_schema->GetColumnCount() ==
+            key_attrs.size() + included_attrs.size());
+
+  // Uniqueness is checked on the whole index key, which would include the
+  // included columns as well
+  if (unique_keys == true && included_attrs.empty() == false) {
+    throw IndexException("Index " + name_ +
+                         " with unique keys can not have included columns");
+  }
+
   // Just in case somebody forgets they set our flag to default and
   // was wondering why there indexes weren't working...
   if (visible_ == false) {
@@ -120,6 +143,48 @@ const std::string IndexMetadata::GetInfo() const {
   return os.str();
 }
 
+/*
+ * SetPartitioning() - Sets how the index is spread over physical indexes
+ *
+ * A single partition (or INVALID partition type) means the index is not
+ * partitioned
+ */
+void IndexMetadata::SetPartitioning(
+    IndexPartitionType partition_type, size_t partition_count,
+    const std::vector<type::Value> &range_bounds) {
+  if (partition_type == IndexPartitionType::RANGE) {
+    // Bounds must be strictly increasing values of the leading key column
+    for (size_t i = 0; i < range_bounds.size(); i++) {
+      if (range_bounds[i].GetTypeId() != key_schema->GetType(0)) {
+        throw IndexException("Range bound type does not match the leading " +
+                             std::string("column of index ") + name_);
+      }
+      if (i > 0 && range_bounds[i - 1].CompareLessThan(range_bounds[i]) !=
+                       type::CMP_TRUE) {
+        throw IndexException("Range bounds of index " + name_ +
+                             " are not increasing");
+      }
+    }
+
+    partition_count = range_bounds.size() + 1;
+  } else if (partition_type == IndexPartitionType::INVALID) {
+    partition_count = 1;
+  }
+
+  if (partition_count == 0) {
+    throw IndexException("Index " + name_ + " needs at least one partition");
+  }
+
+  partition_type_ = partition_type;
+  partition_count_ = partition_count;
+  partition_range_bounds_.clear();
+  if (partition_type == IndexPartitionType::RANGE) {
+    for (auto &bound : range_bounds) {
+      partition_range_bounds_.push_back(bound.Copy());
+    }
+  }
+}
+
 /////////////////////////////////////////////////////////////////////
 // Member function definition for class Index
 /////////////////////////////////////////////////////////////////////
@@ -142,6 +207,10 @@ Index::Index(IndexMetadata *metadata)
   // initialize pool
   pool = new type::EphemeralPool();
 
+  if (metadata->HasIncludedColumns() == true) {
+    covered_updates = new CuckooMap<ItemPointer *, bool>();
+  }
+
   return;
 }
 
@@ -157,6 +226,8 @@ Index::~Index() {
   // Free the varlen pool - it is allocted during construction
   delete pool;
 
+  delete covered_updates;
+
   return;
 }
 
@@ -185,6 +256,99 @@ oid_t Index::TupleColumnToKeyColumn(oid_t tuple_column_id) const {
   return key_column_id;
 }
 
+/*
+ * BulkInsertEntries() - Insert a batch of entries one by one
+ *
+ * For unique indexes any existing entry with the same key is treated as a
+ * conflict, since the batch is supposed to hold exactly one entry per key.
+ * In concurrent mode a conflict with the very same location is not an error,
+ * because a writer may have indexed the tuple since the batch was collected
+ */
+bool Index::BulkInsertEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entry_list,
+    const bool concurrent) {
+  auto conflict = [](const void *) { return true; };
+
+  for (auto &entry : entry_list) {
+    bool ret;
+    if (HasUniqueKeys() == true) {
+      ret = CondInsertEntry(entry.first, entry.second, conflict);
+    } else {
+      ret = InsertEntry(entry.first, entry.second);
+    }
+
+    if (ret == false && concurrent == true) {
+      std::vector<ItemPointer *> result;
+      ScanKey(entry.first, result);
+      ret = std::find(result.begin(), result.end(), entry.second) !=
+            result.end();
+    }
+
+    if (ret == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * BulkDeleteEntries() - Delete a batch of entries one by one
+ */
+size_t Index::BulkDeleteEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entry_list) {
+  size_t delete_count = 0;
+
+  for (auto &entry : entry_list) {
+    if (DeleteEntry(entry.first, entry.second) == true) {
+      delete_count++;
+    }
+  }
+
+  return delete_count;
+}
+
+/*
+ * MarkCoveredUpdate() - Record that the version chain has stale entries
+ *
+ * This is a no-op for indexes without included columns, since they are
+ * never read without visiting the table
+ */
+void Index::MarkCoveredUpdate(ItemPointer *indirection) {
+  if (covered_updates == nullptr) {
+    return;
+  }
+
+  covered_updates->Insert(indirection, true);
+}
+
+bool Index::HasCoveredUpdate(ItemPointer *indirection) const {
+  if (covered_updates == nullptr) {
+    return true;
+  }
+
+  bool updated = false;
+  return covered_updates->Find(indirection, updated);
+}
+
+void Index::ClearCoveredUpdate(ItemPointer *indirection) {
+  if (covered_updates == nullptr) {
+    return;
+  }
+
+  covered_updates->Erase(indirection);
+}
+
+size_t Index::GetCoveredUpdateCount() const {
+  if (covered_updates == nullptr) {
+    return 0;
+  }
+
+  return covered_updates->GetSize();
+}
+
 /*
  * ScanTest() - This is used inside the unit test to check correctness of
  *              scan optimizer - do not change or remove this
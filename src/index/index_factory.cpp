@@ -17,6 +17,7 @@
 #include "index/bwtree_index.h"
 #include "index/index_factory.h"
 #include "index/index_key.h"
+#include "index/partitioned_index.h"
 #include "index/skiplist_index.h"
 #include "type/types.h"
 
@@ -26,6 +27,11 @@ namespace index {
 Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   LOG_TRACE("Creating index %s", metadata->GetName().c_str());
 
+  // A partitioned index creates its partitions through this function
+  if (metadata->IsPartitioned() == true) {
+    return new PartitionedIndex(metadata);
+  }
+
   // The size of the key in bytes
   const auto key_size = metadata->key_schema->GetLength();
   LOG_TRACE("key_size : %d", key_size);
@@ -0,0 +1,481 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partitioned_index.cpp
+//
+// Identification: src/index/partitioned_index.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/partitioned_index.h"
+
+#include <algorithm>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "index/index_factory.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+
+namespace peloton {
+namespace index {
+
+/*
+ * Constructor - Creates one physical index per partition
+ *
+ * Every partition gets a copy of the metadata (which owns its key schema)
+ * without partitioning, such that IndexFactory builds a plain index for it
+ */
+PartitionedIndex::PartitionedIndex(IndexMetadata *metadata)
+    : Index{metadata}, partition_type(metadata->GetPartitionType()) {
+  auto key_schema = metadata->GetKeySchema();
+
+  for (size_t partition_itr = 0;
+       partition_itr < metadata->GetPartitionCount(); partition_itr++) {
+    catalog::Schema *partition_key_schema =
+        catalog::Schema::CopySchema(key_schema);
+    partition_key_schema->SetIndexedColumns(key_schema->GetIndexedColumns());
+
+    IndexMetadata *partition_metadata = new IndexMetadata(
+        metadata->GetName(), metadata->GetOid(), metadata->GetTableOid(),
+        metadata->GetDatabaseOid(), metadata->GetIndexType(),
+        metadata->GetIndexConstraintType(), metadata->GetTupleSchema(),
+        partition_key_schema, metadata->GetKeyAttrs(),
+        metadata->HasUniqueKeys(), metadata->GetIncludedAttrs());
+
+    partitions.emplace_back(IndexFactory::GetIndex(partition_metadata));
+  }
+
+  LOG_TRACE("Created %s index %s with %lu partitions",
+            IndexPartitionTypeToString(partition_type).c_str(),
+            metadata->GetName().c_str(), partitions.size());
+}
+
+PartitionedIndex::~PartitionedIndex() {}
+
+/*
+ * GetRangePartition() - Returns the partition whose range holds the value
+ *
+ * Partitions are few, so the bounds are searched linearly
+ */
+size_t PartitionedIndex::GetRangePartition(const type::Value &value) const {
+  auto &range_bounds = metadata->GetPartitionRangeBounds();
+
+  size_t partition_id = 0;
+  while (partition_id < range_bounds.size() &&
+         value.CompareGreaterThanEquals(range_bounds[partition_id]) ==
+             type::CMP_TRUE) {
+    partition_id++;
+  }
+
+  return partition_id;
+}
+
+/*
+ * GetKeyPartition() - Returns the partition a key is routed to
+ *
+ * Hash partitioning only hashes the key columns, since included columns may
+ * change without the key being moved
+ */
+size_t PartitionedIndex::GetKeyPartition(const storage::Tuple *key) const {
+  if (partition_type == IndexPartitionType::RANGE) {
+    return GetRangePartition(key->GetValue(0));
+  }
+
+  size_t seed = 0;
+  oid_t key_column_count = metadata->GetKeyAttrs().size();
+  for (oid_t column_itr = 0; column_itr < key_column_count; column_itr++) {
+    key->GetValue(column_itr).HashCombine(seed);
+  }
+
+  return seed % partitions.size();
+}
+
+/*
+ * GetScanPartitions() - Returns the range of partitions a scan visits
+ *
+ * Hash partitions can hold any key, so all of them are visited
+ */
+void PartitionedIndex::GetScanPartitions(const ConjunctionScanPredicate *csp_p,
+                                         size_t &first_partition,
+                                         size_t &last_partition) const {
+  first_partition = 0;
+  last_partition = partitions.size() - 1;
+
+  if (partition_type != IndexPartitionType::RANGE ||
+      csp_p->IsFullIndexScan() == true) {
+    return;
+  }
+
+  first_partition = GetRangePartition(csp_p->GetLowKey()->GetValue(0));
+  last_partition = GetRangePartition(csp_p->GetHighKey()->GetValue(0));
+}
+
+///////////////////////////////////////////////////////////////////
+// Point Modification
+///////////////////////////////////////////////////////////////////
+
+bool PartitionedIndex::InsertEntry(const storage::Tuple *key,
+                                   ItemPointer *value) {
+  return partitions[GetKeyPartition(key)]->InsertEntry(key, value);
+}
+
+bool PartitionedIndex::DeleteEntry(const storage::Tuple *key,
+                                   ItemPointer *value) {
+  return partitions[GetKeyPartition(key)]->DeleteEntry(key, value);
+}
+
+/*
+ * CondInsertEntry() - Conditionally inserts into the partition of the key
+ *
+ * All entries with the same key live in the same partition, so uniqueness
+ * only needs to be checked there
+ */
+bool PartitionedIndex::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  return partitions[GetKeyPartition(key)]->CondInsertEntry(key, value,
+                                                           predicate);
+}
+
+/*
+ * BulkInsertEntries() - Splits the batch by partition
+ *
+ * Each partition receives its entries in the original order, so a sorted
+ * batch stays sorted and can still be bulk loaded
+ */
+bool PartitionedIndex::BulkInsertEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entry_list,
+    const bool concurrent) {
+  std::vector<std::vector<std::pair<const storage::Tuple *, ItemPointer *>>>
+      partition_entries(partitions.size());
+
+  for (auto &entry : entry_list) {
+    partition_entries[GetKeyPartition(entry.first)].push_back(entry);
+  }
+
+  for (size_t partition_itr = 0; partition_itr < partitions.size();
+       partition_itr++) {
+    if (partition_entries[partition_itr].empty() == true) {
+      continue;
+    }
+
+    if (partitions[partition_itr]->BulkInsertEntries(
+            partition_entries[partition_itr], concurrent) == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * BulkDeleteEntries() - Splits the batch by partition
+ */
+size_t PartitionedIndex::BulkDeleteEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entry_list) {
+  std::vector<std::vector<std::pair<const storage::Tuple *, ItemPointer *>>>
+      partition_entries(partitions.size());
+
+  for (auto &entry : entry_list) {
+    partition_entries[GetKeyPartition(entry.first)].push_back(entry);
+  }
+
+  size_t delete_count = 0;
+  for (size_t partition_itr = 0; partition_itr < partitions.size();
+       partition_itr++) {
+    if (partition_entries[partition_itr].empty() == true) {
+      continue;
+    }
+
+    delete_count += partitions[partition_itr]->BulkDeleteEntries(
+        partition_entries[partition_itr]);
+  }
+
+  return delete_count;
+}
+
+///////////////////////////////////////////////////////////////////
+// Index Scan
+///////////////////////////////////////////////////////////////////
+
+/*
+ * MergeScanWithKeys() - Scans all partitions and merges them in key order
+ *
+ * Each partition returns its entries in key order, and the merge is stable
+ * over partitions. Returns false if a partition can not return keys
+ */
+bool PartitionedIndex::MergeScanWithKeys(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ItemPointer *> &result,
+    std::vector<std::unique_ptr<storage::Tuple>> &key_result,
+    const ConjunctionScanPredicate *csp_p, type::AbstractPool *key_pool,
+    uint64_t limit) {
+  std::vector<ItemPointer *> partition_result;
+  std::vector<std::unique_ptr<storage::Tuple>> partition_key_result;
+
+  for (auto &partition : partitions) {
+    if (partition->ScanWithKeys(value_list, tuple_column_id_list, expr_list,
+                                scan_direction, partition_result,
+                                partition_key_result, csp_p, key_pool,
+                                limit) == false) {
+      return false;
+    }
+  }
+
+  std::vector<size_t> order(partition_result.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return partition_key_result[lhs]->Compare(*partition_key_result[rhs]) < 0;
+  });
+
+  if (limit != 0 && order.size() > limit) {
+    order.resize(limit);
+  }
+
+  for (auto entry_itr : order) {
+    result.push_back(partition_result[entry_itr]);
+    key_result.push_back(std::move(partition_key_result[entry_itr]));
+  }
+
+  return true;
+}
+
+/*
+ * MergeScan() - Same as MergeScanWithKeys() without returning the keys
+ *
+ * If the partitions can not return keys the results are concatenated
+ */
+bool PartitionedIndex::MergeScan(const std::vector<type::Value> &value_list,
+                                 const std::vector<oid_t> &tuple_column_id_list,
+                                 const std::vector<ExpressionType> &expr_list,
+                                 ScanDirectionType scan_direction,
+                                 std::vector<ItemPointer *> &result,
+                                 const ConjunctionScanPredicate *csp_p,
+                                 uint64_t limit) {
+  type::EphemeralPool key_pool;
+  std::vector<ItemPointer *> merge_result;
+  std::vector<std::unique_ptr<storage::Tuple>> key_result;
+
+  if (MergeScanWithKeys(value_list, tuple_column_id_list, expr_list,
+                        scan_direction, merge_result, key_result, csp_p,
+                        &key_pool, limit) == true) {
+    result.insert(result.end(), merge_result.begin(), merge_result.end());
+    return true;
+  }
+
+  LOG_TRACE("Partitions of index %s can not be merged in key order",
+            GetName().c_str());
+
+  for (auto &partition : partitions) {
+    partition->Scan(value_list, tuple_column_id_list, expr_list,
+                    scan_direction, result, csp_p);
+  }
+
+  return false;
+}
+
+void PartitionedIndex::Scan(const std::vector<type::Value> &value_list,
+                            const std::vector<oid_t> &tuple_column_id_list,
+                            const std::vector<ExpressionType> &expr_list,
+                            ScanDirectionType scan_direction,
+                            std::vector<ItemPointer *> &result,
+                            const ConjunctionScanPredicate *csp_p) {
+  if (csp_p->IsPointQuery() == true) {
+    partitions[GetKeyPartition(csp_p->GetPointQueryKey())]->Scan(
+        value_list, tuple_column_id_list, expr_list, scan_direction, result,
+        csp_p);
+    return;
+  }
+
+  if (partition_type == IndexPartitionType::HASH) {
+    MergeScan(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p, 0);
+    return;
+  }
+
+  size_t first_partition, last_partition;
+  GetScanPartitions(csp_p, first_partition, last_partition);
+  for (size_t partition_itr = first_partition;
+       partition_itr <= last_partition; partition_itr++) {
+    partitions[partition_itr]->Scan(value_list, tuple_column_id_list,
+                                    expr_list, scan_direction, result, csp_p);
+  }
+}
+
+/*
+ * ScanLimit() - Scan with limit/offset
+ *
+ * Like the Bw-Tree index, only limit = 1 and offset = 0 on a forward range
+ * scan is optimized: range partitions are visited in order until one has a
+ * qualifying key, and hash partitions each contribute their first key
+ */
+void PartitionedIndex::ScanLimit(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ItemPointer *> &result,
+    const ConjunctionScanPredicate *csp_p, uint64_t limit, uint64_t offset) {
+  if (csp_p->IsPointQuery() == true || limit != 1 || offset != 0 ||
+      scan_direction != ScanDirectionType::FORWARD) {
+    Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
+         csp_p);
+    return;
+  }
+
+  if (partition_type == IndexPartitionType::HASH) {
+    MergeScan(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p, limit);
+    return;
+  }
+
+  size_t first_partition, last_partition;
+  GetScanPartitions(csp_p, first_partition, last_partition);
+  for (size_t partition_itr = first_partition;
+       partition_itr <= last_partition; partition_itr++) {
+    size_t result_size = result.size();
+    partitions[partition_itr]->ScanLimit(value_list, tuple_column_id_list,
+                                         expr_list, scan_direction, result,
+                                         csp_p, limit, offset);
+    if (result.size() > result_size) {
+      return;
+    }
+  }
+}
+
+/*
+ * ScanLimitRange() - Returns up to limit entries from the low key on
+ *
+ * Hash partitions are merged within the high key of the predicate
+ */
+void PartitionedIndex::ScanLimitRange(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ItemPointer *> &result,
+    const ConjunctionScanPredicate *csp_p, uint64_t limit, uint64_t offset) {
+  if (partition_type == IndexPartitionType::HASH) {
+    MergeScan(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p, limit);
+    return;
+  }
+
+  size_t result_size = result.size();
+  for (size_t partition_itr =
+           GetRangePartition(csp_p->GetLowKey()->GetValue(0));
+       partition_itr < partitions.size(); partition_itr++) {
+    uint64_t scanned_count = result.size() - result_size;
+    if (scanned_count >= limit) {
+      return;
+    }
+
+    partitions[partition_itr]->ScanLimitRange(
+        value_list, tuple_column_id_list, expr_list, scan_direction, result,
+        csp_p, limit - scanned_count, offset);
+  }
+}
+
+/*
+ * ScanAllKeys() - Returns all entries
+ *
+ * Only range partitions return them in key order
+ */
+void PartitionedIndex::ScanAllKeys(std::vector<ItemPointer *> &result) {
+  for (auto &partition : partitions) {
+    partition->ScanAllKeys(result);
+  }
+}
+
+void PartitionedIndex::ScanKey(const storage::Tuple *key,
+                               std::vector<ItemPointer *> &result) {
+  partitions[GetKeyPartition(key)]->ScanKey(key, result);
+}
+
+bool PartitionedIndex::ScanWithKeys(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ItemPointer *> &result,
+    std::vector<std::unique_ptr<storage::Tuple>> &key_result,
+    const ConjunctionScanPredicate *csp_p, type::AbstractPool *key_pool,
+    uint64_t limit) {
+  if (csp_p->IsPointQuery() == true) {
+    return partitions[GetKeyPartition(csp_p->GetPointQueryKey())]
+        ->ScanWithKeys(value_list, tuple_column_id_list, expr_list,
+                       scan_direction, result, key_result, csp_p, key_pool,
+                       limit);
+  }
+
+  if (partition_type == IndexPartitionType::HASH) {
+    return MergeScanWithKeys(value_list, tuple_column_id_list, expr_list,
+                             scan_direction, result, key_result, csp_p,
+                             key_pool, limit);
+  }
+
+  size_t result_size = result.size();
+  size_t first_partition, last_partition;
+  GetScanPartitions(csp_p, first_partition, last_partition);
+  for (size_t partition_itr = first_partition;
+       partition_itr <= last_partition; partition_itr++) {
+    uint64_t scanned_count = result.size() - result_size;
+    if (limit != 0 && scanned_count >= limit) {
+      break;
+    }
+
+    if (partitions[partition_itr]->ScanWithKeys(
+            value_list, tuple_column_id_list, expr_list, scan_direction,
+            result, key_result, csp_p, key_pool,
+            limit == 0 ? 0 : limit - scanned_count) == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////
+// Utilities
+///////////////////////////////////////////////////////////////////
+
+std::string PartitionedIndex::GetTypeName() const {
+  return "Partitioned" + partitions[0]->GetTypeName();
+}
+
+size_t PartitionedIndex::GetMemoryFootprint() {
+  size_t footprint = 0;
+  for (auto &partition : partitions) {
+    footprint += partition->GetMemoryFootprint();
+  }
+
+  return footprint;
+}
+
+bool PartitionedIndex::NeedGC() {
+  for (auto &partition : partitions) {
+    if (partition->NeedGC() == true) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void PartitionedIndex::PerformGC() {
+  for (auto &partition : partitions) {
+    partition->PerformGC();
+  }
+}
+
+}  // End index namespace
+}  // End peloton namespace
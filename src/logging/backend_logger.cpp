@@ -66,9 +66,6 @@ BackendLogger *BackendLogger::GetBackendLogger(LoggingType logging_type) {
  * @param log record
  */
 void BackendLogger::Log(LogRecord *record) {
-  // Enqueue the serialized log record into the queue
-  record->Serialize(output_buffer);
-
   this->log_buffer_lock.Lock();
   if (!log_buffer_) {
     LOG_TRACE("Acquire the first log buffer in backend logger");
@@ -95,26 +92,17 @@ void BackendLogger::Log(LogRecord *record) {
     max_log_id_buffer = cur_log_id;
   }
 
+  // Serialize the log record straight into the log buffer
   if (!log_buffer_->WriteRecord(record)) {
-    LOG_TRACE("Log buffer is full - Attempt to acquire a new one");
+    LOG_ERROR("Write record to log buffer failed");
+  }
+
+  if (log_buffer_->IsFull()) {
+    LOG_TRACE("Log buffer is full - the next record acquires a new one");
     // put back a buffer
     max_log_id_buffer = 0;  // reset
     persist_buffer_pool_->Put(std::move(log_buffer_));
-    this->log_buffer_lock.Unlock();
-
-    // get a new one
-    std::unique_ptr<LogBuffer> new_buff =
-        std::move(available_buffer_pool_->Get());
-    this->log_buffer_lock.Lock();
-    log_buffer_ = std::move(new_buff);
-
-    // write to the new log buffer
-    auto success = log_buffer_->WriteRecord(record);
-    if (!success) {
-      LOG_ERROR("Write record to log buffer failed");
-      this->log_buffer_lock.Unlock();
-      return;
-    }
+    handed_off_ = true;
   }
 
   this->log_buffer_lock.Unlock();
@@ -129,7 +117,9 @@ std::pair<cid_t, cid_t> BackendLogger::PrepareLogBuffers() {
   this->log_buffer_lock.Lock();
   std::pair<cid_t, cid_t> ret(INVALID_CID, INVALID_CID);
   // prepare the cid's seen so far
-  if (logging_cid_lower_bound != INVALID_CID ||
+  // a full buffer holding the last commit was handed off without a current
+  // buffer left behind, and the commit must still be reported
+  if (logging_cid_lower_bound != INVALID_CID || handed_off_ ||
       (log_buffer_ && log_buffer_->GetSize() > 0)) {
     ret.second = highest_logged_commit_message;
     if (logging_cid_lower_bound > highest_logged_commit_message) {
@@ -144,6 +134,7 @@ std::pair<cid_t, cid_t> BackendLogger::PrepareLogBuffers() {
         (int)highest_logged_commit_message, (int)logging_cid_lower_bound);
     persist_buffer_pool_->Put(std::move(log_buffer_));
   }
+  handed_off_ = false;
   this->log_buffer_lock.Unlock();
 
   auto num_log_buffer = persist_buffer_pool_->GetSize();
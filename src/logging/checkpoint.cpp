@@ -11,8 +11,13 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <dirent.h>
+#include <cstring>
+
 #include "logging/checkpoint.h"
 #include "logging/logging_util.h"
+#include "logging/checkpoint/fuzzy_checkpoint.h"
+#include "logging/checkpoint/image_checkpoint.h"
 #include "logging/checkpoint/simple_checkpoint.h"
 #include "logging/log_manager.h"
 #include "logging/checkpoint_manager.h"
@@ -96,12 +101,44 @@ void Checkpoint::InitDirectory() {
   }
 }
 
+void Checkpoint::InitVersionNumber() {
+  // Get checkpoint version
+  LOG_TRACE("Trying to read checkpoint directory");
+  struct dirent *file;
+  auto dirp = opendir(checkpoint_dir.c_str());
+  if (dirp == nullptr) {
+    LOG_TRACE("Opendir failed: Errno: %d, error: %s", errno, strerror(errno));
+    return;
+  }
+
+  while ((file = readdir(dirp)) != NULL) {
+    if (strncmp(file->d_name, FILE_PREFIX.c_str(), FILE_PREFIX.length()) == 0) {
+      // found a checkpoint file!
+      LOG_TRACE("Found a checkpoint file with name %s", file->d_name);
+      int version = LoggingUtil::ExtractNumberFromFileName(file->d_name);
+      if (version > checkpoint_version) {
+        checkpoint_version = version;
+      }
+    }
+  }
+  closedir(dirp);
+  LOG_TRACE("set checkpoint version to: %d", checkpoint_version);
+}
+
 std::unique_ptr<Checkpoint> Checkpoint::GetCheckpoint(
     CheckpointType checkpoint_type, bool disable_file_access) {
   if (checkpoint_type == CheckpointType::NORMAL) {
     std::unique_ptr<Checkpoint> checkpoint(
         new SimpleCheckpoint(disable_file_access));
     return std::move(checkpoint);
+  } else if (checkpoint_type == CheckpointType::FUZZY) {
+    std::unique_ptr<Checkpoint> checkpoint(
+        new FuzzyCheckpoint(disable_file_access));
+    return std::move(checkpoint);
+  } else if (checkpoint_type == CheckpointType::IMAGE) {
+    std::unique_ptr<Checkpoint> checkpoint(
+        new ImageCheckpoint(disable_file_access));
+    return std::move(checkpoint);
   }
   return std::move(std::unique_ptr<Checkpoint>(nullptr));
 }
@@ -0,0 +1,433 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fuzzy_checkpoint.cpp
+//
+// Identification: src/logging/checkpoint/fuzzy_checkpoint.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "logging/checkpoint/fuzzy_checkpoint.h"
+#include "logging/checkpoint_tile_scanner.h"
+#include "logging/checkpoint_manager.h"
+#include "logging/log_manager.h"
+#include "logging/logging_util.h"
+
+#include "catalog/catalog.h"
+#include "catalog/manager.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "common/logger.h"
+#include "storage/database.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+#include "type/serializeio.h"
+
+namespace peloton {
+namespace logging {
+
+// checkpointers enter their read-only epochs through local epochs of their
+// own, numbered from this id on, above the ids of the worker threads
+#define CHECKPOINT_EPOCH_THREAD_ID 0x40000000
+
+// how long a checkpoint waits for the log to be durable up to its
+// read-only epoch before it is skipped
+#define CHECKPOINT_FLUSH_WAIT_MS 1000
+
+static std::atomic<size_t> next_epoch_thread_id(CHECKPOINT_EPOCH_THREAD_ID);
+
+//===--------------------------------------------------------------------===//
+// Fuzzy Checkpoint
+//===--------------------------------------------------------------------===//
+
+FuzzyCheckpoint::FuzzyCheckpoint(bool disable_file_access)
+    : Checkpoint(disable_file_access),
+      checkpointed_tuple_count_(0),
+      epoch_thread_id_(next_epoch_thread_id++) {
+  InitDirectory();
+  InitVersionNumber();
+  concurrency::EpochManagerFactory::GetInstance().RegisterThread(
+      epoch_thread_id_);
+}
+
+FuzzyCheckpoint::~FuzzyCheckpoint() {
+  concurrency::EpochManagerFactory::GetInstance().DeregisterThread(
+      epoch_thread_id_);
+}
+
+void FuzzyCheckpoint::DoCheckpoint() {
+  // the read-only epoch keeps the gc from reclaiming the versions visible
+  // at its commit id, but not those of older snapshots. the snapshot is the
+  // older of the epoch and the durable commit id, so it is taken once the
+  // log caught up with the epoch, and the snapshot is the epoch's cid
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  cid_t epoch_cid = epoch_manager.EnterEpochRO(epoch_thread_id_);
+
+  cid_t snapshot_cid = std::min(epoch_cid, WaitForDurableCommitId(epoch_cid));
+  if (snapshot_cid == epoch_cid) {
+    TakeCheckpoint(snapshot_cid);
+  } else {
+    LOG_TRACE("Skip checkpoint, log is durable up to %lu only, epoch at %lu",
+              snapshot_cid, epoch_cid);
+  }
+
+  epoch_manager.ExitEpoch(epoch_thread_id_, epoch_cid);
+}
+
+// returns the commit id up to which the log is durable, once it reached the
+// given one or after CHECKPOINT_FLUSH_WAIT_MS. without logging, every commit
+// counts as durable
+cid_t FuzzyCheckpoint::WaitForDurableCommitId(cid_t commit_id) {
+  auto &log_manager = LogManager::GetInstance();
+  cid_t durable_cid = log_manager.GetGlobalMaxFlushedCommitId();
+  if (durable_cid == INVALID_CID) {
+    return commit_id;
+  }
+
+  for (size_t wait_ms = 0;
+       durable_cid < commit_id && wait_ms < CHECKPOINT_FLUSH_WAIT_MS;
+       wait_ms++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    durable_cid = log_manager.GetGlobalMaxFlushedCommitId();
+  }
+  return durable_cid;
+}
+
+void FuzzyCheckpoint::TakeCheckpoint(cid_t snapshot_cid) {
+  snapshot_cid_ = snapshot_cid;
+  checkpointed_tuple_count_ = 0;
+  LOG_TRACE("TakeCheckpoint cid = %lu", snapshot_cid_);
+
+  CreateFile();
+
+  CopySerializeOutput begin_output;
+  begin_output.ReserveBytes(sizeof(int32_t));
+  begin_output.WriteChar(FRAME_TYPE_BEGIN);
+  begin_output.WriteLong(snapshot_cid_);
+  WriteFrame(begin_output);
+
+  // Tile groups added from now on only hold versions of transactions that
+  // commit after the snapshot
+  std::vector<ScanTask> scan_tasks;
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database_count = catalog->GetDatabaseCount();
+
+  // loop all databases
+  for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
+    auto database = catalog->GetDatabaseWithOffset(database_idx);
+    auto table_count = database->GetTableCount();
+    auto database_oid = database->GetOid();
+
+    // loop all tables
+    for (oid_t table_idx = 0; table_idx < table_count; table_idx++) {
+      storage::DataTable *target_table = database->GetTable(table_idx);
+      PL_ASSERT(target_table);
+
+      auto tile_group_count = target_table->GetTileGroupCount();
+      for (oid_t tile_group_offset = START_OID;
+           tile_group_offset < tile_group_count; tile_group_offset++) {
+        scan_tasks.push_back({database_oid, target_table, tile_group_offset});
+      }
+    }
+  }
+
+  std::atomic<size_t> next_task_itr(0);
+  size_t scanner_count = std::min(scanner_count_, scan_tasks.size());
+  std::vector<std::thread> scanner_threads;
+  for (size_t scanner_itr = 1; scanner_itr < scanner_count; scanner_itr++) {
+    scanner_threads.emplace_back(&FuzzyCheckpoint::ScanTileGroups, this,
+                                 std::cref(scan_tasks), std::ref(next_task_itr));
+  }
+  ScanTileGroups(scan_tasks, next_task_itr);
+
+  for (auto &scanner_thread : scanner_threads) {
+    scanner_thread.join();
+  }
+
+  // The checkpoint is complete once the end frame is durable
+  CopySerializeOutput end_output;
+  end_output.ReserveBytes(sizeof(int32_t));
+  end_output.WriteChar(FRAME_TYPE_END);
+  end_output.WriteLong(snapshot_cid_);
+  WriteFrame(end_output);
+
+  Cleanup();
+  most_recent_checkpoint_cid = snapshot_cid_;
+}
+
+void FuzzyCheckpoint::ScanTileGroups(const std::vector<ScanTask> &scan_tasks,
+                                     std::atomic<size_t> &next_task_itr) {
+  CopySerializeOutput output;
+  size_t task_itr;
+  while ((task_itr = next_task_itr++) < scan_tasks.size()) {
+    output.Reset();
+    if (SerializeTileGroup(scan_tasks[task_itr], output) == 0) {
+      continue;
+    }
+    WriteFrame(output);
+  }
+}
+
+size_t FuzzyCheckpoint::SerializeTileGroup(const ScanTask &scan_task,
+                                           CopySerializeOutput &output) {
+  auto tile_group = scan_task.table->GetTileGroup(scan_task.tile_group_offset);
+  if (tile_group == nullptr) {
+    return 0;
+  }
+
+  auto tuple_slots = GetVisibleTupleSlots(tile_group.get());
+  if (tuple_slots.empty()) {
+    return 0;
+  }
+
+  auto schema = scan_task.table->GetSchema();
+  auto column_count = schema->GetColumnCount();
+
+  output.ReserveBytes(sizeof(int32_t));
+  output.WriteChar(FRAME_TYPE_TILE_GROUP);
+  output.WriteInt(scan_task.database_oid);
+  output.WriteInt(scan_task.table->GetOid());
+  output.WriteInt(tile_group->GetTileGroupId());
+  output.WriteInt(column_count);
+  output.WriteInt(tuple_slots.size());
+  for (auto tuple_slot : tuple_slots) {
+    output.WriteInt(tuple_slot);
+  }
+
+  // values are laid out column by column
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    for (auto tuple_slot : tuple_slots) {
+      tile_group->GetValue(tuple_slot, column_id).SerializeTo(output);
+    }
+  }
+
+  checkpointed_tuple_count_ += tuple_slots.size();
+  return tuple_slots.size();
+}
+
+std::vector<oid_t> FuzzyCheckpoint::GetVisibleTupleSlots(
+    storage::TileGroup *tile_group) {
+  auto tile_group_header = tile_group->GetHeader();
+
+  CheckpointTileScanner scanner;
+  std::vector<oid_t> tuple_slots;
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+  for (oid_t tuple_slot = 0; tuple_slot < active_tuple_count; tuple_slot++) {
+    if (scanner.IsVisible(tile_group_header, tuple_slot, snapshot_cid_)) {
+      tuple_slots.push_back(tuple_slot);
+    }
+  }
+  return tuple_slots;
+}
+
+cid_t FuzzyCheckpoint::DoRecovery() {
+  // No checkpoint to recover from
+  if (checkpoint_version < 0) {
+    return 0;
+  }
+  // we open checkpoint file in read + binary mode
+  std::string file_name = ConcatFileName(checkpoint_dir, checkpoint_version);
+  bool success =
+      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle_, "rb");
+  if (!success) {
+    return 0;
+  }
+  file_handle_.size = LoggingUtil::GetLogFileSize(file_handle_);
+
+  if (HasEndFrame() == false) {
+    LOG_ERROR("Incomplete checkpoint %s", file_name.c_str());
+    fclose(file_handle_.file);
+    return 0;
+  }
+
+  cid_t commit_id = 0;
+  bool should_stop = false;
+  while (!should_stop) {
+    auto frame = ReadFrame();
+    if (frame.empty()) {
+      LOG_ERROR("Torn checkpoint write.");
+      break;
+    }
+
+    CopySerializeInput input(frame.data(), frame.size());
+    input.ReadInt();
+    switch (input.ReadChar()) {
+      case FRAME_TYPE_BEGIN: {
+        commit_id = input.ReadLong();
+        snapshot_cid_ = commit_id;
+        break;
+      }
+      case FRAME_TYPE_TILE_GROUP: {
+        RecoverTileGroup(input);
+        break;
+      }
+      case FRAME_TYPE_END: {
+        should_stop = true;
+        break;
+      }
+      default: {
+        LOG_ERROR("Invalid checkpoint frame");
+        should_stop = true;
+        break;
+      }
+    }
+  }
+  fclose(file_handle_.file);
+
+  return FinishRecovery(commit_id);
+}
+
+cid_t FuzzyCheckpoint::FinishRecovery(cid_t commit_id) {
+  // After finishing recovery, set the next oid with maximum oid
+  // observed during the recovery
+  auto &manager = catalog::Manager::GetInstance();
+  if (max_oid_ > manager.GetNextTileGroupId()) {
+    manager.SetNextTileGroupId(max_oid_);
+  }
+
+  // FIXME this is not thread safe for concurrent checkpoint recovery
+  concurrency::TransactionManagerFactory::GetInstance().SetNextCid(commit_id);
+  CheckpointManager::GetInstance().SetRecoveredCid(commit_id);
+  return commit_id;
+}
+
+void FuzzyCheckpoint::RecoverTileGroup(CopySerializeInput &input) {
+  oid_t database_oid = input.ReadInt();
+  oid_t table_oid = input.ReadInt();
+  oid_t tile_group_id = input.ReadInt();
+  oid_t column_count = input.ReadInt();
+  size_t tuple_count = input.ReadInt();
+
+  storage::DataTable *table = nullptr;
+  try {
+    table = catalog::Catalog::GetInstance()->GetTableWithOid(database_oid,
+                                                             table_oid);
+  } catch (CatalogException &e) {
+    // the table was deleted
+    return;
+  }
+  auto schema = table->GetSchema();
+  PL_ASSERT(schema->GetColumnCount() == column_count);
+
+  std::vector<oid_t> tuple_slots(tuple_count);
+  for (auto &tuple_slot : tuple_slots) {
+    tuple_slot = input.ReadInt();
+  }
+
+  std::vector<std::unique_ptr<storage::Tuple>> tuples(tuple_count);
+  for (auto &tuple : tuples) {
+    tuple.reset(new storage::Tuple(schema, true));
+  }
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    auto column_type = schema->GetType(column_id);
+    for (auto &tuple : tuples) {
+      tuple->SetValue(column_id,
+                      type::Value::DeserializeFrom(input, column_type,
+                                                   pool.get()),
+                      pool.get());
+    }
+  }
+
+  for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    RecoverTuple(tuples[tuple_itr].get(), table,
+                 ItemPointer(tile_group_id, tuple_slots[tuple_itr]),
+                 snapshot_cid_);
+  }
+
+  if (max_oid_ < tile_group_id) {
+    max_oid_ = tile_group_id;
+  }
+  LOG_TRACE("Recovered %lu tuples of tile group %u", tuple_count,
+            tile_group_id);
+}
+
+// Private Functions
+void FuzzyCheckpoint::WriteFrame(CopySerializeOutput &output) {
+  output.WriteIntAt(0, static_cast<int32_t>(output.Size() - sizeof(int32_t)));
+  if (disable_file_access) return;
+
+  std::lock_guard<std::mutex> lock(file_mutex_);
+  size_t padding = (frame_alignment_ - ftell(file_handle_.file) %
+                    frame_alignment_) % frame_alignment_;
+  if (padding != 0) {
+    std::vector<char> zeros(padding, 0);
+    fwrite(zeros.data(), sizeof(char), padding, file_handle_.file);
+  }
+  fwrite(output.Data(), sizeof(char), output.Size(), file_handle_.file);
+}
+
+std::vector<char> FuzzyCheckpoint::ReadFrame() {
+  std::vector<char> frame;
+  size_t frame_size = LoggingUtil::GetNextFrameSize(file_handle_);
+  if (frame_size == 0) {
+    return frame;
+  }
+
+  frame.resize(frame_size);
+  if (fread(frame.data(), 1, frame_size, file_handle_.file) != frame_size) {
+    frame.clear();
+  }
+  return frame;
+}
+
+bool FuzzyCheckpoint::HasEndFrame() {
+  // the end frame holds its type and the snapshot cid
+  const size_t end_frame_size = sizeof(int32_t) + sizeof(char) + sizeof(cid_t);
+  if (file_handle_.size < end_frame_size) {
+    return false;
+  }
+
+  fseek(file_handle_.file, -static_cast<long>(end_frame_size), SEEK_END);
+  auto frame = ReadFrame();
+  fseek(file_handle_.file, 0, SEEK_SET);
+  if (frame.size() != end_frame_size) {
+    return false;
+  }
+
+  CopySerializeInput input(frame.data(), frame.size());
+  input.ReadInt();
+  return input.ReadChar() == FRAME_TYPE_END;
+}
+
+void FuzzyCheckpoint::CreateFile() {
+  if (disable_file_access) return;
+  // open checkpoint file and file descriptor
+  std::string file_name = ConcatFileName(checkpoint_dir, ++checkpoint_version);
+  bool success =
+      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle_, "wb");
+  if (!success) {
+    PL_ASSERT(false);
+    return;
+  }
+  LOG_TRACE("Created a new checkpoint file: %s", file_name.c_str());
+}
+
+void FuzzyCheckpoint::Cleanup() {
+  if (!disable_file_access) {
+    // Sync and close the current one
+    LoggingUtil::FFlushFsync(file_handle_);
+    fclose(file_handle_.file);
+
+    // Remove previous version
+    if (checkpoint_version > 0) {
+      auto previous_version =
+          ConcatFileName(checkpoint_dir, checkpoint_version - 1);
+      if (remove(previous_version.c_str()) != 0) {
+        LOG_TRACE("Failed to remove file %s", previous_version.c_str());
+      }
+    }
+  }
+  // Truncate logs
+  LogManager::GetInstance().TruncateLogs(snapshot_cid_);
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,347 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// image_checkpoint.cpp
+//
+// Identification: src/logging/checkpoint/image_checkpoint.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logging/checkpoint/image_checkpoint.h"
+
+#include "catalog/catalog.h"
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/serializeio.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Image Checkpoint
+//===--------------------------------------------------------------------===//
+
+ImageCheckpoint::ImageCheckpoint(bool disable_file_access)
+    : FuzzyCheckpoint(disable_file_access) {
+  frame_alignment_ = sysconf(_SC_PAGESIZE);
+}
+
+ImageCheckpoint::~ImageCheckpoint() {}
+
+size_t ImageCheckpoint::SerializeTileGroup(const ScanTask &scan_task,
+                                           CopySerializeOutput &output) {
+  auto tile_group = scan_task.table->GetTileGroup(scan_task.tile_group_offset);
+  if (tile_group == nullptr) {
+    return 0;
+  }
+
+  auto tuple_slots = GetVisibleTupleSlots(tile_group.get());
+  if (tuple_slots.empty()) {
+    return 0;
+  }
+
+  auto schema = scan_task.table->GetSchema();
+  oid_t tile_count = tile_group->GetTileCount();
+
+  output.ReserveBytes(sizeof(int32_t));
+  output.WriteChar(FRAME_TYPE_TILE_IMAGE);
+  output.WriteInt(scan_task.database_oid);
+  output.WriteInt(scan_task.table->GetOid());
+  output.WriteInt(tile_group->GetTileGroupId());
+  output.WriteInt(tuple_slots.size());
+  for (auto tuple_slot : tuple_slots) {
+    output.WriteInt(tuple_slot);
+  }
+
+  // the columns of every tile, in the order of the tile
+  std::vector<std::vector<oid_t>> tile_columns(tile_count);
+  for (auto &column_entry : tile_group->GetColumnMap()) {
+    auto &columns = tile_columns[column_entry.second.first];
+    if (columns.size() <= column_entry.second.second) {
+      columns.resize(column_entry.second.second + 1);
+    }
+    columns[column_entry.second.second] = column_entry.first;
+  }
+
+  output.WriteInt(tile_count);
+  std::vector<size_t> data_offset_positions(tile_count);
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    output.WriteInt(tile_columns[tile_itr].size());
+    for (auto column_id : tile_columns[tile_itr]) {
+      output.WriteInt(column_id);
+    }
+    output.WriteInt(tile_group->GetTile(tile_itr)->GetInlinedSize());
+    data_offset_positions[tile_itr] = output.ReserveBytes(sizeof(int32_t));
+  }
+
+  // uninlined values only point into the pools, they are written column by
+  // column and relocated on recovery
+  for (oid_t column_itr = 0; column_itr < schema->GetUninlinedColumnCount();
+       column_itr++) {
+    auto column_id = schema->GetUninlinedColumn(column_itr);
+    for (auto tuple_slot : tuple_slots) {
+      tile_group->GetValue(tuple_slot, column_id).SerializeTo(output);
+    }
+  }
+
+  // the inlined data of every tile starts at a page boundary of the file
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    output.WriteZeros((frame_alignment_ - output.Size() % frame_alignment_) %
+                      frame_alignment_);
+    output.WriteIntAt(data_offset_positions[tile_itr], output.Size());
+
+    auto tile = tile_group->GetTile(tile_itr);
+    output.WriteBytes(tile->GetTupleLocation(0), tile->GetInlinedSize());
+  }
+
+  checkpointed_tuple_count_ += tuple_slots.size();
+  return tuple_slots.size();
+}
+
+cid_t ImageCheckpoint::DoRecovery() {
+  mapped_tile_group_count_ = 0;
+
+  // No checkpoint to recover from
+  if (checkpoint_version < 0) {
+    return 0;
+  }
+  std::string file_name = ConcatFileName(checkpoint_dir, checkpoint_version);
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd == -1) {
+    LOG_ERROR("Failed to open checkpoint %s", file_name.c_str());
+    return 0;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    return 0;
+  }
+  size_t file_size = file_stat.st_size;
+
+  // pages of adopted tiles are copied on their first write
+  void *region = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      fd, 0);
+  close(fd);
+  if (region == MAP_FAILED) {
+    LOG_ERROR("Failed to map checkpoint %s", file_name.c_str());
+    return 0;
+  }
+  std::shared_ptr<void> mapped_region(
+      region, [file_size](void *region) { munmap(region, file_size); });
+  char *file_data = static_cast<char *>(region);
+
+  // the end frame holds its type and the snapshot cid
+  const size_t end_frame_size = sizeof(int32_t) + sizeof(char) + sizeof(cid_t);
+  if (file_size < end_frame_size ||
+      file_data[file_size - end_frame_size + sizeof(int32_t)] !=
+          FRAME_TYPE_END) {
+    LOG_ERROR("Incomplete checkpoint %s", file_name.c_str());
+    return 0;
+  }
+
+  cid_t commit_id = 0;
+  size_t frame_offset = 0;
+  bool should_stop = false;
+  while (!should_stop) {
+    if (frame_offset + sizeof(int32_t) > file_size) {
+      LOG_ERROR("Torn checkpoint write.");
+      break;
+    }
+    CopySerializeInput frame_header(file_data + frame_offset,
+                                    sizeof(int32_t));
+    size_t frame_size = frame_header.ReadInt() + sizeof(int32_t);
+    if (frame_offset + frame_size > file_size) {
+      LOG_ERROR("Torn checkpoint write.");
+      break;
+    }
+
+    char *frame = file_data + frame_offset;
+    CopySerializeInput input(frame, frame_size);
+    input.ReadInt();
+    switch (input.ReadChar()) {
+      case FRAME_TYPE_BEGIN: {
+        commit_id = input.ReadLong();
+        snapshot_cid_ = commit_id;
+        break;
+      }
+      case FRAME_TYPE_TILE_IMAGE: {
+        RecoverTileImage(input, frame, mapped_region);
+        break;
+      }
+      case FRAME_TYPE_END: {
+        should_stop = true;
+        break;
+      }
+      default: {
+        LOG_ERROR("Invalid checkpoint frame");
+        should_stop = true;
+        break;
+      }
+    }
+
+    // frames start at page boundaries
+    frame_offset += frame_size;
+    frame_offset += (frame_alignment_ - frame_offset % frame_alignment_) %
+                    frame_alignment_;
+  }
+
+  LOG_TRACE("Mapped %lu tile groups from checkpoint", mapped_tile_group_count_);
+  return FinishRecovery(commit_id);
+}
+
+void ImageCheckpoint::RecoverTileImage(
+    CopySerializeInput &input, char *frame,
+    const std::shared_ptr<void> &mapped_region) {
+  oid_t database_oid = input.ReadInt();
+  oid_t table_oid = input.ReadInt();
+  oid_t tile_group_id = input.ReadInt();
+  size_t tuple_count = input.ReadInt();
+  std::vector<oid_t> tuple_slots(tuple_count);
+  for (auto &tuple_slot : tuple_slots) {
+    tuple_slot = input.ReadInt();
+  }
+
+  oid_t tile_count = input.ReadInt();
+  std::vector<std::vector<oid_t>> tile_columns(tile_count);
+  std::vector<size_t> tile_sizes(tile_count);
+  std::vector<size_t> data_offsets(tile_count);
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    tile_columns[tile_itr].resize(input.ReadInt());
+    for (auto &column_id : tile_columns[tile_itr]) {
+      column_id = input.ReadInt();
+    }
+    tile_sizes[tile_itr] = input.ReadInt();
+    data_offsets[tile_itr] = input.ReadInt();
+  }
+
+  storage::DataTable *table = nullptr;
+  try {
+    table = catalog::Catalog::GetInstance()->GetTableWithOid(database_oid,
+                                                             table_oid);
+  } catch (CatalogException &e) {
+    // the table was deleted
+    return;
+  }
+  auto schema = table->GetSchema();
+
+  auto uninlined_column_count = schema->GetUninlinedColumnCount();
+  std::vector<std::vector<type::Value>> uninlined_values(
+      uninlined_column_count);
+  for (oid_t column_itr = 0; column_itr < uninlined_column_count;
+       column_itr++) {
+    auto column_type =
+        schema->GetType(schema->GetUninlinedColumn(column_itr));
+    for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      uninlined_values[column_itr].push_back(
+          type::Value::DeserializeFrom(input, column_type, pool.get()));
+    }
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    table->AddTileGroupWithOidForRecovery(tile_group_id);
+    tile_group = manager.GetTileGroup(tile_group_id);
+  }
+  if (max_oid_ < tile_group_id) {
+    max_oid_ = tile_group_id;
+  }
+
+  // The mapped data can only be adopted by an empty tile group of the same
+  // layout
+  bool same_layout = (tile_group->GetNextTupleSlot() == 0 &&
+                      tile_group->GetTileCount() == tile_count);
+  for (oid_t tile_itr = 0; same_layout && tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    same_layout = (tile->GetInlinedSize() == tile_sizes[tile_itr] &&
+                   tile->GetColumnCount() == tile_columns[tile_itr].size());
+    for (oid_t tile_column_itr = 0;
+         same_layout && tile_column_itr < tile_columns[tile_itr].size();
+         tile_column_itr++) {
+      oid_t tile_offset, tile_column_id;
+      tile_group->LocateTileAndColumn(tile_columns[tile_itr][tile_column_itr],
+                                      tile_offset, tile_column_id);
+      same_layout =
+          (tile_offset == tile_itr && tile_column_id == tile_column_itr);
+    }
+  }
+
+  if (same_layout) {
+    for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+      tile_group->GetTile(tile_itr)->AdoptMappedData(
+          frame + data_offsets[tile_itr], mapped_region);
+    }
+
+    // Set MVCC info, and move the uninlined values into the pools
+    auto tile_group_header = tile_group->GetHeader();
+    for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      auto tuple_slot = tuple_slots[tuple_itr];
+      tile_group_header->GetEmptyTupleSlot(tuple_slot);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetBeginCommitId(tuple_slot, snapshot_cid_);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetNextItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+
+      for (oid_t column_itr = 0; column_itr < uninlined_column_count;
+           column_itr++) {
+        tile_group->SetValue(uninlined_values[column_itr][tuple_itr],
+                             tuple_slot,
+                             schema->GetUninlinedColumn(column_itr));
+      }
+    }
+    table->IncreaseTupleCount(tuple_count);
+    mapped_tile_group_count_++;
+    return;
+  }
+
+  // Otherwise rebuild the tuples from the images of the tiles
+  std::vector<std::unique_ptr<catalog::Schema>> tile_schemas;
+  for (auto &columns : tile_columns) {
+    tile_schemas.emplace_back(catalog::Schema::CopySchema(schema, columns));
+  }
+
+  for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto tuple_slot = tuple_slots[tuple_itr];
+    storage::Tuple tuple(schema, true);
+    for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+      auto tile_schema = tile_schemas[tile_itr].get();
+      storage::Tuple tile_tuple(tile_schema,
+                                frame + data_offsets[tile_itr] +
+                                    tuple_slot * tile_schema->GetLength());
+      for (oid_t tile_column_itr = 0;
+           tile_column_itr < tile_columns[tile_itr].size();
+           tile_column_itr++) {
+        auto column_id = tile_columns[tile_itr][tile_column_itr];
+        if (schema->IsInlined(column_id)) {
+          tuple.SetValue(column_id, tile_tuple.GetValue(tile_column_itr),
+                         pool.get());
+        }
+      }
+    }
+    for (oid_t column_itr = 0; column_itr < uninlined_column_count;
+         column_itr++) {
+      tuple.SetValue(schema->GetUninlinedColumn(column_itr),
+                     uninlined_values[column_itr][tuple_itr], pool.get());
+    }
+
+    RecoverTuple(&tuple, table, ItemPointer(tile_group_id, tuple_slot),
+                 snapshot_cid_);
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
 #include <atomic>
 #include <xmmintrin.h>
 
@@ -25,50 +26,55 @@ namespace logging {
 //===--------------------------------------------------------------------===//
 CircularBufferPool::CircularBufferPool()
     : head_(ATOMIC_VAR_INIT(0)), tail_(ATOMIC_VAR_INIT(0)) {
-  PL_MEMSET(buffers_, 0, BUFFER_POOL_SIZE * sizeof(std::unique_ptr<LogBuffer>));
+  for (auto &buffer : buffers_) {
+    buffer.store(nullptr, std::memory_order_relaxed);
+  }
 }
 
 CircularBufferPool::~CircularBufferPool() {
-  for (unsigned int i = GET_BUFFER_POOL_INDEX(tail_);
-       i < GET_BUFFER_POOL_INDEX(head_); i++) {
-    buffers_[i].release();
+  for (auto &buffer : buffers_) {
+    delete buffer.exchange(nullptr);
   }
 }
 
 bool CircularBufferPool::Put(std::unique_ptr<LogBuffer> buffer) {
-  // assume enough place for put a buffer
   unsigned int current_idx = GET_BUFFER_POOL_INDEX(head_.fetch_add(1));
   LOG_TRACE("CircularBufferPool::Put - current_idx: %u", current_idx);
-  buffers_[current_idx] = std::move(buffer);
+
+  // wait for the slot to be drained if we wrapped around
+  LogBuffer *expected = nullptr;
+  while (!buffers_[current_idx].compare_exchange_weak(
+      expected, buffer.get(), std::memory_order_release,
+      std::memory_order_relaxed)) {
+    expected = nullptr;
+    _mm_pause();
+  }
+  buffer.release();
   return true;
 }
 
 std::unique_ptr<LogBuffer> CircularBufferPool::Get() {
   unsigned int current_idx = GET_BUFFER_POOL_INDEX(tail_.fetch_add(1));
-  while (true) {
-    if (buffers_[current_idx]) {
-      break;
-    } else {
-      // pause for a minimum amount of time
-      _mm_pause();
-    }
+  LogBuffer *buffer;
+  while ((buffer = buffers_[current_idx].exchange(
+              nullptr, std::memory_order_acquire)) == nullptr) {
+    // pause for a minimum amount of time
+    _mm_pause();
   }
   LOG_TRACE("CircularBufferPool::Get - current_idx: %u", current_idx);
-  std::unique_ptr<LogBuffer> buff = std::move(buffers_[current_idx]);
-  PL_MEMSET(buffers_ + current_idx, 0, sizeof(std::unique_ptr<LogBuffer>));
-  return buff;
+  return std::unique_ptr<LogBuffer>(buffer);
 }
 
 unsigned int CircularBufferPool::GetSize() {
-  auto head = head_.load();
   auto tail = tail_.load();
+  auto head = head_.load();
 
-  // get the offset of head and tail
-  int size = GET_BUFFER_POOL_INDEX(head) - GET_BUFFER_POOL_INDEX(tail);
-  if (size == 0 && head - tail > 0) {
-    return BUFFER_POOL_SIZE;
+  // a waiting Get may have claimed a slot before it was filled
+  int size = static_cast<int>(head - tail);
+  if (size <= 0) {
+    return 0;
   }
-  return (size + BUFFER_POOL_SIZE) % BUFFER_POOL_SIZE;
+  return std::min<unsigned int>(size, BUFFER_POOL_SIZE);
 }
 
 }  // namespace logging
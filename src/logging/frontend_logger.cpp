@@ -290,5 +290,21 @@ void FrontendLogger::AddBackendLogger(BackendLogger *backend_logger) {
   backend_loggers_lock.Unlock();
 }
 
+/**
+ * @brief Move the commit latencies recorded by the backend loggers
+ * @param commit_latencies the latencies are appended to
+ */
+void FrontendLogger::CollectCommitLatencies(
+    std::vector<uint64_t> &commit_latencies) {
+  backend_loggers_lock.Lock();
+  for (auto backend_logger : backend_loggers) {
+    auto &latencies = backend_logger->GetCommitLatencies();
+    commit_latencies.insert(commit_latencies.end(), latencies.begin(),
+                            latencies.end());
+    latencies.clear();
+  }
+  backend_loggers_lock.Unlock();
+}
+
 }  // namespace logging
 }
@@ -16,6 +16,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 
+#include <algorithm>
 #include <cstring>
 
 namespace peloton {
@@ -27,33 +28,35 @@ namespace logging {
 LogBuffer::LogBuffer(BackendLogger *backend_logger)
     : backend_logger_(backend_logger) {
   capacity_ = LogManager::GetInstance().GetLogBufferCapacity();
+  threshold_ = capacity_;
   elastic_data_.reset(new char[capacity_]);
 }
 
 bool LogBuffer::WriteRecord(LogRecord *record) {
-  bool success = WriteData(record->GetMessage(), record->GetMessageLength());
+  Output output(*this);
+  bool success = record->SerializeTo(output);
+  PL_ASSERT(output.Size() > size_);
+  size_ = output.Size();
   return success;
 }
 
 void LogBuffer::ResetData() { size_ = 0; }
 
 // Internal Methods
-bool LogBuffer::WriteData(char *data, size_t len) {
-  // Not enough space
-  while (len + size_ > capacity_) {
-    if (size_ == 0) {
-      // double log buffer capacity for empty buffer
-      capacity_ *= 2;
-      elastic_data_.reset(new char[capacity_]);
-    } else {
-      return false;
-    }
+void LogBuffer::Output::expand(size_t minimum_desired) {
+  // double the capacity until the record fits, keeping what was written
+  size_t capacity = std::max<size_t>(log_buffer_.capacity_, 1);
+  while (capacity < minimum_desired) {
+    capacity *= 2;
   }
-  PL_ASSERT(data);
-  PL_ASSERT(len);
-  PL_MEMCPY(elastic_data_.get() + size_, data, len);
-  size_ += len;
-  return true;
+  LOG_TRACE("Grow log buffer from %lu to %lu bytes", log_buffer_.capacity_,
+            capacity);
+
+  std::unique_ptr<char[]> data(new char[capacity]);
+  PL_MEMCPY(data.get(), log_buffer_.elastic_data_.get(), Position());
+  log_buffer_.elastic_data_ = std::move(data);
+  log_buffer_.capacity_ = capacity;
+  initialize(log_buffer_.elastic_data_.get(), capacity);
 }
 
 }  // namespace logging
@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_compression.cpp
+//
+// Identification: src/logging/log_compression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <algorithm>
+#include <limits>
+
+#ifdef PELOTON_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef PELOTON_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "logging/log_compression.h"
+
+namespace peloton {
+namespace logging {
+
+bool LogCompression::IsSupported(LogCompressionType compression_type) {
+  switch (compression_type) {
+    case LogCompressionType::NONE:
+      return true;
+#ifdef PELOTON_HAVE_LZ4
+    case LogCompressionType::LZ4:
+      return true;
+#endif
+#ifdef PELOTON_HAVE_ZSTD
+    case LogCompressionType::ZSTD:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+size_t LogCompression::Compress(LogCompressionType compression_type,
+                                UNUSED_ATTRIBUTE int level, const char *data,
+                                size_t length, std::vector<char> &output) {
+  if (length > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return 0;
+  }
+
+  switch (compression_type) {
+#ifdef PELOTON_HAVE_LZ4
+    case LogCompressionType::LZ4: {
+      output.resize(LZ4_compressBound(static_cast<int>(length)));
+      // the level is the acceleration of lz4, higher is faster
+      int compressed_length = LZ4_compress_fast(
+          data, output.data(), static_cast<int>(length),
+          static_cast<int>(output.size()), std::max(level, 1));
+      if (compressed_length <= 0) {
+        LOG_ERROR("LZ4 failed to compress %lu bytes", length);
+        return 0;
+      }
+      return compressed_length;
+    }
+#endif
+
+#ifdef PELOTON_HAVE_ZSTD
+    case LogCompressionType::ZSTD: {
+      output.resize(ZSTD_compressBound(length));
+      size_t compressed_length =
+          ZSTD_compress(output.data(), output.size(), data, length, level);
+      if (ZSTD_isError(compressed_length)) {
+        LOG_ERROR("Zstd failed to compress %lu bytes : %s", length,
+                  ZSTD_getErrorName(compressed_length));
+        return 0;
+      }
+      return compressed_length;
+    }
+#endif
+
+    default: {
+      LOG_ERROR("Unsupported log compression type %s",
+                LogCompressionTypeToString(compression_type).c_str());
+      return 0;
+    }
+  }
+}
+
+bool LogCompression::Decompress(LogCompressionType compression_type,
+                                const char *data, size_t length, char *output,
+                                size_t raw_length) {
+  switch (compression_type) {
+#ifdef PELOTON_HAVE_LZ4
+    case LogCompressionType::LZ4: {
+      int decompressed_length =
+          LZ4_decompress_safe(data, output, static_cast<int>(length),
+                              static_cast<int>(raw_length));
+      return decompressed_length == static_cast<int>(raw_length);
+    }
+#endif
+
+#ifdef PELOTON_HAVE_ZSTD
+    case LogCompressionType::ZSTD: {
+      size_t decompressed_length =
+          ZSTD_decompress(output, raw_length, data, length);
+      return !ZSTD_isError(decompressed_length) &&
+             decompressed_length == raw_length;
+    }
+#endif
+
+    default: {
+      LOG_ERROR("Unsupported log compression type %d",
+                static_cast<int>(compression_type));
+      return false;
+    }
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 
@@ -21,7 +22,10 @@
 #include "executor/executor_context.h"
 #include "logging/log_manager.h"
 #include "logging/logging_util.h"
+#include "logging/replication/logging_service.h"
+#include "logging/replication/replication_sender.h"
 #include "logging/records/transaction_record.h"
+#include "logging/records/tuple_record.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
@@ -175,7 +179,8 @@ void LogManager::LogBeginTransaction(cid_t commit_id) {
 }
 
 void LogManager::LogUpdate(cid_t commit_id, const ItemPointer &old_version,
-                           const ItemPointer &new_version) {
+                           const ItemPointer &new_version,
+                           const std::vector<oid_t> *updated_columns) {
   if (this->IsInLoggingMode()) {
     auto &manager = catalog::Manager::GetInstance();
     auto catalog = catalog::Catalog::GetInstance();
@@ -184,7 +189,6 @@ void LogManager::LogUpdate(cid_t commit_id, const ItemPointer &old_version,
 
     auto logger = this->GetBackendLogger();
 
-    std::unique_ptr<LogRecord> record;
     std::unique_ptr<storage::Tuple> tuple;
     auto schema = catalog
                       ->GetTableWithOid(new_tuple_tile_group->GetDatabaseId(),
@@ -193,26 +197,42 @@ void LogManager::LogUpdate(cid_t commit_id, const ItemPointer &old_version,
     // Can we avoid allocate tuple in head each time?
     if (LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_) ||
         replicating_) {
+      // log only the changed columns if we know them
+      bool is_delta = (updated_columns != nullptr &&
+                       updated_columns->size() < schema->GetColumnCount());
+
       tuple.reset(new storage::Tuple(schema, true));
-      for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
-        type::Value val =
-            (new_tuple_tile_group->GetValue(new_version.offset, col));
-        tuple->SetValue(col, val, logger->GetVarlenPool());
+      if (is_delta) {
+        for (auto col : *updated_columns) {
+          type::Value val =
+              (new_tuple_tile_group->GetValue(new_version.offset, col));
+          tuple->SetValue(col, val, logger->GetVarlenPool());
+        }
+      } else {
+        for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
+          type::Value val =
+              (new_tuple_tile_group->GetValue(new_version.offset, col));
+          tuple->SetValue(col, val, logger->GetVarlenPool());
+        }
+      }
+      TupleRecord record(
+          logger->GetTupleRecordType(is_delta
+                                         ? LOGRECORD_TYPE_TUPLE_DELTA_UPDATE
+                                         : LOGRECORD_TYPE_TUPLE_UPDATE),
+          commit_id, new_tuple_tile_group->GetTableId(), new_version,
+          old_version, tuple.get(), new_tuple_tile_group->GetDatabaseId());
+      if (is_delta) {
+        record.SetColumnIds(*updated_columns);
       }
-      record.reset(
-          logger->GetTupleRecord(LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
-                                 new_tuple_tile_group->GetTableId(),
-                                 new_tuple_tile_group->GetDatabaseId(),
-                                 new_version, old_version, tuple.get()));
+      logger->Log(&record);
     } else {
       // if wbl without replication, do not include tuple data
-      record.reset(logger->GetTupleRecord(
-          LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
-          new_tuple_tile_group->GetTableId(),
-          new_tuple_tile_group->GetDatabaseId(), new_version, old_version));
+      TupleRecord record(
+          logger->GetTupleRecordType(LOGRECORD_TYPE_TUPLE_UPDATE), commit_id,
+          new_tuple_tile_group->GetTableId(), new_version, old_version,
+          nullptr, new_tuple_tile_group->GetDatabaseId());
+      logger->Log(&record);
     }
-
-    logger->Log(record.get());
   }
 }
 
@@ -225,7 +245,6 @@ void LogManager::LogInsert(cid_t commit_id, const ItemPointer &new_location) {
     auto new_tuple_tile_group = manager.GetTileGroup(new_location.block);
 
     auto tile_group = manager.GetTileGroup(new_location.block);
-    std::unique_ptr<LogRecord> record;
     std::unique_ptr<storage::Tuple> tuple;
     if (LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_)) {
       auto schema = catalog
@@ -238,20 +257,14 @@ void LogManager::LogInsert(cid_t commit_id, const ItemPointer &new_location) {
             (new_tuple_tile_group->GetValue(new_location.offset, col));
         tuple->SetValue(col, val, logger->GetVarlenPool());
       }
-
-      record.reset(logger->GetTupleRecord(
-          LOGRECORD_TYPE_TUPLE_INSERT, commit_id, tile_group->GetTableId(),
-          new_tuple_tile_group->GetDatabaseId(), new_location,
-          INVALID_ITEMPOINTER, tuple.get()));
-
-    } else {
-      // do not construct the tuple for the wbl case
-      record.reset(logger->GetTupleRecord(LOGRECORD_TYPE_TUPLE_INSERT,
-                                          commit_id, tile_group->GetTableId(),
-                                          new_tuple_tile_group->GetDatabaseId(),
-                                          new_location, INVALID_ITEMPOINTER));
     }
-    logger->Log(record.get());
+
+    // the tuple is not constructed for the wbl case
+    TupleRecord record(logger->GetTupleRecordType(LOGRECORD_TYPE_TUPLE_INSERT),
+                       commit_id, tile_group->GetTableId(), new_location,
+                       INVALID_ITEMPOINTER, tuple.get(),
+                       new_tuple_tile_group->GetDatabaseId());
+    logger->Log(&record);
   }
 }
 
@@ -262,22 +275,33 @@ void LogManager::LogDelete(cid_t commit_id,
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(delete_location.block);
 
-    std::unique_ptr<LogRecord> record(logger->GetTupleRecord(
-        LOGRECORD_TYPE_TUPLE_DELETE, commit_id, tile_group->GetTableId(),
-        tile_group->GetDatabaseId(), INVALID_ITEMPOINTER, delete_location));
+    TupleRecord record(logger->GetTupleRecordType(LOGRECORD_TYPE_TUPLE_DELETE),
+                       commit_id, tile_group->GetTableId(), INVALID_ITEMPOINTER,
+                       delete_location, nullptr, tile_group->GetDatabaseId());
 
-    logger->Log(record.get());
+    logger->Log(&record);
   }
 }
 
 void LogManager::LogCommitTransaction(cid_t commit_id) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
+    std::chrono::steady_clock::time_point start;
+    if (commit_latency_tracking_) {
+      start = std::chrono::steady_clock::now();
+    }
+
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
     logger->Log(&record);
     if (syncronization_commit) {
       WaitForFlush(commit_id);
     }
+
+    if (commit_latency_tracking_) {
+      logger->RecordCommitLatency(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start).count());
+    }
     // logger->GetVarlenPool()->Purge();
   }
 }
@@ -439,6 +463,60 @@ void LogManager::TruncateLogs(txn_id_t commit_id) {
   }
 }
 
+void LogManager::SetLogCompression(LogCompressionType compression_type,
+                                   int level) {
+  if (!LogCompression::IsSupported(compression_type)) {
+    LOG_ERROR("Log compression type %s is not supported, logging uncompressed",
+              LogCompressionTypeToString(compression_type).c_str());
+    compression_type = LogCompressionType::NONE;
+  }
+  log_compression_type_ = compression_type;
+  log_compression_level_ = level;
+}
+
+LogCompressionStats LogManager::GetLogCompressionStats() {
+  LogCompressionStats total_stats;
+
+  if (!LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_)) {
+    return total_stats;
+  }
+
+  for (auto &frontend_logger : frontend_loggers) {
+    auto &stats = reinterpret_cast<WriteAheadFrontendLogger *>(
+                      frontend_logger.get())->GetCompressionStats();
+    total_stats.buffer_count += stats.buffer_count;
+    total_stats.block_count += stats.block_count;
+    total_stats.raw_bytes += stats.raw_bytes;
+    total_stats.written_bytes += stats.written_bytes;
+    total_stats.compression_time_us += stats.compression_time_us;
+  }
+  return total_stats;
+}
+
+std::vector<uint64_t> LogManager::CollectCommitLatencies() {
+  std::vector<uint64_t> commit_latencies;
+  for (auto &frontend_logger : frontend_loggers) {
+    frontend_logger->CollectCommitLatencies(commit_latencies);
+  }
+  return commit_latencies;
+}
+
+size_t LogManager::GetFsyncCount() {
+  size_t fsync_count = 0;
+  for (auto &frontend_logger : frontend_loggers) {
+    fsync_count += frontend_logger->GetFsyncCount();
+  }
+  return fsync_count;
+}
+
+size_t LogManager::GetLoggedBytes() {
+  size_t logged_bytes = 0;
+  for (auto &frontend_logger : frontend_loggers) {
+    logged_bytes += frontend_logger->GetLoggedBytes();
+  }
+  return logged_bytes;
+}
+
 cid_t LogManager::GetGlobalMaxFlushedCommitId() {
   return global_max_flushed_commit_id;
 }
@@ -495,6 +573,32 @@ void LogManager::WaitForFlush(cid_t cid) {
         "Flushes done! Can return! Got persistent flushed commit id as %d",
         (int)this->GetPersistentFlushedCommitId());
   }
+
+  // the standby has the commit as well
+  if (replication_sender_ != nullptr &&
+      replication_sender_->GetReplicationType() != ASYNC_REPLICATION) {
+    replication_sender_->WaitForAcknowledgement(cid);
+  }
+}
+
+bool LogManager::SetReplication(const std::string &standby_address,
+                                ReplicationType replication_type,
+                                int local_port) {
+  if (LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_) == false ||
+      num_frontend_loggers_ != 1) {
+    LOG_ERROR("Replication needs a single write ahead frontend logger");
+    return false;
+  }
+
+  // the connection to the standby is created on the event base of the server
+  if (LoggingService::StartServer(local_port) == false) {
+    return false;
+  }
+
+  replication_sender_.reset(
+      new ReplicationSender(standby_address, replication_type));
+  replicating_ = true;
+  return true;
 }
 
 void LogManager::NotifyRecoveryDone() {
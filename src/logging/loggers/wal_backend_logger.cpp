@@ -34,33 +34,33 @@ LogRecord *WriteAheadBackendLogger::GetTupleRecord(
     oid_t db_oid, ItemPointer insert_location, ItemPointer delete_location,
     const void *data) {
   // Build the log record
+  LogRecord *record = new TupleRecord(GetTupleRecordType(log_record_type),
+                                      txn_id, table_oid, insert_location,
+                                      delete_location, data, db_oid);
+
+  return record;
+}
+
+LogRecordType WriteAheadBackendLogger::GetTupleRecordType(
+    LogRecordType log_record_type) {
   switch (log_record_type) {
-    case LOGRECORD_TYPE_TUPLE_INSERT: {
-      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_INSERT;
-      break;
-    }
+    case LOGRECORD_TYPE_TUPLE_INSERT:
+      return LOGRECORD_TYPE_WAL_TUPLE_INSERT;
 
-    case LOGRECORD_TYPE_TUPLE_DELETE: {
-      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_DELETE;
-      break;
-    }
+    case LOGRECORD_TYPE_TUPLE_DELETE:
+      return LOGRECORD_TYPE_WAL_TUPLE_DELETE;
 
-    case LOGRECORD_TYPE_TUPLE_UPDATE: {
-      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_UPDATE;
-      break;
-    }
+    case LOGRECORD_TYPE_TUPLE_UPDATE:
+      return LOGRECORD_TYPE_WAL_TUPLE_UPDATE;
+
+    case LOGRECORD_TYPE_TUPLE_DELTA_UPDATE:
+      return LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE;
 
     default: {
       PL_ASSERT(false);
-      break;
+      return log_record_type;
     }
   }
-
-  LogRecord *record =
-      new TupleRecord(log_record_type, txn_id, table_oid, insert_location,
-                      delete_location, data, db_oid);
-
-  return record;
 }
 
 }  // namespace logging
@@ -14,6 +14,7 @@
 #include <sys/types.h>
 #include <sys/mman.h>
 #include <algorithm>
+#include <atomic>
 #include <dirent.h>
 #include <numeric>
 
@@ -21,9 +22,11 @@
 #include "catalog/manager.h"
 #include "catalog/schema.h"
 #include "type/ephemeral_pool.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "concurrency/transaction_manager.h"
+#include "gc/gc_manager_factory.h"
 
 #include "logging/log_manager.h"
 #include "logging/records/transaction_record.h"
@@ -33,6 +36,7 @@
 #include "logging/checkpoint_tile_scanner.h"
 #include "logging/logging_util.h"
 #include "logging/checkpoint_manager.h"
+#include "logging/replication/replication_sender.h"
 
 #include "storage/database.h"
 #include "storage/data_table.h"
@@ -97,6 +101,9 @@ void WriteAheadFrontendLogger::InitSelf() {
  * @brief close logfile
  */
 WriteAheadFrontendLogger::~WriteAheadFrontendLogger() {
+  // wait for the last sync before closing the log file
+  StopSyncThread();
+
   // close the log file
   if (cur_file_handle.file != nullptr) {
     int ret = fclose(cur_file_handle.file);
@@ -115,12 +122,13 @@ WriteAheadFrontendLogger::~WriteAheadFrontendLogger() {
  */
 void WriteAheadFrontendLogger::FlushLogRecords(void) {
   size_t global_queue_size = global_queue.size();
+  auto replication_sender = LogManager::GetInstance().GetReplicationSender();
 
   bool will_write_to_file;
 
   // check if we will end up writing something to disk
-  will_write_to_file =
-      ((max_collected_commit_id != max_flushed_commit_id) || global_queue_size);
+  will_write_to_file = ((max_collected_commit_id != GetMaxSubmittedCommitId()) ||
+                        global_queue_size);
 
   if (will_write_to_file) {
     if (cur_file_handle.fd == -1) {
@@ -141,8 +149,13 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
     auto &log_buffer = global_queue[global_queue_itr];
 
     if (!test_mode_ && !no_write_) {
-      fwrite(log_buffer->GetData(), sizeof(char), log_buffer->GetSize(),
-             cur_file_handle.file);
+      WriteLogBuffer(log_buffer.get());
+    }
+
+    // the standby gets the records as they were logged
+    if (replication_sender != nullptr) {
+      replication_block_.insert(replication_block_.end(), log_buffer->GetData(),
+                                log_buffer->GetData() + log_buffer->GetSize());
     }
 
     LOG_TRACE("Log buffer get max log id returned %d",
@@ -161,30 +174,37 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 
   bool flushed = false;
 
-  if (max_collected_commit_id != max_flushed_commit_id) {
+  if (max_collected_commit_id != GetMaxSubmittedCommitId()) {
     if (!test_mode_) {
       PL_ASSERT(cur_file_handle.fd != -1);
       if (cur_file_handle.fd != -1) {
         if (!no_write_) {
           fwrite(delimiter_rec.GetMessage(), sizeof(char),
                  delimiter_rec.GetMessageLength(), cur_file_handle.file);
+          logged_bytes += delimiter_rec.GetMessageLength();
         }
         LOG_TRACE("Wrote delimiter to log file with commit_id %ld",
                   this->max_collected_commit_id);
 
         // by moving the fflush and sync here, we ensure that this file will
         // have at least 1 delimiter
-        if (Clock::now() > last_flush + flush_frequency) {
-          if (!no_write_) {
-            LoggingUtil::FFlushFsync(cur_file_handle);
+        if (IsFlushDue()) {
+          if (IsSyncPipelined()) {
+            // the sync thread signals the waiting backends once it is done
+            fflush(cur_file_handle.file);
+            RequestSync(this->max_collected_commit_id);
+          } else {
+            if (!no_write_) {
+              LoggingUtil::FFlushFsync(cur_file_handle);
+            }
+            if (this->max_collected_commit_id > max_flushed_commit_id) {
+              max_flushed_commit_id = this->max_collected_commit_id;
+            }
+
+            fsync_count++;
+            flushed = true;
           }
           last_flush = Clock::now();
-          if (this->max_collected_commit_id > max_flushed_commit_id) {
-            max_flushed_commit_id = this->max_collected_commit_id;
-          }
-
-          fsync_count++;
-          flushed = true;
         }
 
         if (this->max_collected_commit_id > max_delimiter_file) {
@@ -195,7 +215,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
         if (FileSwitchCondIsTrue()) should_create_new_file = true;
       }
     } else {
-      if (Clock::now() > last_flush + flush_frequency) {
+      if (IsFlushDue()) {
         last_flush = Clock::now();
         if (this->max_collected_commit_id > max_flushed_commit_id) {
           max_flushed_commit_id = this->max_collected_commit_id;
@@ -214,6 +234,195 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
     // signal that we have flushed
     LogManager::GetInstance().FrontendLoggerFlushed();
   }
+
+  if (replication_sender != nullptr) {
+    ShipReplicationBlock(replication_sender);
+  }
+}
+
+/**
+ * @brief Send the records collected so far to the standby, as a block that
+ * covers the commits up to the max collected commit id. The block is held
+ * back until these commits are durable, so the standby never gets ahead of
+ * the log of the primary.
+ */
+void WriteAheadFrontendLogger::ShipReplicationBlock(
+    ReplicationSender *replication_sender) {
+  if (max_collected_commit_id > replication_block_commit_id_) {
+    replication_block_commit_id_ = max_collected_commit_id;
+  }
+
+  if (replication_block_.empty() &&
+      replication_block_commit_id_ == shipped_commit_id_) {
+    return;
+  }
+
+  if (max_flushed_commit_id < replication_block_commit_id_) {
+    return;
+  }
+
+  replication_sender->SendBlock(replication_block_.data(),
+                                replication_block_.size(),
+                                replication_block_commit_id_);
+  shipped_commit_id_ = replication_block_commit_id_;
+  replication_block_.clear();
+}
+
+/**
+ * @brief Write the records of a log buffer to the log file. With log
+ * compression enabled they are written as a compressed block, unless the
+ * codec fails or does not shrink them.
+ */
+void WriteAheadFrontendLogger::WriteLogBuffer(LogBuffer *log_buffer) {
+  auto &log_manager = LogManager::GetInstance();
+  auto compression_type = log_manager.GetLogCompressionType();
+  size_t raw_length = log_buffer->GetSize();
+
+  if (compression_type == LogCompressionType::NONE) {
+    fwrite(log_buffer->GetData(), sizeof(char), raw_length,
+           cur_file_handle.file);
+    logged_bytes += raw_length;
+    return;
+  }
+
+  auto start = Clock::now();
+  size_t compressed_length = LogCompression::Compress(
+      compression_type, log_manager.GetLogCompressionLevel(),
+      log_buffer->GetData(), raw_length, compression_buffer_);
+  compression_stats_.compression_time_us +=
+      std::chrono::duration_cast<Micros>(Clock::now() - start).count();
+  compression_stats_.buffer_count++;
+  compression_stats_.raw_bytes += raw_length;
+
+  size_t block_length = sizeof(char) + sizeof(int32_t) +
+                        LogCompression::GetBlockHeaderSize() +
+                        compressed_length;
+  if (compressed_length == 0 || block_length >= raw_length) {
+    fwrite(log_buffer->GetData(), sizeof(char), raw_length,
+           cur_file_handle.file);
+    compression_stats_.written_bytes += raw_length;
+    logged_bytes += raw_length;
+    return;
+  }
+
+  CopySerializeOutput block_header;
+  block_header.WriteEnumInSingleByte(LOGRECORD_TYPE_COMPRESSED_BLOCK);
+  block_header.WriteInt(static_cast<int32_t>(
+      LogCompression::GetBlockHeaderSize() + compressed_length));
+  block_header.WriteByte(static_cast<int8_t>(compression_type));
+  block_header.WriteInt(static_cast<int32_t>(raw_length));
+  block_header.WriteLong(log_buffer->GetMaxLogId());
+
+  fwrite(block_header.Data(), sizeof(char), block_header.Size(),
+         cur_file_handle.file);
+  fwrite(compression_buffer_.data(), sizeof(char), compressed_length,
+         cur_file_handle.file);
+
+  compression_stats_.block_count++;
+  compression_stats_.written_bytes += block_length;
+  logged_bytes += block_length;
+}
+
+/**
+ * @brief Decide whether to fsync the collected records now. With epoch group
+ * commit, all commits of an epoch share a single flush that is issued once
+ * the epoch has ended.
+ */
+bool WriteAheadFrontendLogger::IsFlushDue() {
+  if (LogManager::GetInstance().GetEpochGroupCommit() == false) {
+    return Clock::now() > last_flush + flush_frequency;
+  }
+
+  uint64_t current_epoch_id =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+  if (current_epoch_id <= last_flush_epoch_) {
+    return false;
+  }
+  last_flush_epoch_ = current_epoch_id;
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Pipelined Sync
+//===--------------------------------------------------------------------===//
+
+void WriteAheadFrontendLogger::StartSyncThread() {
+  if (IsSyncPipelined() == true) {
+    return;
+  }
+
+  sync_shutdown_ = false;
+  max_submitted_commit_id_ = max_flushed_commit_id;
+  sync_requested_commit_id_ = max_flushed_commit_id;
+  synced_commit_id_ = max_flushed_commit_id;
+  sync_thread_ = std::thread(&WriteAheadFrontendLogger::SyncLoop, this);
+}
+
+void WriteAheadFrontendLogger::StopSyncThread() {
+  if (IsSyncPipelined() == false) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> sync_lock(sync_mutex_);
+    sync_shutdown_ = true;
+  }
+  sync_cv_.notify_all();
+  sync_thread_.join();
+}
+
+void WriteAheadFrontendLogger::RequestSync(cid_t commit_id) {
+  {
+    std::lock_guard<std::mutex> sync_lock(sync_mutex_);
+    sync_fd_ = cur_file_handle.fd;
+    sync_requested_commit_id_ = commit_id;
+  }
+  max_submitted_commit_id_ = commit_id;
+  sync_cv_.notify_all();
+}
+
+void WriteAheadFrontendLogger::WaitForSync() {
+  std::unique_lock<std::mutex> sync_lock(sync_mutex_);
+  sync_cv_.wait(sync_lock, [this] {
+    return synced_commit_id_ == sync_requested_commit_id_;
+  });
+}
+
+/**
+ * @brief Sync the log file whenever the frontend logger requests it. Syncs
+ * requested while one is in flight are coalesced into the next one.
+ */
+void WriteAheadFrontendLogger::SyncLoop() {
+  std::unique_lock<std::mutex> sync_lock(sync_mutex_);
+  while (true) {
+    sync_cv_.wait(sync_lock, [this] {
+      return sync_shutdown_ ||
+             synced_commit_id_ != sync_requested_commit_id_;
+    });
+    // drain the pending sync before shutting down
+    if (synced_commit_id_ == sync_requested_commit_id_) {
+      break;
+    }
+
+    cid_t sync_commit_id = sync_requested_commit_id_;
+    int sync_fd = sync_fd_;
+    sync_lock.unlock();
+
+    if (fdatasync(sync_fd) != 0) {
+      LOG_ERROR("Error occured in fdatasync(%s)", strerror(errno));
+    }
+
+    sync_lock.lock();
+    synced_commit_id_ = sync_commit_id;
+    if (sync_commit_id > max_flushed_commit_id) {
+      max_flushed_commit_id = sync_commit_id;
+    }
+    fsync_count++;
+    sync_cv_.notify_all();
+
+    // signal that we have flushed
+    LogManager::GetInstance().FrontendLoggerFlushed();
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -239,6 +448,36 @@ void WriteAheadFrontendLogger::DoRecovery() {
   // open first file
   OpenNextLogFile();
 
+  num_inserts +=
+      ReadLogRecords(start_commit_id, global_max_flushed_id_for_recovery);
+
+  if (in_compressed_block_) {
+    EndCompressedBlock();
+  }
+
+  // Apply the transactions that committed since the last batch
+  ReplayCommittedTransactions();
+
+  // Finally, abort ACTIVE transactions in recovery_txn_table
+  AbortActiveTransactions();
+
+  // After finishing recovery, set the next oid with maximum oid
+  // observed during the recovery
+  log_manager.UpdateCatalogAndTxnManagers(max_oid, max_cid);
+
+  LOG_TRACE("This thread did %d inserts", (int)num_inserts);
+  cur_file_handle = INVALID_FILE_HANDLE;
+}
+
+/**
+ * @brief Read the log records from the current position on, and collect the
+ * records of the transactions that committed after start_commit_id and up
+ * to max_commit_id. Returns the number of tuple records read.
+ */
+int WriteAheadFrontendLogger::ReadLogRecords(cid_t start_commit_id,
+                                             cid_t max_commit_id) {
+  int num_inserts = 0;
+
   // Go over the log file if needed
   bool reached_end_of_log = false;
 
@@ -258,33 +497,33 @@ void WriteAheadFrontendLogger::DoRecovery() {
         TransactionRecord txn_rec(record_type);
         if (LoggingUtil::ReadTransactionRecordHeader(
                 txn_rec, cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          reached_end_of_log = true;
+          break;
         }
         log_id = txn_rec.GetTransactionId();
-        if (log_id <= start_commit_id ||
-            log_id > global_max_flushed_id_for_recovery) {
+        if (log_id <= start_commit_id || log_id > max_commit_id) {
           LOG_TRACE("SKIP");
           continue;
         }
         break;
       }
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
+      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+      case LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE: {
         tuple_record = new TupleRecord(record_type);
         // Check for torn log write
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
           LOG_ERROR("Could not read tuple record header.");
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
 
         log_id = tuple_record->GetTransactionId();
         auto table = LoggingUtil::GetTable(*tuple_record);
 
-        if (!table || log_id <= start_commit_id ||
-            log_id > global_max_flushed_id_for_recovery) {
+        if (!table || log_id <= start_commit_id || log_id > max_commit_id) {
           LoggingUtil::SkipTupleRecordBody(cur_file_handle);
           LOG_TRACE("Skip a tuple, log id is %d", (int)log_id);
           delete tuple_record;
@@ -294,36 +533,53 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_ERROR("Insert txd id %d not found in recovery txn table",
                     (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
 
         // Read off the tuple record body from the log
-        tuple_record->SetTuple(LoggingUtil::ReadTupleRecordBody(
-            table->GetSchema(), recovery_pool, cur_file_handle));
+        if (record_type == LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE) {
+          std::vector<oid_t> column_ids;
+          tuple_record->SetTuple(LoggingUtil::ReadTupleDeltaRecordBody(
+              table->GetSchema(), recovery_pool, cur_file_handle, column_ids));
+          tuple_record->SetColumnIds(column_ids);
+        } else {
+          tuple_record->SetTuple(LoggingUtil::ReadTupleRecordBody(
+              table->GetSchema(), recovery_pool, cur_file_handle));
+        }
         num_inserts++;
         break;
       }
+      case LOGRECORD_TYPE_COMPRESSED_BLOCK: {
+        // the records of the block are read before the ones following it
+        if (in_compressed_block_ || BeginCompressedBlock() == false) {
+          reached_end_of_log = true;
+          break;
+        }
+        continue;
+      }
       case LOGRECORD_TYPE_WAL_TUPLE_DELETE: {
         tuple_record = new TupleRecord(record_type);
         // Check for torn log write
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
 
         log_id = tuple_record->GetTransactionId();
-        if (log_id <= start_commit_id ||
-            log_id > global_max_flushed_id_for_recovery) {
+        if (log_id <= start_commit_id || log_id > max_commit_id) {
           delete tuple_record;
           continue;
         }
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_TRACE("Delete txd id %d not found in recovery txn table",
                     (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
         break;
       }
@@ -341,16 +597,23 @@ void WriteAheadFrontendLogger::DoRecovery() {
         case LOGRECORD_TYPE_TRANSACTION_COMMIT:
           PL_ASSERT(log_id != INVALID_CID);
 
-          // Now directly commit this transaction. This is safe because we
+          // Now commit this transaction. This is safe because we
           // reject commit ids that appear
           // after the persistent commit id before coming here (in the switch
-          // case above).
-          CommitTransactionRecovery(log_id);
+          // case above). Its records are applied with the next batch.
+          // A streamed block may hold commits beyond the commit id it
+          // covers, they wait for the block that covers them.
+          if (replaying_stream_) {
+            stream_commit_ids_.insert(log_id);
+          } else {
+            CommitTransactionRecovery(log_id);
+          }
           break;
 
         case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
         case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
         case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+        case LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE:
           recovery_txn_table[tuple_record->GetTransactionId()]
               .push_back(tuple_record);
           break;
@@ -369,17 +632,63 @@ void WriteAheadFrontendLogger::DoRecovery() {
     }
   }
 
-  // Finally, abort ACTIVE transactions in recovery_txn_table
-  AbortActiveTransactions();
+  return num_inserts;
+}
 
-  // After finishing recovery, set the next oid with maximum oid
-  // observed during the recovery
-  log_manager.UpdateCatalogAndTxnManagers(max_oid, max_cid);
+/**
+ * @brief Replay a block of log records streamed from the primary
+ *
+ * The transactions that committed up to max_commit_id are applied. The
+ * commits in the block beyond it wait for the block that covers them, and
+ * the records of unfinished transactions for their commit. The versions
+ * the replay invalidates stay readable for the snapshots older than it,
+ * until they are handed to the garbage collector by RecycleEndedVersions.
+ */
+void WriteAheadFrontendLogger::ReplayLogBlock(const char *data, size_t length,
+                                              cid_t max_commit_id) {
+  replaying_stream_ = true;
+
+  if (length != 0) {
+    FILE *block_file = fmemopen(const_cast<char *>(data), length, "rb");
+    if (block_file == nullptr) {
+      LOG_ERROR("Could not open streamed log block: %s", strerror(errno));
+    } else {
+      cur_file_handle =
+          FileHandle(block_file, INVALID_FILE_DESCRIPTOR, length);
+      ReadLogRecords(INVALID_CID, MAX_CID);
+      if (in_compressed_block_) {
+        EndCompressedBlock();
+      }
+      fclose(cur_file_handle.file);
+      cur_file_handle = INVALID_FILE_HANDLE;
+    }
+  }
 
-  LOG_TRACE("This thread did %d inserts", (int)num_inserts);
-  cur_file_handle = INVALID_FILE_HANDLE;
+  while (stream_commit_ids_.empty() == false &&
+         *stream_commit_ids_.begin() <= max_commit_id) {
+    CommitTransactionRecovery(*stream_commit_ids_.begin());
+    stream_commit_ids_.erase(stream_commit_ids_.begin());
+  }
+  ReplayCommittedTransactions();
+
+  replaying_stream_ = false;
+
+  // keep the managers ahead of the replayed tile groups and commits
+  auto &manager = catalog::Manager::GetInstance();
+  if (max_oid > manager.GetCurrentTileGroupId()) {
+    manager.SetNextTileGroupId(max_oid);
+  }
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  if (max_cid > txn_manager.GetCurrentCommitId()) {
+    txn_manager.SetNextCid(max_cid);
+  }
 }
 
+/**
+ * @brief Rebuild the indexes once all the log records were replayed
+ *
+ * The tables are indexed in parallel, each table by a single thread.
+ */
 void WriteAheadFrontendLogger::RecoverIndex() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   LOG_TRACE("Recovering the indexes");
@@ -388,6 +697,7 @@ void WriteAheadFrontendLogger::RecoverIndex() {
 
   auto catalog = catalog::Catalog::GetInstance();
   auto database_count = catalog->GetDatabaseCount();
+  std::vector<storage::DataTable *> target_tables;
 
   // loop all databases
   for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
@@ -402,11 +712,32 @@ void WriteAheadFrontendLogger::RecoverIndex() {
       LOG_TRACE("SeqScan: database oid %u table oid %u: %s", database_idx,
                 table_idx, target_table->GetName().c_str());
 
-      if (!RecoverTableIndexHelper(target_table, cid)) {
-        break;
+      if (target_table->GetIndexCount() != 0) {
+        target_tables.push_back(target_table);
       }
     }
   }
+
+  std::atomic<size_t> next_table_itr(0);
+  auto index_tables = [&]() {
+    size_t table_itr;
+    while ((table_itr = next_table_itr++) < target_tables.size()) {
+      RecoverTableIndexHelper(target_tables[table_itr], cid);
+    }
+  };
+
+  size_t thread_count =
+      std::min<size_t>(LogManager::GetInstance().GetRecoveryThreadCount(),
+                       target_tables.size());
+  std::vector<std::thread> index_threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    index_threads.emplace_back(index_tables);
+  }
+  index_tables();
+
+  for (auto &index_thread : index_threads) {
+    index_thread.join();
+  }
 }
 
 bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
@@ -442,53 +773,111 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
     LOG_TRACE("Retrieved tile group %u", tile_group_id);
 
     // Go over the logical tile
+    std::vector<std::unique_ptr<storage::Tuple>> tuples;
+    std::vector<ItemPointer> locations;
     for (oid_t tuple_id : *logical_tile) {
       expression::ContainerTuple<executor::LogicalTile> cur_tuple(
           logical_tile.get(), tuple_id);
 
-      // Index update
-      {
-        // construct a physical tuple from the logical tuple
-        std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
-        for (auto column_id : column_ids) {
-          type::Value val = cur_tuple.GetValue(column_id);
-          tuple->SetValue(column_id, val,
-                          recovery_pool);
-        }
-
-        ItemPointer location(tile_group_id, tuple_id);
-        InsertIndexEntry(tuple.get(), target_table, location);
+      // construct a physical tuple from the logical tuple
+      std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+      for (auto column_id : column_ids) {
+        type::Value val = cur_tuple.GetValue(column_id);
+        tuple->SetValue(column_id, val,
+                        recovery_pool);
       }
+
+      tuples.push_back(std::move(tuple));
+      locations.emplace_back(tile_group_id, tuple_id);
     }
+
+    // Index update, once per tile group
+    InsertIndexEntries(target_table, tuples, locations);
     current_tile_group_offset++;
   }
   return true;
 }
 
-void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *tuple,
-                                                storage::DataTable *table,
-                                                ItemPointer target_location UNUSED_ATTRIBUTE) {
-  PL_ASSERT(tuple);
+void WriteAheadFrontendLogger::InsertIndexEntries(
+    storage::DataTable *table,
+    const std::vector<std::unique_ptr<storage::Tuple>> &tuples,
+    const std::vector<ItemPointer> &target_locations) {
   PL_ASSERT(table);
+  PL_ASSERT(tuples.size() == target_locations.size());
   auto index_count = table->GetIndexCount();
-  LOG_TRACE("Insert tuple (%u, %u) into %u indexes", target_location.block,
-            target_location.offset, index_count);
+  LOG_TRACE("Insert %lu tuples into %u indexes", tuples.size(), index_count);
 
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = table->GetIndex(index_itr);
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
-    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-    key->SetFromTuple(tuple, indexed_columns, index->GetPool());
 
-    // TODO: workaround. this can cause memory leak.
-    // since currently logging does not work, we will handle this later.
-    // index->InsertEntry(key.get(), new ItemPointer(target_location));
-    // Increase the indexes' number of tuples by 1 as well
-    index->IncreaseNumberOfTuplesBy(1);
+    std::vector<std::unique_ptr<storage::Tuple>> keys;
+    std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entry_list;
+    for (size_t tuple_itr = 0; tuple_itr < tuples.size(); tuple_itr++) {
+      std::unique_ptr<storage::Tuple> key(
+          new storage::Tuple(index_schema, true));
+      key->SetFromTuple(tuples[tuple_itr].get(), indexed_columns,
+                        index->GetPool());
+      entry_list.emplace_back(key.get(),
+                              new ItemPointer(target_locations[tuple_itr]));
+      keys.push_back(std::move(key));
+    }
+
+    size_t inserted_count = entry_list.size();
+    if (index->BulkInsertEntries(entry_list, false) == false) {
+      LOG_ERROR("Could not bulk rebuild index %u of table %u, inserting %lu "
+                "entries one by one",
+                index->GetOid(), table->GetOid(), entry_list.size());
+      inserted_count = InsertIndexEntriesOneByOne(index.get(), entry_list);
+    }
+
+    // Increase the indexes' number of tuples as well
+    index->IncreaseNumberOfTuplesBy(inserted_count);
   }
 }
 
+/**
+ * @brief Insert the entries of a batch that was rejected, or only inserted
+ * in part, one by one. The locations of the entries that can not be
+ * inserted are freed. Returns the number of entries in the index.
+ */
+size_t WriteAheadFrontendLogger::InsertIndexEntriesOneByOne(
+    index::Index *index,
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entry_list) {
+  auto conflict = [](const void *) { return true; };
+  size_t inserted_count = 0;
+
+  for (auto &entry : entry_list) {
+    // the entry went in before the batch hit a conflict
+    std::vector<ItemPointer *> locations;
+    index->ScanKey(entry.first, locations);
+    if (std::find(locations.begin(), locations.end(), entry.second) !=
+        locations.end()) {
+      inserted_count++;
+      continue;
+    }
+
+    bool ret;
+    if (index->HasUniqueKeys() == true) {
+      ret = index->CondInsertEntry(entry.first, entry.second, conflict);
+    } else {
+      ret = index->InsertEntry(entry.first, entry.second);
+    }
+
+    if (ret == true) {
+      inserted_count++;
+    } else {
+      LOG_ERROR("Could not insert tuple(%u, %u) into index %u",
+                entry.second->block, entry.second->offset, index->GetOid());
+      delete entry.second;
+    }
+  }
+
+  return inserted_count;
+}
+
 /**
  * @brief Add new txn to recovery table
  */
@@ -512,31 +901,100 @@ void WriteAheadFrontendLogger::StartTransactionRecovery(cid_t commit_id) {
 }
 
 /**
- * @brief move tuples from current txn to recovery txn so that we can commit
- * them later
+ * @brief move tuples from current txn to the replay partitions so that we
+ * can apply them later
  * @param recovery txn
  */
 void WriteAheadFrontendLogger::CommitTransactionRecovery(cid_t commit_id) {
+  size_t partition_count = LogManager::GetInstance().GetRecoveryThreadCount();
+  if (replay_partitions_.size() != partition_count) {
+    ReplayCommittedTransactions();
+    replay_partitions_.resize(partition_count);
+  }
+
+  // all the records of a table go to the same partition, because the
+  // versions of a tuple may span tile groups
   std::vector<TupleRecord *> &tuple_records = recovery_txn_table[commit_id];
-  for (auto it = tuple_records.begin(); it != tuple_records.end(); it++) {
-    TupleRecord *curr = *it;
-    switch (curr->GetType()) {
+  for (auto tuple_record : tuple_records) {
+    replay_partitions_[tuple_record->GetTableId() % partition_count].push_back(
+        tuple_record);
+  }
+  replay_record_count_ += tuple_records.size();
+
+  max_cid = std::max(max_cid, commit_id + 1);
+  recovery_txn_table.erase(commit_id);
+
+  if (replay_record_count_ >= RECOVERY_REPLAY_BATCH_SIZE) {
+    ReplayCommittedTransactions();
+  }
+}
+
+/**
+ * @brief apply the collected records of committed txns
+ *
+ * Tables are independent of each other, so the partitions are replayed in
+ * parallel. The tile groups a table adds during recovery are only touched by
+ * the thread of its partition.
+ */
+void WriteAheadFrontendLogger::ReplayCommittedTransactions() {
+  std::vector<oid_t> max_tile_group_ids(replay_partitions_.size(), 0);
+  std::vector<std::thread> replay_threads;
+
+  for (size_t partition_itr = 0; partition_itr < replay_partitions_.size();
+       partition_itr++) {
+    if (replay_partitions_[partition_itr].empty()) {
+      continue;
+    }
+    replay_threads.emplace_back(&WriteAheadFrontendLogger::ReplayPartition,
+                                this,
+                                std::ref(replay_partitions_[partition_itr]),
+                                std::ref(max_tile_group_ids[partition_itr]));
+  }
+
+  for (auto &replay_thread : replay_threads) {
+    replay_thread.join();
+  }
+
+  for (auto max_tile_group_id : max_tile_group_ids) {
+    if (max_oid < max_tile_group_id) {
+      max_oid = max_tile_group_id;
+    }
+  }
+
+  LOG_TRACE("Replayed %lu records with %lu threads", replay_record_count_,
+            replay_threads.size());
+  replay_record_count_ = 0;
+}
+
+/**
+ * @brief apply the records of a partition in commit id order
+ */
+void WriteAheadFrontendLogger::ReplayPartition(
+    std::vector<TupleRecord *> &tuple_records, oid_t &max_tg) {
+  // the records of a txn keep their log order
+  std::stable_sort(tuple_records.begin(), tuple_records.end(),
+                   [](TupleRecord *lhs, TupleRecord *rhs) {
+                     return lhs->GetTransactionId() < rhs->GetTransactionId();
+                   });
+
+  for (auto tuple_record : tuple_records) {
+    switch (tuple_record->GetType()) {
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-        InsertTuple(curr);
+        InsertTuple(tuple_record, max_tg);
         break;
       case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
-        UpdateTuple(curr);
+      case LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE:
+        UpdateTuple(tuple_record, max_tg);
         break;
       case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
-        DeleteTuple(curr);
+        DeleteTuple(tuple_record, max_tg);
         break;
       default:
-        continue;
+        break;
     }
-    delete curr;
+    delete tuple_record;
   }
-  max_cid = commit_id + 1;
-  recovery_txn_table.erase(commit_id);
+  tuple_records.clear();
 }
 
 void InsertTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
@@ -578,7 +1036,8 @@ void InsertTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
 }
 
 void DeleteTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
-                       oid_t table_id, const ItemPointer &delete_loc) {
+                       oid_t table_id, const ItemPointer &delete_loc,
+                       bool keep_old_version) {
   auto &manager = catalog::Manager::GetInstance();
   auto catalog = catalog::Catalog::GetInstance();
   storage::Database *db = catalog->GetDatabaseWithOid(db_id);
@@ -605,12 +1064,14 @@ void DeleteTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
   table->DecreaseTupleCount(1);
   // table->GetTileGroupLock().Unlock();
 
-  tile_group->DeleteTupleFromRecovery(commit_id, delete_loc.offset);
+  tile_group->DeleteTupleFromRecovery(commit_id, delete_loc.offset,
+                                      keep_old_version);
 }
 
 void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
                        oid_t table_id, const ItemPointer &remove_loc,
-                       const ItemPointer &insert_loc, storage::Tuple *tuple) {
+                       const ItemPointer &insert_loc, storage::Tuple *tuple,
+                       bool keep_old_version) {
   auto &manager = catalog::Manager::GetInstance();
   auto catalog = catalog::Catalog::GetInstance();
   storage::Database *db = catalog->GetDatabaseWithOid(db_id);
@@ -637,15 +1098,17 @@ void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
   InsertTupleHelper(max_tg, commit_id, db_id, table_id, insert_loc, tuple,
                     false);
 
-  tile_group->UpdateTupleFromRecovery(commit_id, remove_loc.offset, insert_loc);
+  tile_group->UpdateTupleFromRecovery(commit_id, remove_loc.offset, insert_loc,
+                                      keep_old_version);
 }
 
 /**
  * @brief read tuple record from log file and add them tuples to recovery txn
  * @param recovery txn
  */
-void WriteAheadFrontendLogger::InsertTuple(TupleRecord *record) {
-  InsertTupleHelper(max_oid, record->GetTransactionId(),
+void WriteAheadFrontendLogger::InsertTuple(TupleRecord *record,
+                                           oid_t &max_tg) {
+  InsertTupleHelper(max_tg, record->GetTransactionId(),
                     record->GetDatabaseOid(), record->GetTableId(),
                     record->GetInsertLocation(), record->GetTuple());
 }
@@ -654,10 +1117,15 @@ void WriteAheadFrontendLogger::InsertTuple(TupleRecord *record) {
  * @brief read tuple record from log file and add them tuples to recovery txn
  * @param recovery txn
  */
-void WriteAheadFrontendLogger::DeleteTuple(TupleRecord *record) {
-  DeleteTupleHelper(max_oid, record->GetTransactionId(),
+void WriteAheadFrontendLogger::DeleteTuple(TupleRecord *record,
+                                           oid_t &max_tg) {
+  DeleteTupleHelper(max_tg, record->GetTransactionId(),
                     record->GetDatabaseOid(), record->GetTableId(),
-                    record->GetDeleteLocation());
+                    record->GetDeleteLocation(), replaying_stream_);
+  if (replaying_stream_) {
+    RecordEndedVersion(record->GetDeleteLocation(), record->GetTransactionId(),
+                       true);
+  }
 }
 
 /**
@@ -665,11 +1133,94 @@ void WriteAheadFrontendLogger::DeleteTuple(TupleRecord *record) {
  * @param recovery txn
  */
 
-void WriteAheadFrontendLogger::UpdateTuple(TupleRecord *record) {
-  UpdateTupleHelper(max_oid, record->GetTransactionId(),
+void WriteAheadFrontendLogger::UpdateTuple(TupleRecord *record,
+                                           oid_t &max_tg) {
+  auto &column_ids = record->GetColumnIds();
+  if (column_ids.empty() == false) {
+    // a delta update only carries the changed columns, the others are taken
+    // from the old version
+    auto delete_location = record->GetDeleteLocation();
+    auto old_tile_group =
+        catalog::Manager::GetInstance().GetTileGroup(delete_location.block);
+    auto tuple = record->GetTuple();
+    if (old_tile_group == nullptr) {
+      LOG_ERROR("Old version of delta update not found");
+    } else {
+      auto column_count = tuple->GetSchema()->GetColumnCount();
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        if (std::find(column_ids.begin(), column_ids.end(), column_id) !=
+            column_ids.end()) {
+          continue;
+        }
+        tuple->SetValue(
+            column_id,
+            old_tile_group->GetValue(delete_location.offset, column_id),
+            recovery_pool);
+      }
+    }
+  }
+
+  UpdateTupleHelper(max_tg, record->GetTransactionId(),
                     record->GetDatabaseOid(), record->GetTableId(),
                     record->GetDeleteLocation(), record->GetInsertLocation(),
-                    record->GetTuple());
+                    record->GetTuple(), replaying_stream_);
+  if (replaying_stream_) {
+    RecordEndedVersion(record->GetDeleteLocation(), record->GetTransactionId(),
+                       false);
+  }
+}
+
+/**
+ * @brief The version stays in place for the snapshots older than its end,
+ * it is handed to the garbage collector by RecycleEndedVersions once none
+ * of them is left. The version was not ended if the slot was not committed
+ * before, or if a later commit already took it.
+ */
+void WriteAheadFrontendLogger::RecordEndedVersion(const ItemPointer &location,
+                                                  cid_t commit_id,
+                                                  bool is_delete) {
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(location.block);
+  if (tile_group == nullptr) {
+    return;
+  }
+  auto tile_group_header = tile_group->GetHeader();
+  if (tile_group_header->GetTransactionId(location.offset) !=
+          INITIAL_TXN_ID ||
+      tile_group_header->GetEndCommitId(location.offset) != commit_id) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> ended_versions_lock(ended_versions_mutex_);
+  ended_versions_[commit_id][location.block][location.offset] = is_delete;
+}
+
+size_t WriteAheadFrontendLogger::RecycleEndedVersions(
+    cid_t max_end_commit_id) {
+  std::shared_ptr<GCSet> gc_set(new GCSet());
+  size_t version_count = 0;
+
+  {
+    std::lock_guard<std::mutex> ended_versions_lock(ended_versions_mutex_);
+    auto ended_itr = ended_versions_.begin();
+    while (ended_itr != ended_versions_.end() &&
+           ended_itr->first <= max_end_commit_id) {
+      for (auto &tile_group_entry : ended_itr->second) {
+        for (auto &slot_entry : tile_group_entry.second) {
+          (*gc_set)[tile_group_entry.first][slot_entry.first] =
+              slot_entry.second;
+          version_count++;
+        }
+      }
+      ended_itr = ended_versions_.erase(ended_itr);
+    }
+  }
+
+  if (version_count != 0) {
+    gc::GCManagerFactory::GetInstance().RecycleTransaction(gc_set,
+                                                           max_end_commit_id);
+  }
+  return version_count;
 }
 
 //===--------------------------------------------------------------------===//
@@ -681,11 +1232,19 @@ LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
   bool is_truncated = false;
   int ret;
 
-  if (cur_file_handle.file == nullptr || cur_file_handle.fd == -1)
+  // a streamed block is read from memory, it has no file descriptor
+  if (cur_file_handle.file == nullptr ||
+      (cur_file_handle.fd == -1 && replaying_stream_ == false))
     return LOGRECORD_TYPE_INVALID;
 
   LOG_TRACE("Inside GetNextLogRecordForRecovery");
 
+  // all the records of the compressed block were read
+  if (in_compressed_block_ &&
+      LoggingUtil::IsFileTruncated(cur_file_handle, 1)) {
+    EndCompressedBlock();
+  }
+
   LOG_TRACE("File is at position %d", (int)ftell(cur_file_handle.file));
 
   // Check if the log record type is broken
@@ -702,6 +1261,9 @@ LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
     }
   }
   if (is_truncated || ret <= 0) {
+    // the records of a streamed block end with the block
+    if (replaying_stream_) return LOGRECORD_TYPE_INVALID;
+
     LOG_TRACE("Call OpenNextLogFile");
     OpenNextLogFile();
     if (cur_file_handle.fd == -1) return LOGRECORD_TYPE_INVALID;
@@ -730,6 +1292,56 @@ LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
   return log_record_type;
 }
 
+bool WriteAheadFrontendLogger::BeginCompressedBlock() {
+  // Check for torn log write
+  auto frame_size = LoggingUtil::GetNextFrameSize(cur_file_handle);
+  size_t data_offset = sizeof(int32_t) + LogCompression::GetBlockHeaderSize();
+  if (frame_size < data_offset) {
+    return false;
+  }
+
+  std::vector<char> frame(frame_size);
+  if (fread(frame.data(), 1, frame_size, cur_file_handle.file) != frame_size) {
+    LOG_ERROR("Could not read compressed log block");
+    return false;
+  }
+
+  CopySerializeInput block_header(frame.data(), data_offset);
+  block_header.ReadInt();
+  auto compression_type =
+      static_cast<LogCompressionType>(block_header.ReadByte());
+  size_t raw_length = block_header.ReadInt();
+  block_header.ReadLong();
+
+  block_data_.resize(raw_length);
+  if (raw_length == 0 ||
+      LogCompression::Decompress(compression_type, frame.data() + data_offset,
+                                 frame_size - data_offset, block_data_.data(),
+                                 raw_length) == false) {
+    LOG_ERROR("Could not decompress %s log block",
+              LogCompressionTypeToString(compression_type).c_str());
+    return false;
+  }
+
+  FILE *block_file = fmemopen(block_data_.data(), raw_length, "rb");
+  if (block_file == nullptr) {
+    LOG_ERROR("Could not open compressed log block: %s", strerror(errno));
+    return false;
+  }
+
+  // the log file descriptor stays valid for the checks of the caller
+  log_file_handle_ = cur_file_handle;
+  cur_file_handle = FileHandle(block_file, log_file_handle_.fd, raw_length);
+  in_compressed_block_ = true;
+  return true;
+}
+
+void WriteAheadFrontendLogger::EndCompressedBlock() {
+  fclose(cur_file_handle.file);
+  cur_file_handle = log_file_handle_;
+  in_compressed_block_ = false;
+}
+
 std::string WriteAheadFrontendLogger::GetLogFileName(void) {
   auto &log_manager = logging::LogManager::GetInstance();
   return log_manager.GetLogFileName();
@@ -879,6 +1491,9 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
   new_file_num = log_file_counter_;
 
   if (close_old_file) {  // must close last opened file
+    // the sync thread may still use the file
+    WaitForSync();
+
     int file_list_size = log_files_.size();
     LogFile *cur_log_file_object = log_files_[file_list_size - 1];
 
@@ -956,6 +1571,10 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
 
   log_file_counter_++;  // finally, increment log_file_counter_
 
+  if (!no_write_) {
+    StartSyncThread();
+  }
+
   LOG_TRACE("log_file_counter is %d", log_file_counter_);
 }
 
@@ -1127,7 +1746,8 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
         break;
       }
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
+      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+      case LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE: {
         tuple_record = new TupleRecord(record_type);
 
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record, file_handle) ==
@@ -1171,6 +1791,30 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
         delete tuple_record;
         break;
       }
+      case LOGRECORD_TYPE_COMPRESSED_BLOCK: {
+        // the block header carries the max log id of its records
+        auto frame_size = LoggingUtil::GetNextFrameSize(file_handle);
+        size_t header_size =
+            sizeof(int32_t) + LogCompression::GetBlockHeaderSize();
+        if (frame_size < header_size) {
+          return std::pair<cid_t, cid_t>(UINT64_MAX, UINT64_MAX);
+        }
+
+        char header[header_size];
+        if (fread(header, 1, header_size, file_handle.file) != header_size ||
+            fseek(file_handle.file, frame_size - header_size, SEEK_CUR) != 0) {
+          return std::pair<cid_t, cid_t>(UINT64_MAX, UINT64_MAX);
+        }
+
+        CopySerializeInput block_header(header, header_size);
+        block_header.ReadInt();
+        block_header.ReadByte();
+        block_header.ReadInt();
+        cid_t cid = block_header.ReadLong();
+
+        if (cid > max_log_id_so_far) max_log_id_so_far = cid;
+        break;
+      }
       default:
         reached_end_of_file = true;
         break;
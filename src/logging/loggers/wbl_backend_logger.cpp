@@ -25,15 +25,8 @@ namespace peloton {
 namespace logging {
 
 void WriteBehindBackendLogger::Log(LogRecord *record) {
-  // if we are committing, sync all data before taking the lock
-  if (record->GetType() == LOGRECORD_TYPE_TRANSACTION_COMMIT) {
-    auto &log_manager = LogManager::GetInstance();
-    auto no_write = log_manager.GetNoWrite();
-
-    if(no_write == false) {
-      SyncDataForCommit();
-    }
-  }
+  // the modified tile groups are synced by the frontend logger at the group
+  // commit covering this transaction
   log_buffer_lock.Lock();
   switch (record->GetType()) {
     case LOGRECORD_TYPE_TRANSACTION_COMMIT:
@@ -61,7 +54,8 @@ void WriteBehindBackendLogger::Log(LogRecord *record) {
       break;
     }
     case LOGRECORD_TYPE_WBL_TUPLE_UPDATE:
-    case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
+    case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+    case LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE: {
       tile_groups_to_sync_.insert(
           ((TupleRecord *)record)->GetDeleteLocation().block);
       tile_groups_to_sync_.insert(
@@ -76,56 +70,47 @@ void WriteBehindBackendLogger::Log(LogRecord *record) {
   log_buffer_lock.Unlock();
 }
 
-void WriteBehindBackendLogger::SyncDataForCommit() {
-  auto &manager = catalog::Manager::GetInstance();
-
-  // Sync the tiles in the modified tile groups and their headers
-  for (oid_t tile_group_id : tile_groups_to_sync_) {
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    tile_group->Sync();
-    tile_group->GetHeader()->Sync();
-  }
+void WriteBehindBackendLogger::CollectTileGroupsToSync(
+    std::unordered_set<oid_t> &tile_groups) {
+  log_buffer_lock.Lock();
+  tile_groups.insert(tile_groups_to_sync_.begin(), tile_groups_to_sync_.end());
 
   // Clear the list of tile groups
   tile_groups_to_sync_.clear();
+  log_buffer_lock.Unlock();
 }
 
 LogRecord *WriteBehindBackendLogger::GetTupleRecord(
     LogRecordType log_record_type, txn_id_t txn_id, oid_t table_oid,
     oid_t db_oid, ItemPointer insert_location, ItemPointer delete_location,
     UNUSED_ATTRIBUTE const void *data) {
-  // Figure the log record type
-  LogRecord *tuple_record;
+  // Don't make use of "data" in case of peloton log records
+  // Build the tuple log record
+  LogRecord *tuple_record = new TupleRecord(
+      GetTupleRecordType(log_record_type), txn_id, table_oid, insert_location,
+      delete_location, nullptr, db_oid);
+
+  return tuple_record;
+}
 
+LogRecordType WriteBehindBackendLogger::GetTupleRecordType(
+    LogRecordType log_record_type) {
   switch (log_record_type) {
-    case LOGRECORD_TYPE_TUPLE_INSERT: {
-      log_record_type = LOGRECORD_TYPE_WBL_TUPLE_INSERT;
-      break;
-    }
+    case LOGRECORD_TYPE_TUPLE_INSERT:
+      return LOGRECORD_TYPE_WBL_TUPLE_INSERT;
 
-    case LOGRECORD_TYPE_TUPLE_DELETE: {
-      log_record_type = LOGRECORD_TYPE_WBL_TUPLE_DELETE;
-      break;
-    }
+    case LOGRECORD_TYPE_TUPLE_DELETE:
+      return LOGRECORD_TYPE_WBL_TUPLE_DELETE;
 
-    case LOGRECORD_TYPE_TUPLE_UPDATE: {
-      log_record_type = LOGRECORD_TYPE_WBL_TUPLE_UPDATE;
-      break;
-    }
+    case LOGRECORD_TYPE_TUPLE_UPDATE:
+    case LOGRECORD_TYPE_TUPLE_DELTA_UPDATE:
+      return LOGRECORD_TYPE_WBL_TUPLE_UPDATE;
 
     default: {
       PL_ASSERT(false);
-      break;
+      return log_record_type;
     }
   }
-  // Don't make use of "data" in case of peloton log records
-  // Build the tuple log record
-  tuple_record =
-      new TupleRecord(log_record_type, txn_id, table_oid, insert_location,
-                      delete_location, nullptr, db_oid);
-
-
-  return tuple_record;
 }
 
 }  // namespace logging
@@ -12,30 +12,62 @@
 
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include "common/exception.h"
+#include "catalog/catalog.h"
 #include "catalog/manager.h"
 #include "catalog/schema.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
+#include "storage/storage_manager.h"
 #include "storage/tuple.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
+#include "type/serializeio.h"
 #include "logging/loggers/wbl_frontend_logger.h"
 #include "logging/loggers/wbl_backend_logger.h"
 #include "logging/logging_util.h"
 #include "logging/log_manager.h"
 
-#define POSSIBLY_DIRTY_GRANT_SIZE 10000000;  // ten million seems reasonable
+#define POSSIBLY_DIRTY_GRANT_SIZE 10000000  // ten million seems reasonable
 
 namespace peloton {
 namespace logging {
 
+enum WriteBehindLogRecordType : uint64_t {
+  // written at every group commit
+  WBL_RECORD_TYPE_GROUP_COMMIT = 1,
+  // written by recovery for the commit id gap left by a crash
+  WBL_RECORD_TYPE_DIRTY_RANGE = 2
+};
+
 struct WriteBehindLogRecord {
+  uint64_t record_type;
   cid_t persistent_commit_id;
   cid_t max_possible_dirty_commit_id;
 };
 
+// Where a tile group lives in the data file, written to the layout file the
+// first time the tile group is synced
+struct TileGroupLayout {
+  oid_t database_oid;
+  oid_t table_oid;
+  oid_t tile_group_id;
+  oid_t tuple_count;
+  size_t header_offset;
+  size_t header_size;
+  // columns of the table stored by every tile, in the order of the tile
+  std::vector<std::vector<oid_t>> tile_columns;
+  std::vector<std::vector<type::Type::TypeId>> tile_column_types;
+  std::vector<size_t> tile_sizes;
+  std::vector<size_t> tile_offsets;
+};
+
 // TODO for now, these helper routines are defined here, and also use
 // some routines from the LoggingUtil class. Make sure that all places where
 // these helper routines are called in this file use the LoggingUtil class
@@ -63,6 +95,17 @@ WriteBehindFrontendLogger::WriteBehindFrontendLogger() {
   if (log_file_fd == -1) {
     LOG_ERROR("log_file_fd is -1");
   }
+
+  // the layouts of the tile groups in the data file
+  layout_file = fopen(GetLayoutFileName().c_str(), "ab+");
+  if (layout_file == NULL) {
+    LOG_ERROR("LayoutFile is NULL");
+  }
+
+  layout_file_fd = fileno(layout_file);
+  if (layout_file_fd == -1) {
+    LOG_ERROR("layout_file_fd is -1");
+  }
 }
 
 /**
@@ -71,6 +114,10 @@ WriteBehindFrontendLogger::WriteBehindFrontendLogger() {
 WriteBehindFrontendLogger::~WriteBehindFrontendLogger() {
   // Clean up the frontend logger's queue
   global_queue.clear();
+
+  if (layout_file != NULL) {
+    fclose(layout_file);
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -78,34 +125,160 @@ WriteBehindFrontendLogger::~WriteBehindFrontendLogger() {
 //===--------------------------------------------------------------------===//
 
 /**
- * @brief flush all log records to the file
+ * @brief sync the modified tile groups, then persist the commit ids
  */
 void WriteBehindFrontendLogger::FlushLogRecords(void) {
-  struct WriteBehindLogRecord record;
-  record.persistent_commit_id = max_collected_commit_id;
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  cid_t new_grant =
-      txn_manager.GetCurrentCommitId() + POSSIBLY_DIRTY_GRANT_SIZE;
-  // get current highest dispense commit id
-  record.max_possible_dirty_commit_id = new_grant;
-  if (!no_write_) {
-    if (!fwrite(&record, sizeof(WriteBehindLogRecord), 1, log_file)) {
-      LOG_ERROR("Unable to write log record");
+  cid_t persistent_commit_id = max_collected_commit_id;
+  cid_t current_commit_id = txn_manager.GetCurrentCommitId();
+
+  // Nothing was committed since the last group commit, and its grant still
+  // covers the commit ids handed out meanwhile
+  bool skip_record = (persistent_commit_id == last_persistent_commit_id_ &&
+                      current_commit_id + POSSIBLY_DIRTY_GRANT_SIZE / 2 <
+                          last_grant_commit_id_);
+
+  if (skip_record == false) {
+    // The data must be durable before the record covering its commit ids
+    SyncTileGroups();
+
+    WriteBehindLogRecord record;
+    record.record_type = WBL_RECORD_TYPE_GROUP_COMMIT;
+    record.persistent_commit_id = persistent_commit_id;
+    cid_t new_grant = current_commit_id + POSSIBLY_DIRTY_GRANT_SIZE;
+    // get current highest dispense commit id
+    record.max_possible_dirty_commit_id = new_grant;
+    if (!no_write_) {
+      if (!fwrite(&record, sizeof(WriteBehindLogRecord), 1, log_file)) {
+        LOG_ERROR("Unable to write log record");
+      }
+      logged_bytes += sizeof(WriteBehindLogRecord);
     }
-  }
 
-  // for now fsync every time because the cost is relatively low
-  if (fsync(log_file_fd)) {
-    LOG_ERROR("Unable to fsync log");
+    // for now fsync every time because the cost is relatively low
+    if (fflush(log_file) != 0 || fsync(log_file_fd)) {
+      LOG_ERROR("Unable to fsync log");
+    }
+    fsync_count++;
+
+    last_persistent_commit_id_ = persistent_commit_id;
+    last_grant_commit_id_ = new_grant;
+
+    // set new grant in txn_manager
+    txn_manager.SetMaxGrantCid(new_grant);
   }
 
   // inform backend loggers they can proceed if waiting for sync
-  max_flushed_commit_id = max_collected_commit_id;
+  max_flushed_commit_id = persistent_commit_id;
   auto &manager = LogManager::GetInstance();
   manager.FrontendLoggerFlushed();
+}
+
+void WriteBehindFrontendLogger::SyncTileGroups() {
+  backend_loggers_lock.Lock();
+  for (auto backend_logger : backend_loggers) {
+    reinterpret_cast<WriteBehindBackendLogger *>(backend_logger)
+        ->CollectTileGroupsToSync(tile_groups_to_sync_);
+  }
+  backend_loggers_lock.Unlock();
+
+  if (no_write_ == false) {
+    auto &manager = catalog::Manager::GetInstance();
+    bool recorded_layout = false;
+
+    // Sync the tiles in the modified tile groups and their headers
+    for (oid_t tile_group_id : tile_groups_to_sync_) {
+      auto tile_group = manager.GetTileGroup(tile_group_id);
+      // the tile group was dropped meanwhile
+      if (tile_group == nullptr) {
+        continue;
+      }
+      tile_group->Sync();
+      tile_group->GetHeader()->Sync();
+      synced_tile_group_count_++;
+
+      if (RecordTileGroupLayout(tile_group.get()) == true) {
+        recorded_layout = true;
+      }
+    }
+
+    // Recovery must find the tile groups of the persisted commit ids
+    if (recorded_layout == true) {
+      if (fflush(layout_file) != 0 || fsync(layout_file_fd)) {
+        LOG_ERROR("Unable to fsync the tile group layouts");
+      }
+    }
+  }
+
+  tile_groups_to_sync_.clear();
+}
+
+bool WriteBehindFrontendLogger::RecordTileGroupLayout(
+    storage::TileGroup *tile_group) {
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t tile_group_id = tile_group->GetTileGroupId();
 
-  // set new grant in txn_manager
-  txn_manager.SetMaxGrantCid(new_grant);
+  size_t header_offset;
+  if (storage_manager.LocateInDataFile(tile_group_header->GetHeaderData(),
+                                       header_offset) == false) {
+    return false;
+  }
+
+  auto recorded_tile_group = recorded_tile_groups_.find(tile_group_id);
+  if (recorded_tile_group != recorded_tile_groups_.end() &&
+      recorded_tile_group->second == header_offset) {
+    return false;
+  }
+
+  // the columns of every tile, in the order of the tile
+  oid_t tile_count = tile_group->GetTileCount();
+  std::vector<std::vector<oid_t>> tile_columns(tile_count);
+  for (auto &column_entry : tile_group->GetColumnMap()) {
+    auto &columns = tile_columns[column_entry.second.first];
+    if (columns.size() <= column_entry.second.second) {
+      columns.resize(column_entry.second.second + 1);
+    }
+    columns[column_entry.second.second] = column_entry.first;
+  }
+
+  output_buffer.Reset();
+  size_t length_position = output_buffer.ReserveBytes(sizeof(int32_t));
+  output_buffer.WriteInt(tile_group->GetDatabaseId());
+  output_buffer.WriteInt(tile_group->GetTableId());
+  output_buffer.WriteInt(tile_group_id);
+  output_buffer.WriteInt(tile_group->GetAllocatedTupleCount());
+  output_buffer.WriteLong(header_offset);
+  output_buffer.WriteLong(tile_group_header->GetHeaderSize());
+
+  output_buffer.WriteInt(tile_count);
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    size_t tile_offset;
+    if (storage_manager.LocateInDataFile(tile->GetTupleLocation(0),
+                                         tile_offset) == false) {
+      return false;
+    }
+
+    output_buffer.WriteInt(tile_columns[tile_itr].size());
+    for (oid_t tile_column_itr = 0;
+         tile_column_itr < tile_columns[tile_itr].size(); tile_column_itr++) {
+      output_buffer.WriteInt(tile_columns[tile_itr][tile_column_itr]);
+      output_buffer.WriteInt(tile->GetSchema()->GetType(tile_column_itr));
+    }
+    output_buffer.WriteLong(tile->GetInlinedSize());
+    output_buffer.WriteLong(tile_offset);
+  }
+  output_buffer.WriteIntAt(length_position,
+                           output_buffer.Size() - sizeof(int32_t));
+
+  if (!fwrite(output_buffer.Data(), output_buffer.Size(), 1, layout_file)) {
+    LOG_ERROR("Unable to write the layout of tile group %u", tile_group_id);
+    return false;
+  }
+
+  recorded_tile_groups_[tile_group_id] = header_offset;
+  return true;
 }
 
 //===--------------------------------------------------------------------===//
@@ -124,10 +297,10 @@ void WriteBehindFrontendLogger::DoRecovery() {
   struct stat stat_buf;
   fstat(log_file_fd, &stat_buf);
 
-  // calculate number of records
-  long record_num = stat_buf.st_size / sizeof(WriteBehindLogRecord);
+  // calculate number of records, and drop a torn one at the end
+  size_t record_num = stat_buf.st_size / sizeof(WriteBehindLogRecord);
   if (stat_buf.st_size % sizeof(WriteBehindLogRecord)) {
-    if (!ftruncate(log_file_fd, record_num * sizeof(WriteBehindLogRecord))) {
+    if (ftruncate(log_file_fd, record_num * sizeof(WriteBehindLogRecord))) {
       LOG_ERROR("ftruncate failed on recovery");
     }
   }
@@ -139,30 +312,322 @@ void WriteBehindFrontendLogger::DoRecovery() {
     return;
   }
 
-  long first_record_offset = (record_num - 1) * sizeof(WriteBehindLogRecord);
+  std::vector<WriteBehindLogRecord> records(record_num);
+  fseek(log_file, 0, SEEK_SET);
+  if (fread(records.data(), sizeof(WriteBehindLogRecord), record_num,
+            log_file) != record_num) {
+    LOG_ERROR("log recovery read failed");
+    return;
+  }
 
-  // seek to current record;
-  fseek(log_file, first_record_offset, SEEK_SET);
+  // The gaps of earlier crashes stay dirty, the versions written in them can
+  // still be in the tables
+  std::vector<std::pair<cid_t, cid_t>> dirty_ranges;
+  cid_t max_possible_dirty_commit_id = INVALID_CID;
+  bool crashed = false;
+  WriteBehindLogRecord last_group_commit_record;
 
-  // read last record to get the possibly dirty span
-  WriteBehindLogRecord most_recent_log_record;
-  if (!fread(&most_recent_log_record, sizeof(WriteBehindLogRecord), 1,
-             log_file)) {
-    LOG_ERROR("log recovery read failed");
+  for (auto &record : records) {
+    max_possible_dirty_commit_id = std::max(
+        max_possible_dirty_commit_id, record.max_possible_dirty_commit_id);
+
+    if (record.record_type == WBL_RECORD_TYPE_DIRTY_RANGE) {
+      dirty_ranges.push_back(std::make_pair(
+          record.persistent_commit_id, record.max_possible_dirty_commit_id));
+      crashed = false;
+    } else {
+      last_group_commit_record = record;
+      crashed = true;
+    }
   }
 
-  // set the next cid of the transaction manager
+  // The span granted by the last group commit is possibly dirty
+  if (crashed == true) {
+    WriteBehindLogRecord gap_record;
+    gap_record.record_type = WBL_RECORD_TYPE_DIRTY_RANGE;
+    gap_record.persistent_commit_id =
+        last_group_commit_record.persistent_commit_id;
+    gap_record.max_possible_dirty_commit_id =
+        last_group_commit_record.max_possible_dirty_commit_id;
+    dirty_ranges.push_back(
+        std::make_pair(gap_record.persistent_commit_id,
+                       gap_record.max_possible_dirty_commit_id));
+
+    // Record the gap, so that the next recovery still knows about it
+    if (!fwrite(&gap_record, sizeof(WriteBehindLogRecord), 1, log_file) ||
+        fflush(log_file) != 0 || fsync(log_file_fd)) {
+      LOG_ERROR("Unable to record the dirty range");
+    }
+  }
+
+  LOG_INFO("Dirty range count : %lu", dirty_ranges.size());
+
+  // set the next cid of the transaction manager, and let transactions wait
+  // for the grant of the first group commit
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  txn_manager.SetNextCid(most_recent_log_record.max_possible_dirty_commit_id +
-                         1);
+  txn_manager.SetNextCid(max_possible_dirty_commit_id + 1);
+  txn_manager.SetMaxGrantCid(max_possible_dirty_commit_id);
+
+  // set the dirty spans of the transaction manager
+  txn_manager.SetDirtyRanges(dirty_ranges);
+
+  // the next group commit must not claim commit ids of the gap as persisted
+  max_collected_commit_id = max_possible_dirty_commit_id;
+  max_seen_commit_id = max_possible_dirty_commit_id;
+  max_flushed_commit_id = max_possible_dirty_commit_id;
+
+  RecoverTileGroups(dirty_ranges);
+}
 
-  // set the dirty span of the transaction manager
-  txn_manager.SetDirtyRange(
-      std::make_pair(most_recent_log_record.persistent_commit_id,
-                     most_recent_log_record.max_possible_dirty_commit_id));
+void WriteBehindFrontendLogger::RecoverTileGroups(
+    const std::vector<std::pair<cid_t, cid_t>> &dirty_ranges) {
+  recovered_tile_group_count_ = 0;
 
-  // for now assume that the maximum tile group oid and table tile group
-  // membership info are already set
+  struct stat stat_buf;
+  fstat(layout_file_fd, &stat_buf);
+  size_t file_size = stat_buf.st_size;
+  if (file_size == 0) {
+    return;
+  }
+
+  std::unique_ptr<char[]> file_data(new char[file_size]);
+  fseek(layout_file, 0, SEEK_SET);
+  if (fread(file_data.get(), 1, file_size, layout_file) != file_size) {
+    LOG_ERROR("layout recovery read failed");
+    return;
+  }
+
+  // the last layout of a tile group is the one in use
+  std::map<oid_t, TileGroupLayout> layouts;
+  size_t data_file_end = 0;
+  size_t record_offset = 0;
+  while (record_offset + sizeof(int32_t) <= file_size) {
+    CopySerializeInput length_input(file_data.get() + record_offset,
+                                    sizeof(int32_t));
+    size_t record_size = length_input.ReadInt() + sizeof(int32_t);
+    if (record_offset + record_size > file_size) {
+      break;
+    }
+
+    CopySerializeInput input(file_data.get() + record_offset, record_size);
+    input.ReadInt();
+    TileGroupLayout layout;
+    layout.database_oid = input.ReadInt();
+    layout.table_oid = input.ReadInt();
+    layout.tile_group_id = input.ReadInt();
+    layout.tuple_count = input.ReadInt();
+    layout.header_offset = input.ReadLong();
+    layout.header_size = input.ReadLong();
+    data_file_end =
+        std::max(data_file_end, layout.header_offset + layout.header_size);
+
+    oid_t tile_count = input.ReadInt();
+    layout.tile_columns.resize(tile_count);
+    layout.tile_column_types.resize(tile_count);
+    for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+      oid_t column_count = input.ReadInt();
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        layout.tile_columns[tile_itr].push_back(input.ReadInt());
+        layout.tile_column_types[tile_itr].push_back(
+            static_cast<type::Type::TypeId>(input.ReadInt()));
+      }
+      layout.tile_sizes.push_back(input.ReadLong());
+      layout.tile_offsets.push_back(input.ReadLong());
+      data_file_end = std::max(
+          data_file_end, layout.tile_offsets.back() + layout.tile_sizes.back());
+    }
+
+    layouts[layout.tile_group_id] = std::move(layout);
+    record_offset += record_size;
+  }
+
+  // drop a torn record at the end
+  if (record_offset != file_size) {
+    if (ftruncate(layout_file_fd, record_offset)) {
+      LOG_ERROR("ftruncate failed on layout recovery");
+    }
+  }
+
+  // Nothing may be allocated over the tile groups of the previous runs,
+  // including the ones of dropped tables
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  storage_manager.ReserveDataFile(data_file_end);
+
+  std::unordered_set<storage::DataTable *> recovered_tables;
+  oid_t max_tile_group_id = INVALID_OID;
+  for (auto &layout_entry : layouts) {
+    if (RecoverTileGroup(layout_entry.second, dirty_ranges,
+                         recovered_tables) == true) {
+      recorded_tile_groups_[layout_entry.first] =
+          layout_entry.second.header_offset;
+      recovered_tile_group_count_++;
+      if (max_tile_group_id == INVALID_OID ||
+          max_tile_group_id < layout_entry.first) {
+        max_tile_group_id = layout_entry.first;
+      }
+    }
+  }
+
+  // index the latest versions of the recovered tuples
+  for (auto table : recovered_tables) {
+    table->BulkLoadIndexes();
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  if (max_tile_group_id != INVALID_OID &&
+      max_tile_group_id > manager.GetCurrentTileGroupId()) {
+    manager.SetNextTileGroupId(max_tile_group_id);
+  }
+
+  LOG_INFO("Recovered tile group count : %lu", recovered_tile_group_count_);
+}
+
+bool WriteBehindFrontendLogger::RecoverTileGroup(
+    const TileGroupLayout &layout,
+    const std::vector<std::pair<cid_t, cid_t>> &dirty_ranges,
+    std::unordered_set<storage::DataTable *> &recovered_tables) {
+  storage::DataTable *table = nullptr;
+  try {
+    table = catalog::Catalog::GetInstance()->GetTableWithOid(
+        layout.database_oid, layout.table_oid);
+  } catch (CatalogException &e) {
+    // the table was deleted
+    return false;
+  }
+  auto schema = table->GetSchema();
+
+  // uninlined values only point into the pools of the previous run
+  if (schema->IsInlined() == false) {
+    LOG_ERROR("Cannot recover tile group %u with uninlined columns",
+              layout.tile_group_id);
+    return false;
+  }
+
+  for (oid_t tile_itr = 0; tile_itr < layout.tile_columns.size();
+       tile_itr++) {
+    for (oid_t tile_column_itr = 0;
+         tile_column_itr < layout.tile_columns[tile_itr].size();
+         tile_column_itr++) {
+      auto column_id = layout.tile_columns[tile_itr][tile_column_itr];
+      if (column_id >= schema->GetColumnCount() ||
+          schema->GetType(column_id) !=
+              layout.tile_column_types[tile_itr][tile_column_itr]) {
+        LOG_ERROR("Schema of tile group %u changed", layout.tile_group_id);
+        return false;
+      }
+    }
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(layout.tile_group_id);
+  if (tile_group == nullptr) {
+    table->AddTileGroupWithOidForRecovery(layout.tile_group_id);
+    tile_group = manager.GetTileGroup(layout.tile_group_id);
+  }
+  auto tile_group_header = tile_group->GetHeader();
+
+  // The data can only be adopted by an empty tile group of the same layout,
+  // itself allocated from the data file
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  size_t header_offset;
+  oid_t tile_count = layout.tile_columns.size();
+  bool same_layout =
+      (storage_manager.LocateInDataFile(tile_group_header->GetHeaderData(),
+                                        header_offset) == true &&
+       tile_group_header->GetCurrentNextTupleSlot() == 0 &&
+       tile_group->GetAllocatedTupleCount() == layout.tuple_count &&
+       tile_group_header->GetHeaderSize() == layout.header_size &&
+       tile_group->GetTileCount() == tile_count);
+  for (oid_t tile_itr = 0; same_layout && tile_itr < tile_count; tile_itr++) {
+    auto tile = tile_group->GetTile(tile_itr);
+    same_layout =
+        (tile->GetInlinedSize() == layout.tile_sizes[tile_itr] &&
+         tile->GetColumnCount() == layout.tile_columns[tile_itr].size());
+    for (oid_t tile_column_itr = 0;
+         same_layout && tile_column_itr < layout.tile_columns[tile_itr].size();
+         tile_column_itr++) {
+      oid_t tile_offset, tile_column_id;
+      tile_group->LocateTileAndColumn(
+          layout.tile_columns[tile_itr][tile_column_itr], tile_offset,
+          tile_column_id);
+      same_layout =
+          (tile_offset == tile_itr && tile_column_id == tile_column_itr);
+    }
+  }
+  if (same_layout == false) {
+    LOG_ERROR("Cannot map tile group %u with a different layout",
+              layout.tile_group_id);
+    return false;
+  }
+
+  tile_group_header->AdoptMappedData(reinterpret_cast<char *>(
+      storage_manager.GetDataFileLocation(layout.header_offset)));
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    tile_group->GetTile(tile_itr)->AdoptMappedData(
+        reinterpret_cast<char *>(
+            storage_manager.GetDataFileLocation(layout.tile_offsets[tile_itr])),
+        nullptr);
+  }
+
+  auto is_dirty = [&dirty_ranges](cid_t commit_id) {
+    for (auto &dirty_range : dirty_ranges) {
+      if (commit_id > dirty_range.first && commit_id <= dirty_range.second) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (recovered_tables.insert(table).second == true) {
+    table->SetIndexBuildDeferred(true);
+  }
+
+  oid_t column_count = schema->GetColumnCount();
+  for (oid_t tuple_slot = 0; tuple_slot < layout.tuple_count; tuple_slot++) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot);
+    cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_slot);
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_slot);
+
+    // the slot was never used
+    if (tuple_txn_id == INVALID_TXN_ID && tuple_begin_cid == MAX_CID) {
+      continue;
+    }
+    tile_group_header->GetEmptyTupleSlot(tuple_slot);
+
+    // the indexes and the transactions of the previous run are gone
+    tile_group_header->SetIndirection(tuple_slot, nullptr);
+    PL_MEMSET(tile_group_header->GetReservedFieldRef(tuple_slot), 0,
+              storage::TileGroupHeader::GetReservedSize());
+    if (tuple_txn_id == INVALID_TXN_ID) {
+      continue;
+    }
+
+    // the version of a transaction running at the crash
+    if (tuple_begin_cid == MAX_CID) {
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      continue;
+    }
+    tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+    // only the latest committed version of a tuple is indexed
+    if (is_dirty(tuple_begin_cid) == true ||
+        (tuple_end_cid != MAX_CID && is_dirty(tuple_end_cid) == false)) {
+      continue;
+    }
+
+    storage::Tuple tuple(schema, true);
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      tuple.SetValue(column_itr, tile_group->GetValue(tuple_slot, column_itr));
+    }
+    ItemPointer *indirection = nullptr;
+    table->InsertInIndexes(&tuple,
+                           ItemPointer(layout.tile_group_id, tuple_slot),
+                           nullptr, &indirection);
+    tile_group_header->SetIndirection(tuple_slot, indirection);
+    table->IncreaseTupleCount(1);
+  }
+
+  return true;
 }
 
 std::string WriteBehindFrontendLogger::GetLogFileName(void) {
@@ -170,6 +635,10 @@ std::string WriteBehindFrontendLogger::GetLogFileName(void) {
   return log_manager.GetLogFileName();
 }
 
+std::string WriteBehindFrontendLogger::GetLayoutFileName(void) {
+  return GetLogFileName() + ".layout";
+}
+
 void WriteBehindFrontendLogger::SetLoggerID(UNUSED_ATTRIBUTE int id) {
   // do nothing
 }
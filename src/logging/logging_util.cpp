@@ -287,6 +287,39 @@ storage::Tuple *LoggingUtil::ReadTupleRecordBody(const catalog::Schema *schema,
   return tuple;
 }
 
+storage::Tuple *LoggingUtil::ReadTupleDeltaRecordBody(
+    const catalog::Schema *schema, type::AbstractPool *pool,
+    FileHandle &file_handle, std::vector<oid_t> &column_ids) {
+  // Check if the frame is broken
+  size_t body_size = GetNextFrameSize(file_handle);
+  if (body_size == 0) {
+    LOG_ERROR("Body size is zero ");
+    return nullptr;
+  }
+
+  // Read Body
+  char body[body_size];
+  int ret = fread(body, 1, body_size, file_handle.file);
+  if (ret <= 0) {
+    LOG_ERROR("Error occured in fread ");
+  }
+
+  CopySerializeInput delta_body(body, body_size);
+
+  // The other columns are filled in from the old version during replay
+  storage::Tuple *tuple = new storage::Tuple(schema, true);
+  int16_t column_count = delta_body.ReadShort();
+  for (int16_t column_itr = 0; column_itr < column_count; column_itr++) {
+    oid_t column_id = static_cast<oid_t>(delta_body.ReadShort());
+    type::Value value = type::Value::DeserializeFrom(
+        delta_body, schema->GetType(column_id), pool);
+    tuple->SetValue(column_id, value, pool);
+    column_ids.push_back(column_id);
+  }
+
+  return tuple;
+}
+
 void LoggingUtil::SkipTupleRecordBody(FileHandle &file_handle) {
   // Check if the frame is broken
   size_t body_size = GetNextFrameSize(file_handle);
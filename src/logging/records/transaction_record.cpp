@@ -23,9 +23,8 @@ namespace logging {
  * @brief Serialize given data
  * @return true if we serialize data otherwise false
  */
-bool TransactionRecord::Serialize(CopySerializeOutput &output) {
+bool TransactionRecord::SerializeTo(SerializeOutput &output) {
   bool status = true;
-  output.Reset();
 
   // First, write out the log record type
   output.WriteEnumInSingleByte(log_record_type);
@@ -40,10 +39,6 @@ bool TransactionRecord::Serialize(CopySerializeOutput &output) {
       static_cast<int32_t>(output.Position() - start - sizeof(int32_t));
   output.WriteIntAt(start, header_length);
 
-  message_length = output.Size();
-  message = new char[message_length];
-  PL_MEMCPY(message, output.Data(), message_length);
-
   return status;
 }
 
@@ -23,9 +23,8 @@ namespace logging {
  * @brief Serialize given data
  * @return true if we serialize data otherwise false
  */
-bool TupleRecord::Serialize(CopySerializeOutput &output) {
+bool TupleRecord::SerializeTo(SerializeOutput &output) {
   bool status = true;
-  output.Reset();
 
   // Serialize the common variables such as database oid, table oid, etc.
   SerializeHeader(output);
@@ -39,6 +38,20 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
       break;
     }
 
+    case LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE: {
+      // only the changed columns, each one preceded by its id
+      storage::Tuple *tuple = (storage::Tuple *)data;
+      size_t start = output.ReserveBytes(sizeof(int32_t));
+      output.WriteShort(static_cast<int16_t>(column_ids.size()));
+      for (auto column_id : column_ids) {
+        output.WriteShort(static_cast<int16_t>(column_id));
+        tuple->GetValue(column_id).SerializeTo(output);
+      }
+      output.WriteIntAt(start, static_cast<int32_t>(output.Position() - start -
+                                                    sizeof(int32_t)));
+      break;
+    }
+
     case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
       // Nothing to do here !
       break;
@@ -56,10 +69,6 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
     }
   }
 
-  message_length = output.Size();
-  message = new char[message_length];
-  PL_MEMCPY(message, output.Data(), message_length);
-
   return status;
 }
 
@@ -67,7 +76,7 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
  * @brief Serialize LogRecordHeader
  * @param output
  */
-void TupleRecord::SerializeHeader(CopySerializeOutput &output) {
+void TupleRecord::SerializeHeader(SerializeOutput &output) {
   // Record LogRecordType first
   output.WriteEnumInSingleByte(log_record_type);
 
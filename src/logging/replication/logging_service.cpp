@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logging_service.cpp
+//
+// Identification: src/logging/replication/logging_service.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <mutex>
+#include <thread>
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "logging/log_manager.h"
+#include "logging/replication/logging_service.h"
+#include "logging/replication/replication_sender.h"
+#include "logging/replication/replication_standby.h"
+#include "networking/rpc_server.h"
+
+namespace peloton {
+namespace logging {
+
+void LoggingService::LogRecordReplay(
+    ::google::protobuf::RpcController *controller,
+    const networking::LogRecordReplayRequest *request,
+    networking::LogRecordReplayResponse *response,
+    ::google::protobuf::Closure *done) {
+  if (controller->Failed()) {
+    std::string error = controller->ErrorText();
+    LOG_TRACE("LoggingService with controller failed:%s ", error.c_str());
+  }
+
+  // If request is not null, this is the standby receiving the stream. It
+  // runs the callback once the response is set
+  if (request != NULL) {
+    ReplicationStandby::GetInstance().ReceiveChunk(*request, response, done);
+  }
+  // Here is the primary receiving the acknowledgement of the standby
+  else {
+    auto replication_sender = LogManager::GetInstance().GetReplicationSender();
+    if (replication_sender == nullptr) {
+      LOG_ERROR("Acknowledgement of the standby without a replication stream");
+      return;
+    }
+
+    if (response->has_commit_id()) {
+      replication_sender->Acknowledge(response->sequence_number(),
+                                      response->commit_id());
+    }
+  }
+}
+
+bool LoggingService::StartServer(int port) {
+  static std::mutex server_mutex;
+  static networking::RpcServer *rpc_server = nullptr;
+  static LoggingService *logging_service = nullptr;
+
+  std::lock_guard<std::mutex> server_lock(server_mutex);
+  if (rpc_server != nullptr) {
+    if (rpc_server->GetListener()->GetPort() != port) {
+      LOG_ERROR("Logging service is already served on port %d",
+                rpc_server->GetListener()->GetPort());
+      return false;
+    }
+    return true;
+  }
+
+  // the server registers itself with the connection manager, which then
+  // creates the outgoing connections on its event base as well
+  rpc_server = new networking::RpcServer(port);
+  logging_service = new LoggingService();
+  rpc_server->RegisterService(logging_service);
+
+  std::thread server_thread(&networking::RpcServer::Start, rpc_server);
+  server_thread.detach();
+
+  LOG_INFO("Serving the logging service on port %d", port);
+  return true;
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// replication_sender.cpp
+//
+// Identification: src/logging/replication/replication_sender.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/logger.h"
+#include "logging/replication/replication_sender.h"
+
+namespace peloton {
+namespace logging {
+
+ReplicationSender::ReplicationSender(const std::string &standby_address,
+                                     ReplicationType replication_type)
+    : channel_(standby_address),
+      stub_(&channel_),
+      replication_type_(replication_type) {}
+
+/**
+ * @brief Send a block in chunks of REPLICATION_CHUNK_SIZE. The chunks of a
+ * block share its max commit id, the standby replays the block once it got
+ * the last chunk.
+ */
+void ReplicationSender::SendBlock(const char *data, size_t length,
+                                  cid_t max_commit_id) {
+  if (IsBroken()) {
+    return;
+  }
+
+  networking::LogRecordReplayRequest request;
+  networking::LogRecordReplayResponse response;
+  size_t offset = 0;
+
+  // a block without records still moves the commit id of the standby
+  do {
+    size_t chunk_length = std::min<size_t>(length - offset,
+                                           REPLICATION_CHUNK_SIZE);
+    request.set_log(data + offset, chunk_length);
+    request.set_sync_type(GetResponseType());
+    request.set_sequence_number(next_sequence_number_++);
+    request.set_max_commit_id(max_commit_id);
+    offset += chunk_length;
+    request.set_end_of_block(offset == length);
+
+    stub_.LogRecordReplay(&controller_, &request, &response, NULL);
+
+    if (controller_.Failed()) {
+      LOG_ERROR("Could not send the log to the standby: %s",
+                controller_.ErrorText().c_str());
+      std::lock_guard<std::mutex> ack_lock(ack_mutex_);
+      broken_ = true;
+      ack_cv_.notify_all();
+      return;
+    }
+  } while (offset < length);
+}
+
+void ReplicationSender::Acknowledge(int64_t sequence_number,
+                                    cid_t commit_id) {
+  LOG_TRACE("Standby acknowledged request %ld up to commit id %lu",
+            sequence_number, commit_id);
+
+  std::lock_guard<std::mutex> ack_lock(ack_mutex_);
+  if (commit_id > acknowledged_commit_id_) {
+    acknowledged_commit_id_ = commit_id;
+    ack_cv_.notify_all();
+  }
+}
+
+bool ReplicationSender::WaitForAcknowledgement(cid_t commit_id) {
+  std::unique_lock<std::mutex> ack_lock(ack_mutex_);
+  bool acknowledged = ack_cv_.wait_for(
+      ack_lock, std::chrono::milliseconds(REPLICATION_ACK_TIMEOUT_MS),
+      [this, commit_id] {
+        return broken_ || acknowledged_commit_id_ >= commit_id;
+      });
+
+  if (acknowledged == false) {
+    LOG_ERROR("Standby did not acknowledge commit id %lu, stop replicating",
+              commit_id);
+    broken_ = true;
+    ack_cv_.notify_all();
+  }
+
+  return acknowledged_commit_id_ >= commit_id;
+}
+
+cid_t ReplicationSender::GetAcknowledgedCommitId() {
+  std::lock_guard<std::mutex> ack_lock(ack_mutex_);
+  return acknowledged_commit_id_;
+}
+
+bool ReplicationSender::IsBroken() {
+  std::lock_guard<std::mutex> ack_lock(ack_mutex_);
+  return broken_;
+}
+
+networking::ResponseType ReplicationSender::GetResponseType() const {
+  switch (replication_type_) {
+    case SYNC_REPLICATION:
+      return networking::SYNC;
+    case SEMISYNC_REPLICATION:
+      return networking::SEMISYNC;
+    case ASYNC_REPLICATION:
+    default:
+      return networking::ASYNC;
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
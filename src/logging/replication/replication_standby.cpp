@@ -0,0 +1,195 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// replication_standby.cpp
+//
+// Identification: src/logging/replication/replication_standby.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/log_manager.h"
+#include "logging/loggers/wal_frontend_logger.h"
+#include "logging/replication/logging_service.h"
+#include "logging/replication/replication_standby.h"
+
+namespace peloton {
+namespace logging {
+
+ReplicationStandby &ReplicationStandby::GetInstance() {
+  static ReplicationStandby replication_standby;
+  return replication_standby;
+}
+
+ReplicationStandby::ReplicationStandby()
+    : replayed_commit_id_(ATOMIC_VAR_INIT(0)) {}
+
+ReplicationStandby::~ReplicationStandby() {
+  {
+    std::lock_guard<std::mutex> replay_lock(replay_mutex_);
+    replay_shutdown_ = true;
+    replay_cv_.notify_all();
+  }
+  if (replay_thread_.joinable()) {
+    replay_thread_.join();
+  }
+
+  // the blocks never replayed are not acknowledged
+  for (auto &replay_task : replay_queue_) {
+    if (replay_task.done != nullptr) {
+      replay_task.done->Run();
+    }
+  }
+}
+
+bool ReplicationStandby::Start(int port) {
+  {
+    std::lock_guard<std::mutex> replay_lock(replay_mutex_);
+    if (replay_thread_.joinable() == false) {
+      // the tile groups of the primary are added by the replay
+      LogManager::GetInstance().PrepareRecovery();
+
+      replayer_.reset(new WriteAheadFrontendLogger(true));
+      replay_thread_ = std::thread(&ReplicationStandby::ReplayLoop, this);
+    }
+  }
+
+  return LoggingService::StartServer(port);
+}
+
+/**
+ * @brief Collect the chunks of a block, and queue the block for the replay
+ * once it is complete. The response acknowledges the commit id the standby
+ * got the stream up to. With synchronous replication the replay thread
+ * sends it once it replayed the block, the rpc server does not wait.
+ */
+void ReplicationStandby::ReceiveChunk(
+    const networking::LogRecordReplayRequest &request,
+    networking::LogRecordReplayResponse *response,
+    google::protobuf::Closure *done) {
+  response->set_sequence_number(request.sequence_number());
+
+  block_data_.insert(block_data_.end(), request.log().begin(),
+                     request.log().end());
+  if (request.end_of_block() == false) {
+    if (done) {
+      done->Run();
+    }
+    return;
+  }
+
+  cid_t max_commit_id = request.max_commit_id();
+  bool sync = (request.sync_type() == networking::SYNC && done != nullptr);
+  if (sync == false) {
+    response->set_commit_id(max_commit_id);
+  }
+
+  {
+    std::lock_guard<std::mutex> replay_lock(replay_mutex_);
+    replay_queue_.push_back(ReplayTask{std::move(block_data_), max_commit_id,
+                                       sync ? response : nullptr,
+                                       sync ? done : nullptr});
+    block_data_.clear();
+    replay_cv_.notify_all();
+  }
+
+  if (sync == false && done) {
+    done->Run();
+  }
+}
+
+concurrency::Transaction *ReplicationStandby::BeginSnapshotTransaction(
+    size_t thread_id) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginReadonlyTransaction(thread_id);
+
+  // the commits replayed after it began are not visible to it
+  std::lock_guard<std::mutex> replay_lock(replay_mutex_);
+  txn->SetBeginCommitId(replayed_commit_id_.load());
+  snapshot_commit_ids_.insert(txn->GetBeginCommitId());
+  return txn;
+}
+
+void ReplicationStandby::EndSnapshotTransaction(concurrency::Transaction *txn) {
+  {
+    std::lock_guard<std::mutex> replay_lock(replay_mutex_);
+    auto snapshot_itr = snapshot_commit_ids_.find(txn->GetBeginCommitId());
+    if (snapshot_itr != snapshot_commit_ids_.end()) {
+      snapshot_commit_ids_.erase(snapshot_itr);
+    }
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.CommitTransaction(txn);
+}
+
+cid_t ReplicationStandby::GetOldestSnapshotCommitId() const {
+  if (snapshot_commit_ids_.empty()) {
+    return replayed_commit_id_.load();
+  }
+  return *snapshot_commit_ids_.begin();
+}
+
+bool ReplicationStandby::WaitForReplay(cid_t commit_id, uint64_t timeout_ms) {
+  std::unique_lock<std::mutex> replay_lock(replay_mutex_);
+  return replay_cv_.wait_for(replay_lock, std::chrono::milliseconds(timeout_ms),
+                             [this, commit_id] {
+                               return replayed_commit_id_ >= commit_id;
+                             });
+}
+
+/**
+ * @brief Replay the queued blocks in the order they were received
+ */
+void ReplicationStandby::ReplayLoop() {
+  std::unique_lock<std::mutex> replay_lock(replay_mutex_);
+  while (true) {
+    replay_cv_.wait(replay_lock, [this] {
+      return replay_shutdown_ || replay_queue_.empty() == false;
+    });
+    if (replay_shutdown_) {
+      break;
+    }
+
+    ReplayTask replay_task = std::move(replay_queue_.front());
+    replay_queue_.pop_front();
+    replay_lock.unlock();
+
+    replayer_->ReplayLogBlock(replay_task.data.data(), replay_task.data.size(),
+                              replay_task.max_commit_id);
+    LOG_TRACE("Replayed a block of %lu bytes up to commit id %lu",
+              replay_task.data.size(), replay_task.max_commit_id);
+
+    replay_lock.lock();
+    if (replay_task.max_commit_id > replayed_commit_id_) {
+      replayed_commit_id_ = replay_task.max_commit_id;
+    }
+    cid_t oldest_commit_id = GetOldestSnapshotCommitId();
+    replay_cv_.notify_all();
+    replay_lock.unlock();
+
+    // snapshots begun from now on do not read below the oldest one
+    UNUSED_ATTRIBUTE size_t recycled_count =
+        replayer_->RecycleEndedVersions(oldest_commit_id);
+    LOG_TRACE("Recycled %lu versions ended up to commit id %lu",
+              recycled_count, oldest_commit_id);
+
+    // the synchronous acknowledgement of the block
+    if (replay_task.done != nullptr) {
+      replay_task.response->set_commit_id(replayed_commit_id_);
+      replay_task.done->Run();
+    }
+
+    replay_lock.lock();
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -67,7 +67,11 @@ void RunBenchmark() {
   //===--------------------------------------------------------------------===//
   // WAL
   //===--------------------------------------------------------------------===//
-  if (logging::LoggingUtil::IsBasedOnWriteAheadLogging(peloton_logging_mode)) {
+  if (IsSweep(state)) {
+    // Run the workload for every group commit setting
+    RunSweep();
+  }
+  else if (logging::LoggingUtil::IsBasedOnWriteAheadLogging(peloton_logging_mode)) {
     // Prepare a simple log file
     PrepareLogFile();
 
@@ -78,8 +82,6 @@ void RunBenchmark() {
   // WBL
   //===--------------------------------------------------------------------===//
   else if (logging::LoggingUtil::IsBasedOnWriteBehindLogging(peloton_logging_mode)) {
-    LOG_ERROR("currently, we do not support write behind logging.");
-    PL_ASSERT(false);
     // Test a simple log process
     PrepareLogFile();
 
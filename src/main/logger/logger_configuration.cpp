@@ -13,6 +13,7 @@
 
 #include <iomanip>
 #include <algorithm>
+#include <sstream>
 #include <sys/stat.h>
 
 #include "common/exception.h"
@@ -42,7 +43,12 @@ void Usage(FILE* out) {
           "   -v --flush-mode        :  Flush mode \n"
           "   -r --commit-interval   :  Group commit interval \n"
           "   -j --log-dir           :  Log directory\n"
-          "   -y --benchmark-type    :  Benchmark type \n");
+          "   -y --benchmark-type    :  Benchmark type \n"
+          "   -R --sweep-commit-intervals :  Group commit intervals to sweep, "
+          "comma separated \n"
+          "   -B --sweep-backend-counts   :  Backend counts to sweep, "
+          "comma separated \n"
+          "   -O --sweep-output-file      :  CSV file of the sweep \n");
 }
 
 static struct option opts[] = {
@@ -56,8 +62,23 @@ static struct option opts[] = {
     {"commit-interval", optional_argument, NULL, 'r'},
     {"benchmark-type", optional_argument, NULL, 'y'},
     {"log-dir", optional_argument, NULL, 'j'},
+    {"sweep-commit-intervals", optional_argument, NULL, 'R'},
+    {"sweep-backend-counts", optional_argument, NULL, 'B'},
+    {"sweep-output-file", optional_argument, NULL, 'O'},
     {NULL, 0, NULL, 0}};
 
+static std::vector<int> ParseList(const char* list) {
+  std::vector<int> values;
+  std::stringstream stream(list);
+  std::string value;
+  while (std::getline(stream, value, ',')) {
+    if (!value.empty()) {
+      values.push_back(atoi(value.c_str()));
+    }
+  }
+  return values;
+}
+
 static void ValidateLoggingType(const configuration& state) {
   if (state.logging_type <= LoggingType::INVALID) {
     LOG_ERROR("Invalid logging_type :: %d", static_cast<int>(state.logging_type));
@@ -219,6 +240,34 @@ static void ValidateLogFileDir(configuration& state) {
   LOG_INFO("log_file_dir :: %s", state.log_file_dir.c_str());
 }
 
+static void ValidateSweep(const configuration& state) {
+  for (auto commit_interval : state.sweep_commit_intervals) {
+    if (commit_interval < 0) {
+      LOG_ERROR("Invalid sweep commit interval :: %d", commit_interval);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  for (auto backend_count : state.sweep_backend_counts) {
+    if (backend_count <= 0) {
+      LOG_ERROR("Invalid sweep backend count :: %d", backend_count);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if (IsSweep(state)) {
+    LOG_INFO("sweep :: %lu commit intervals, %lu backend counts, output %s",
+             state.sweep_commit_intervals.size(),
+             state.sweep_backend_counts.size(),
+             state.sweep_output_file.c_str());
+  }
+}
+
+bool IsSweep(const configuration& state) {
+  return !state.sweep_commit_intervals.empty() ||
+         !state.sweep_backend_counts.empty();
+}
+
 void ParseArguments(int argc, char* argv[], configuration& state) {
   // Default Logger Values
   state.logging_type = LoggingType::SSD_WAL;
@@ -233,6 +282,7 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   state.pcommit_latency = 0;
   state.asynchronous_mode = ASYNCHRONOUS_TYPE_SYNC;
   state.checkpoint_type = CheckpointType::INVALID;
+  state.sweep_output_file = "outputfile-log-sweep.csv";
 
   // YCSB Default Values
   ycsb::state.index = IndexType::BWTREE;
@@ -265,10 +315,11 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   // Parse args
   while (1) {
     int idx = 0;
-    // logger - hs:x:f:l:t:q:v:r:y:
+    // logger - hs:x:f:l:t:q:v:r:y:j:R:B:O:
     // ycsb   - hemgi:k:d:p:b:c:o:u:z:n:
     // tpcc   - heagi:k:d:p:b:w:n:
-    int c = getopt_long(argc, argv, "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:",
+    int c = getopt_long(argc, argv,
+                        "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:R:B:O:",
                         opts, &idx);
 
     if (c == -1) break;
@@ -304,6 +355,15 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
       case 'y':
         state.benchmark_type = (BenchmarkType)atoi(optarg);
         break;
+      case 'R':
+        state.sweep_commit_intervals = ParseList(optarg);
+        break;
+      case 'B':
+        state.sweep_backend_counts = ParseList(optarg);
+        break;
+      case 'O':
+        state.sweep_output_file = optarg;
+        break;
 
       case 'i': {
         char *index = optarg;
@@ -386,11 +446,11 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
     }
   }
 
-  if (state.checkpoint_type == CheckpointType::NORMAL &&
+  if (state.checkpoint_type != CheckpointType::INVALID &&
       (state.logging_type == LoggingType::NVM_WAL ||
        state.logging_type == LoggingType::SSD_WAL ||
        state.logging_type == LoggingType::HDD_WAL)) {
-    peloton_checkpoint_mode = CheckpointType::NORMAL;
+    peloton_checkpoint_mode = state.checkpoint_type;
   }
 
   // Print Logger configuration
@@ -404,6 +464,7 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   ValidateFlushMode(state);
   ValidateNVMLatency(state);
   ValidatePCOMMITLatency(state);
+  ValidateSweep(state);
 
   // Print YCSB configuration
   if (state.benchmark_type == BENCHMARK_TYPE_YCSB) {
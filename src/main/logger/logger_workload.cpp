@@ -14,6 +14,8 @@
 #include <getopt.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
+#include <fstream>
 #include <string>
 #include <thread>
 
@@ -46,6 +48,8 @@
 
 extern peloton::CheckpointType peloton_checkpoint_mode;
 
+extern int64_t peloton_wait_timeout;
+
 namespace peloton {
 namespace benchmark {
 namespace logger {
@@ -65,6 +69,10 @@ namespace logger {
 #define LOGGING_TESTS_DATABASE_OID 20000
 #define LOGGING_TESTS_TABLE_OID 10000
 
+// fsyncs and bytes logged while loading the database, not counted by a sweep
+static size_t load_fsync_count = 0;
+static size_t load_logged_bytes = 0;
+
 void WriteOutput() {
   std::ofstream out("outputfile-log.summary");
   LOG_INFO("----------------------------------------------------------");
@@ -256,8 +264,9 @@ bool PrepareLogFile() {
         state.log_file_dir + "/" +
         logging::WriteAheadFrontendLogger::wal_directory_path);
   } else {
-    LOG_ERROR("currently, we do not support write behind logging.");
-    PL_ASSERT(false);
+    log_manager.SetLogFileName(
+        state.log_file_dir + "/" +
+        logging::WriteBehindFrontendLogger::wbl_log_path);
   }
 
   UNUSED_ATTRIBUTE auto& checkpoint_manager =
@@ -406,16 +415,152 @@ void BuildLog() {
 
     ycsb::LoadYCSBDatabase();
 
+    MarkLoadDone();
+
     ycsb::RunWorkload();
   } else if (state.benchmark_type == BENCHMARK_TYPE_TPCC) {
     tpcc::CreateTPCCDatabase();
 
     tpcc::LoadTPCCDatabase();
 
+    MarkLoadDone();
+
     tpcc::RunWorkload();
   }
 }
 
+void MarkLoadDone() {
+  auto& log_manager = logging::LogManager::GetInstance();
+
+  // Drop the commits of the loader
+  log_manager.CollectCommitLatencies();
+
+  load_fsync_count = log_manager.GetFsyncCount();
+  load_logged_bytes = log_manager.GetLoggedBytes();
+}
+
+//===--------------------------------------------------------------------===//
+// GROUP COMMIT SWEEP
+//===--------------------------------------------------------------------===//
+
+static double GetPercentile(const std::vector<uint64_t>& sorted_latencies,
+                            double percentile) {
+  if (sorted_latencies.empty()) {
+    return 0;
+  }
+
+  size_t rank = static_cast<size_t>(percentile * sorted_latencies.size());
+  rank = std::min(rank, sorted_latencies.size() - 1);
+  return sorted_latencies[rank];
+}
+
+static void SetBackendCount(int backend_count) {
+  if (state.benchmark_type == BENCHMARK_TYPE_YCSB) {
+    ycsb::state.backend_count = backend_count;
+  } else if (state.benchmark_type == BENCHMARK_TYPE_TPCC) {
+    tpcc::state.backend_count = backend_count;
+  }
+}
+
+static int GetBackendCount() {
+  if (state.benchmark_type == BENCHMARK_TYPE_YCSB) {
+    return ycsb::state.backend_count;
+  } else if (state.benchmark_type == BENCHMARK_TYPE_TPCC) {
+    return tpcc::state.backend_count;
+  }
+  return 0;
+}
+
+/**
+ * @brief run the workload once for every group commit interval and backend
+ * count, and write the commit latency and log volume of each run
+ */
+void RunSweep() {
+  auto& log_manager = logging::LogManager::GetInstance();
+
+  std::vector<int> commit_intervals = state.sweep_commit_intervals;
+  if (commit_intervals.empty()) {
+    commit_intervals.push_back(state.wait_timeout);
+  }
+
+  std::vector<int> backend_counts = state.sweep_backend_counts;
+  if (backend_counts.empty()) {
+    backend_counts.push_back(GetBackendCount());
+  }
+
+  std::ofstream out(state.sweep_output_file);
+  out << "benchmark,logging_type,asynchronous_mode,commit_interval_us,"
+         "backend_count,throughput,abort_rate,latency_p50_us,latency_p99_us,"
+         "latency_p999_us,fsyncs_per_sec,bytes_per_txn\n";
+
+  log_manager.SetCommitLatencyTracking(true);
+
+  for (auto commit_interval : commit_intervals) {
+    for (auto backend_count : backend_counts) {
+      // The frontend logger reads the interval when it is constructed
+      state.wait_timeout = commit_interval;
+      peloton_wait_timeout = commit_interval;
+      SetBackendCount(backend_count);
+
+      load_fsync_count = 0;
+      load_logged_bytes = 0;
+
+      if (PrepareLogFile() == false) {
+        LOG_ERROR("Failed to run sweep :: interval %d backends %d",
+                  commit_interval, backend_count);
+        break;
+      }
+
+      double throughput = 0;
+      double abort_rate = 0;
+      double duration = 0;
+      if (state.benchmark_type == BENCHMARK_TYPE_YCSB) {
+        throughput = ycsb::state.throughput;
+        abort_rate = ycsb::state.abort_rate;
+        duration = ycsb::state.duration;
+      } else if (state.benchmark_type == BENCHMARK_TYPE_TPCC) {
+        throughput = tpcc::state.throughput;
+        abort_rate = tpcc::state.abort_rate;
+        duration = tpcc::state.duration;
+      }
+
+      auto latencies = log_manager.CollectCommitLatencies();
+      std::sort(latencies.begin(), latencies.end());
+
+      size_t fsync_count = log_manager.GetFsyncCount() - load_fsync_count;
+      size_t logged_bytes = log_manager.GetLoggedBytes() - load_logged_bytes;
+      double txn_count = throughput * duration;
+
+      double fsyncs_per_sec = (duration > 0) ? fsync_count / duration : 0;
+      double bytes_per_txn = (txn_count > 0) ? logged_bytes / txn_count : 0;
+
+      LOG_INFO("sweep :: interval %d backends %d throughput %lf p99 %lf us",
+               commit_interval, backend_count, throughput,
+               GetPercentile(latencies, 0.99));
+
+      out << state.benchmark_type << ",";
+      out << LoggingTypeToString(state.logging_type) << ",";
+      out << state.asynchronous_mode << ",";
+      out << commit_interval << ",";
+      out << backend_count << ",";
+      out << throughput << ",";
+      out << abort_rate << ",";
+      out << GetPercentile(latencies, 0.5) << ",";
+      out << GetPercentile(latencies, 0.99) << ",";
+      out << GetPercentile(latencies, 0.999) << ",";
+      out << fsyncs_per_sec << ",";
+      out << bytes_per_txn << "\n";
+      out.flush();
+
+      // Start the next run with fresh frontend loggers
+      log_manager.ResetLogStatus();
+      log_manager.DropFrontendLoggers();
+    }
+  }
+
+  log_manager.SetCommitLatencyTracking(false);
+}
+
 }  // namespace logger
 }  // namespace benchmark
 }  // namespace peloton
@@ -37,7 +37,8 @@ void RunBenchmark() {
   if (state.gc_mode == false) {
     gc::GCManagerFactory::Configure(0);
   } else {
-    gc::GCManagerFactory::Configure(state.gc_backend_count);
+    gc::GCManagerFactory::Configure(state.gc_backend_count,
+                                    state.gc_cooperative);
   }
 
   concurrency::EpochManagerFactory::Configure(state.epoch);
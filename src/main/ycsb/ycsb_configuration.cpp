@@ -40,6 +40,7 @@ void Usage(FILE *out) {
           "   -m --string_mode       :  store strings \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -G --gc_cooperative    :  backends collect garbage at commit \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
   );
@@ -59,6 +60,7 @@ static struct option opts[] = {
     { "string_mode", no_argument, NULL, 'm' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "gc_cooperative", no_argument, NULL, 'G' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
     { NULL, 0, NULL, 0 }
@@ -172,6 +174,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.scan_only = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.gc_cooperative = false;
   state.loader_count = 1;
   state.index_scan = true;
   state.layout_mode = LAYOUT_TYPE_ROW;// LAYOUT_TYPE_COLUMN LAYOUT_TYPE_ROW LAYOUT_TYPE_HYBRID
@@ -183,7 +186,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:s:r:k:d:p:b:c:o:u:z:n:l:y:a:S:D:N:R:I:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgGi:s:r:k:d:p:b:c:o:u:z:n:l:y:a:S:D:N:R:I:", opts, &idx);
 
     if (c == -1) break;
 
@@ -271,6 +274,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'n':
         state.gc_backend_count = atoi(optarg);
         break;
+      case 'G':
+        state.gc_cooperative = true;
+        break;
         
       case 'h':
         Usage(stderr);
@@ -300,6 +306,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
   LOG_TRACE("%s : %d", "Run string mode", state.string_mode);
   LOG_TRACE("%s : %d", "Run garbage collection", state.gc_mode);
+  LOG_TRACE("%s : %d", "Run cooperative garbage collection",
+            state.gc_cooperative);
   
 }
 
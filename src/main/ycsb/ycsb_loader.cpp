@@ -216,6 +216,9 @@ void LoadYCSBDatabase() {
   const int tuple_count = state.scale_factor * 1000;
   int row_per_thread = tuple_count / state.loader_count;
 
+  // Indexes are built in bulk once all rows have been loaded
+  user_table->SetIndexBuildDeferred(true);
+
   std::vector<std::unique_ptr<std::thread>> load_threads(state.loader_count);
 
   for (int thread_id = 0; thread_id < state.loader_count - 1; ++thread_id) {
@@ -233,6 +236,8 @@ void LoadYCSBDatabase() {
     load_threads[thread_id]->join();
   }
 
+  user_table->BulkLoadIndexes();
+
   std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
   double diff = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
   LOG_INFO("database table loading time = %lf ms", diff);
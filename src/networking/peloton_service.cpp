@@ -326,6 +326,9 @@ void PelotonService::QueryPlan(::google::protobuf::RpcController* controller,
 
     if (!request->has_plan_type()) {
       LOG_ERROR("Queryplan recived desen't have type");
+      if (done) {
+        done->Run();
+      }
       return;
     }
 
@@ -371,6 +374,9 @@ void PelotonService::QueryPlan(::google::protobuf::RpcController* controller,
         if (tuple_count < 0) {
           // ExecutePlan fails
           LOG_ERROR("ExecutePlan fails");
+          if (done) {
+            done->Run();
+          }
           return;
         }
 
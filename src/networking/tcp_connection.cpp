@@ -33,6 +33,36 @@ struct total_processed {
   size_t n;
 };
 
+/*
+ * ResponseClosure sends the response of a request when the rpc method runs
+ * it. A method may keep it and run it later from another thread, so the
+ * connection is looked up again then, the other side may have closed it.
+ */
+class ResponseClosure : public google::protobuf::Closure {
+ public:
+  ResponseClosure(const NetworkAddress &addr, uint64_t opcode,
+                  google::protobuf::Message *request,
+                  google::protobuf::Message *response)
+      : addr_(addr), opcode_(opcode), request_(request), response_(response) {}
+
+  void Run() {
+    Connection *conn = ConnectionManager::GetInstance().FindConn(addr_);
+    if (conn == NULL) {
+      LOG_TRACE("Connection closed before the response was sent");
+    } else {
+      conn->SendResponse(opcode_, *response_);
+    }
+
+    delete this;
+  }
+
+ private:
+  NetworkAddress addr_;
+  uint64_t opcode_;
+  std::unique_ptr<google::protobuf::Message> request_;
+  std::unique_ptr<google::protobuf::Message> response_;
+};
+
 /*
  * A connection includes a bufferevent which must be specified THREAD-SAFE
  */
@@ -176,40 +206,11 @@ void *Connection::ProcessMessage(void *connection) {
         message->ParseFromArray(buf + HEADERLEN + TYPELEN + OPCODELEN,
                                 msg_len - TYPELEN - OPCODELEN);
 
-        // Invoke rpc call.
-        rpc_method->service_->CallMethod(method, &controller, message, response,
-                                         NULL);
-
-        // Send back the response message. The message has been set up when
-        // executing rpc method
-        msg_len = response->ByteSize() + OPCODELEN + TYPELEN;
-
-        char send_buf[sizeof(msg_len) + msg_len];
-        PL_ASSERT(sizeof(msg_len) == HEADERLEN);
-
-        // copy the header into the buf
-        PL_MEMCPY(send_buf, &msg_len, sizeof(msg_len));
-
-        // copy the type into the buf
-        type = MSG_TYPE_REP;
-
-        PL_ASSERT(sizeof(type) == TYPELEN);
-        PL_MEMCPY(send_buf + HEADERLEN, &type, TYPELEN);
-
-        // copy the opcode into the buf
-        PL_ASSERT(sizeof(opcode) == OPCODELEN);
-        PL_MEMCPY(send_buf + HEADERLEN + TYPELEN, &opcode, OPCODELEN);
-
-        // call protobuf to serialize the request message into sending buf
-        response->SerializeToArray(send_buf + HEADERLEN + TYPELEN + OPCODELEN,
-                                   msg_len);
-
-        // send data
-        // Note: if we use raw socket send api, we should loop send
-        conn->AddToWriteBuffer(send_buf, HEADERLEN + msg_len);
-
-        delete message;
-        delete response;
+        // Invoke rpc call. The response message is sent back once the method
+        // runs done, which owns the request and the response
+        rpc_method->service_->CallMethod(
+            method, &controller, message, response,
+            new ResponseClosure(conn->GetAddr(), opcode, message, response));
 
       } break;
 
@@ -220,7 +221,8 @@ void *Connection::ProcessMessage(void *connection) {
         google::protobuf::Message *message = rpc_method->response_->New();
 
         // Deserialize the receiving message
-        message->ParseFromArray(buf + HEADERLEN + TYPELEN + OPCODELEN, msg_len);
+        message->ParseFromArray(buf + HEADERLEN + TYPELEN + OPCODELEN,
+                                msg_len - TYPELEN - OPCODELEN);
 
         // Invoke rpc call. request is null
         rpc_method->service_->CallMethod(method, &controller, NULL, message,
@@ -268,6 +270,38 @@ void *Connection::ProcessMessage(void *connection) {
   return NULL;
 }
 
+/*
+ * Send the response message of a request
+ */
+void Connection::SendResponse(uint64_t opcode,
+                              const google::protobuf::Message &response) {
+  uint32_t msg_len = response.ByteSize() + OPCODELEN + TYPELEN;
+
+  char send_buf[sizeof(msg_len) + msg_len];
+  PL_ASSERT(sizeof(msg_len) == HEADERLEN);
+
+  // copy the header into the buf
+  PL_MEMCPY(send_buf, &msg_len, sizeof(msg_len));
+
+  // copy the type into the buf
+  uint16_t type = MSG_TYPE_REP;
+
+  PL_ASSERT(sizeof(type) == TYPELEN);
+  PL_MEMCPY(send_buf + HEADERLEN, &type, TYPELEN);
+
+  // copy the opcode into the buf
+  PL_ASSERT(sizeof(opcode) == OPCODELEN);
+  PL_MEMCPY(send_buf + HEADERLEN + TYPELEN, &opcode, OPCODELEN);
+
+  // call protobuf to serialize the response message into sending buf
+  response.SerializeToArray(send_buf + HEADERLEN + TYPELEN + OPCODELEN,
+                            msg_len);
+
+  // send data
+  // Note: if we use raw socket send api, we should loop send
+  AddToWriteBuffer(send_buf, HEADERLEN + msg_len);
+}
+
 /*
  * ReadCb is invoked when there is new data coming.
  */
@@ -282,20 +316,11 @@ void Connection::ReadCb(UNUSED_ATTRIBUTE struct bufferevent *bev, void *ctx) {
 
   /*
    * Process the message will invoke rpc call.
-   * Note: this might take a long time. So we put this in a thread
-   */
-
-  /* prepaere workers_thread to send and recv data */
-  std::function<void()> worker_conn =
-      std::bind(&Connection::ProcessMessage, conn);
-
-  /*
-   * Add workers to thread pool to send and recv data
-   * Note: after AddTask, ReadCb will return and another
-   * request on this connection can be processed while
-   * the former is still being processed
+   * Note: there is no thread pool to hand the message to, so it is processed
+   *       in the event loop. The messages of a connection are then handled
+   *       in the order they arrived, which the replication stream relies on
    */
-  //PthreadThreadPool::GetInstance().AddTask(worker_conn);
+  Connection::ProcessMessage(conn);
 }
 
 /*
@@ -96,12 +96,8 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
         for (auto column_name : create_plan->GetIndexAttributes()) {
           column_ids.push_back(schema->GetColumnID(column_name));
         }
-        // Create a plan to retrieve data
-        std::unique_ptr<planner::AbstractPlan> child_SeqScanPlan =
-            CreateScanPlan(target_table, column_ids, nullptr, false);
-        child_SeqScanPlan->AddChild(std::move(child_plan));
-        child_plan = std::move(child_SeqScanPlan);
-        // Create a plan to add data to index
+        // Create a plan to add data to index. It reads the tile groups of
+        // the table itself, so no scan is needed below it
         std::unique_ptr<planner::AbstractPlan> child_PopulateIndexPlan(
             new planner::PopulateIndexPlan(target_table, column_ids));
         child_PopulateIndexPlan->AddChild(std::move(child_plan));
@@ -45,16 +45,23 @@ ProjectInfo::~ProjectInfo() {
  * @param tuple1  Source tuple 1.
  * @param tuple2  Source tuple 2.
  * @param econtext  ExecutorContext for expression evaluation.
+ * @param skipped_targets  Targets the caller evaluated itself, if not null.
  */
 bool ProjectInfo::Evaluate(storage::Tuple *dest, const AbstractTuple *tuple1,
                            const AbstractTuple *tuple2,
-                           executor::ExecutorContext *econtext) const {
+                           executor::ExecutorContext *econtext,
+                           const std::vector<bool> *skipped_targets) const {
   // Get varlen pool
   type::AbstractPool *pool = nullptr;
   if (econtext != nullptr) pool = econtext->GetPool();
 
   // (A) Execute target list
-  for (auto target : target_list_) {
+  for (size_t target_idx = 0; target_idx < target_list_.size();
+       target_idx++) {
+    if (skipped_targets != nullptr && (*skipped_targets)[target_idx]) {
+      continue;
+    }
+    auto &target = target_list_[target_idx];
     auto col_id = target.first;
     auto expr = target.second;
     auto value = expr->Evaluate(tuple1, tuple2, econtext);
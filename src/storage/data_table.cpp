@@ -11,13 +11,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <thread>
 #include <utility>
 
 #include "brain/clusterer.h"
 #include "brain/sample.h"
 #include "catalog/catalog.h"
 #include "catalog/foreign_key.h"
+#include "common/container_tuple.h"
 #include "common/exception.h"
 #include "common/exception.h"
 #include "common/logger.h"
@@ -650,6 +654,11 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
     AddDefaultIndirectionArray(active_indirection_array_id);
   }
 
+  // Indexes are bulk loaded once the table has been loaded
+  if (index_build_deferred_ == true) {
+    return true;
+  }
+
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -747,6 +756,9 @@ bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
       continue;
     }
 
+    // Entries of this version chain no longer all hold the latest values
+    index->MarkCoveredUpdate(index_entry_ptr);
+
     // Key attributes are updated, insert a new entry in all secondary index
     std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
 
@@ -999,6 +1011,26 @@ void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
 
 size_t DataTable::GetTileGroupCount() const { return tile_group_count_; }
 
+void DataTable::ReleaseTileGroup(const oid_t &tile_group_id) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    return;
+  }
+
+  PL_ASSERT(tile_group->GetHeader()->IsRetired() == true);
+
+  // a single unused slot, such that scans see no tuples
+  std::shared_ptr<TileGroup> empty_tile_group(
+      AbstractTable::GetTileGroupWithLayout(database_oid, tile_group_id,
+                                            tile_group->GetColumnMap(), 1));
+  empty_tile_group->GetHeader()->Retire();
+
+  manager.AddTileGroup(tile_group_id, empty_tile_group);
+
+  LOG_TRACE("Released tile group : %u ", tile_group_id);
+}
+
 std::shared_ptr<storage::TileGroup> DataTable::GetTileGroup(
     const std::size_t &tile_group_offset) const {
   PL_ASSERT(tile_group_offset < GetTileGroupCount());
@@ -1145,6 +1177,131 @@ oid_t DataTable::GetValidIndexCount() const {
   return valid_index_count;
 }
 
+bool DataTable::PopulateIndex(index::Index *index, const size_t begin_offset,
+                              const size_t end_offset,
+                              const size_t worker_count,
+                              const bool concurrent) {
+  if (begin_offset >= end_offset) {
+    return true;
+  }
+
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+  size_t tile_group_count = end_offset - begin_offset;
+
+  size_t thread_count = worker_count;
+  if (thread_count == 0) {
+    thread_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+  thread_count = std::min(thread_count, tile_group_count);
+
+  // Each worker owns the keys it built and the entries pointing to them
+  std::vector<std::vector<std::unique_ptr<storage::Tuple>>> worker_keys(
+      thread_count);
+  std::vector<std::vector<std::pair<const storage::Tuple *, ItemPointer *>>>
+      worker_entries(thread_count);
+  std::unique_ptr<std::atomic<bool>[]> worker_results(
+      new std::atomic<bool>[thread_count]);
+
+  auto populate_worker = [&](const size_t worker_id) {
+    auto &keys = worker_keys[worker_id];
+    auto &entries = worker_entries[worker_id];
+    worker_results[worker_id] = true;
+
+    // Workers take contiguous ranges of tile groups
+    size_t worker_begin =
+        begin_offset + (tile_group_count * worker_id) / thread_count;
+    size_t worker_end =
+        begin_offset + (tile_group_count * (worker_id + 1)) / thread_count;
+
+    for (size_t offset = worker_begin; offset < worker_end; offset++) {
+      auto tile_group = GetTileGroup(offset);
+      auto tile_group_id = tile_group->GetTileGroupId();
+      auto tile_group_header = tile_group->GetHeader();
+      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+        // Only index the head of each version chain, which is the version
+        // the indirection points to. Uncommitted heads are indexed as well,
+        // readers check visibility through the version chain anyway.
+        ItemPointer *indirection = tile_group_header->GetIndirection(tuple_id);
+        if (indirection == nullptr || indirection->block != tile_group_id ||
+            indirection->offset != tuple_id) {
+          continue;
+        }
+        if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID ||
+            tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+          continue;
+        }
+
+        expression::ContainerTuple<storage::TileGroup> container_tuple(
+            tile_group.get(), tuple_id);
+
+        std::unique_ptr<storage::Tuple> key(
+            new storage::Tuple(index_schema, true));
+        key->SetFromTuple(&container_tuple, indexed_columns, index->GetPool());
+
+        entries.emplace_back(key.get(), indirection);
+        keys.push_back(std::move(key));
+      }
+    }
+
+    if (concurrent == true) {
+      worker_results[worker_id] = index->BulkInsertEntries(entries, true);
+    }
+  };
+
+  std::vector<std::thread> worker_threads;
+  for (size_t worker_id = 1; worker_id < thread_count; worker_id++) {
+    worker_threads.emplace_back(populate_worker, worker_id);
+  }
+  populate_worker(0);
+  for (auto &worker_thread : worker_threads) {
+    worker_thread.join();
+  }
+
+  if (concurrent == true) {
+    for (size_t worker_id = 0; worker_id < thread_count; worker_id++) {
+      if (worker_results[worker_id] == false) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Merge the runs of all workers into a single batch
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+  for (auto &run : worker_entries) {
+    entries.insert(entries.end(), run.begin(), run.end());
+  }
+
+  LOG_DEBUG("Bulk loading %lu entries into index %s", entries.size(),
+            index->GetName().c_str());
+
+  return index->BulkInsertEntries(entries);
+}
+
+bool DataTable::BulkLoadIndexes() {
+  bool res = true;
+
+  size_t index_count = GetIndexCount();
+  for (size_t index_itr = 0; index_itr < index_count; index_itr++) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr) {
+      continue;
+    }
+
+    if (BulkLoadIndex(index.get()) == false) {
+      LOG_ERROR("Failed to bulk load index %s", index->GetName().c_str());
+      res = false;
+    }
+  }
+
+  index_build_deferred_ = false;
+
+  return res;
+}
+
 //===--------------------------------------------------------------------===//
 // FOREIGN KEYS
 //===--------------------------------------------------------------------===//
@@ -333,7 +333,11 @@ StorageManager::StorageManager()
     Func_drain = drain_pcommit;
   }
 
-  // Rest of this stuff is needed only for Write Behind Logging
+  MapDataFile();
+}
+
+void StorageManager::MapDataFile() {
+  // The data file is needed only for Write Behind Logging
   int data_fd;
   std::string data_file_name;
   struct stat data_stat;
@@ -395,9 +399,11 @@ StorageManager::StorageManager()
 
   LOG_TRACE("DATA DIR :: %s ", data_file_name.c_str());
 
-  // Create a data file
+  // Create the data file, or open the one left by a previous run. Recovery
+  // maps the tile groups it holds back into their tables, and reserves
+  // their space before anything else is allocated.
   if ((data_fd = open(
-           data_file_name.c_str(), O_CREAT | O_TRUNC | O_RDWR,
+           data_file_name.c_str(), O_CREAT | O_RDWR,
            S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH)) < 0) {
     perror(data_file_name.c_str());
     exit(EXIT_FAILURE);
@@ -423,9 +429,6 @@ StorageManager::StorageManager()
 StorageManager::~StorageManager() {
   LOG_TRACE("Allocation count : %ld \n", allocation_count);
 
-  // Check if we need a PMEM pool
-  if (peloton_logging_mode != LoggingType::NVM_WBL) return;
-
   // sync and unmap the data file
   if (data_file_address != nullptr) {
     // sync the mmap'ed file to SSD or HDD
@@ -460,6 +463,12 @@ void *StorageManager::Allocate(BackendType type, size_t size) {
         // Lock the file
         data_file_spinlock.Lock();
 
+        // The logging mode may have been set after the storage manager was
+        // created
+        if (data_file_address == nullptr) {
+          MapDataFile();
+        }
+
         // Check if within bounds
         if (data_file_offset < data_file_len) {
           cache_data_file_offset = data_file_offset;
@@ -492,6 +501,43 @@ void *StorageManager::Allocate(BackendType type, size_t size) {
   }
 }
 
+bool StorageManager::LocateInDataFile(const void *address,
+                                      size_t &offset) const {
+  auto location = reinterpret_cast<const char *>(address);
+  auto data_file_begin = reinterpret_cast<const char *>(data_file_address);
+  if (data_file_address == nullptr || location < data_file_begin ||
+      location >= data_file_begin + data_file_len) {
+    return false;
+  }
+
+  offset = location - data_file_begin;
+  return true;
+}
+
+void *StorageManager::GetDataFileLocation(size_t offset) {
+  data_file_spinlock.Lock();
+  if (data_file_address == nullptr) {
+    MapDataFile();
+  }
+  data_file_spinlock.Unlock();
+
+  if (offset >= data_file_len) {
+    throw Exception("offset beyond the data file: offset : " +
+                    std::to_string(offset) + " length : " +
+                    std::to_string(data_file_len));
+  }
+
+  return reinterpret_cast<char *>(data_file_address) + offset;
+}
+
+void StorageManager::ReserveDataFile(size_t end_offset) {
+  data_file_spinlock.Lock();
+  if (data_file_offset < end_offset) {
+    data_file_offset = end_offset;
+  }
+  data_file_spinlock.Unlock();
+}
+
 void StorageManager::Release(BackendType type, void *address) {
   switch (type) {
     case BackendType::MM:
@@ -527,8 +573,14 @@ void StorageManager::Sync(BackendType type, void *address, size_t length) {
 
     case BackendType::SSD:
     case BackendType::HDD: {
-      // sync the mmap'ed file to SSD or HDD
-      int status = msync(data_file_address, data_file_len, MS_SYNC);
+      // sync the pages of the mmap'ed file covering the range to SSD or HDD
+      static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+      uintptr_t sync_begin =
+          reinterpret_cast<uintptr_t>(address) & ~(page_size - 1);
+      uintptr_t sync_end = reinterpret_cast<uintptr_t>(address) + length;
+
+      int status = msync(reinterpret_cast<void *>(sync_begin),
+                         sync_end - sync_begin, MS_SYNC);
       if (status != 0) {
         perror("msync");
         exit(EXIT_FAILURE);
@@ -70,7 +70,9 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 Tile::~Tile() {
   // reclaim the tile memory (INLINED data)
   auto &storage_manager = storage::StorageManager::GetInstance();
-  storage_manager.Release(backend_type, data);
+  if (mapped_region == nullptr) {
+    storage_manager.Release(backend_type, data);
+  }
   data = NULL;
 
   // reclaim the tile memory (UNINLINED data)
@@ -178,6 +180,18 @@ void Tile::SetValueFast(const type::Value &value, const oid_t tuple_offset,
   value.SerializeTo(field_location, is_inlined, pool);
 }
 
+void Tile::AdoptMappedData(char *mapped_data,
+                           const std::shared_ptr<void> &mapped_region) {
+  PL_ASSERT(mapped_data != NULL);
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  if (this->mapped_region == nullptr) {
+    storage_manager.Release(backend_type, data);
+  }
+
+  data = mapped_data;
+  this->mapped_region = mapped_region;
+}
+
 Tile *Tile::CopyTile(BackendType backend_type) {
   auto schema = GetSchema();
   bool tile_columns_inlined = schema->IsInlined();
@@ -216,7 +216,8 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
   return tuple_slot_id;
 }
 
-oid_t TileGroup::DeleteTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id) {
+oid_t TileGroup::DeleteTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
+                                         bool keep_old_version) {
   auto status = tile_group_header->GetEmptyTupleSlot(tuple_slot_id);
 
   tile_group_header->GetHeaderLock().Lock();
@@ -231,6 +232,13 @@ oid_t TileGroup::DeleteTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id) {
     tile_group_header->GetHeaderLock().Unlock();
     return INVALID_OID;
   }
+  // The committed version ends at the commit of the delete
+  if (keep_old_version &&
+      tile_group_header->GetTransactionId(tuple_slot_id) == INITIAL_TXN_ID) {
+    tile_group_header->SetEndCommitId(tuple_slot_id, commit_id);
+    tile_group_header->GetHeaderLock().Unlock();
+    return tuple_slot_id;
+  }
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INVALID_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -241,7 +249,8 @@ oid_t TileGroup::DeleteTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id) {
 }
 
 oid_t TileGroup::UpdateTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
-                                         ItemPointer new_location) {
+                                         ItemPointer new_location,
+                                         bool keep_old_version) {
   auto status = tile_group_header->GetEmptyTupleSlot(tuple_slot_id);
 
   tile_group_header->GetHeaderLock().Lock();
@@ -257,6 +266,14 @@ oid_t TileGroup::UpdateTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
     tile_group_header->GetHeaderLock().Unlock();
     return INVALID_OID;
   }
+  // The committed version ends where the new version begins
+  if (keep_old_version &&
+      tile_group_header->GetTransactionId(tuple_slot_id) == INITIAL_TXN_ID) {
+    tile_group_header->SetNextItemPointer(tuple_slot_id, new_location);
+    tile_group_header->SetEndCommitId(tuple_slot_id, commit_id);
+    tile_group_header->GetHeaderLock().Unlock();
+    return tuple_slot_id;
+  }
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INVALID_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
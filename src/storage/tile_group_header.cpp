@@ -35,9 +35,18 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      recycled_tuple_count(0),
+      on_free_list(false),
+      retired(false) {
   header_size = num_tuple_slots * header_entry_size;
 
+  size_t bitmap_word_count = (num_tuple_slots + 63) / 64;
+  recycled_slot_bitmap.reset(new std::atomic<uint64_t>[bitmap_word_count]);
+  for (size_t word_itr = 0; word_itr < bitmap_word_count; word_itr++) {
+    recycled_slot_bitmap[word_itr] = 0;
+  }
+
   // allocate storage space for header
   auto &storage_manager = storage::StorageManager::GetInstance();
   data = reinterpret_cast<char *>(
@@ -66,6 +75,80 @@ TileGroupHeader::~TileGroupHeader() {
   data = nullptr;
 }
 
+//===--------------------------------------------------------------------===//
+// Recycled tuple slots
+//===--------------------------------------------------------------------===//
+
+bool TileGroupHeader::RecycleTupleSlot(const oid_t &tuple_slot_id) {
+  PL_ASSERT(tuple_slot_id < num_tuple_slots);
+
+  if (retired == true) {
+    return false;
+  }
+
+  // the count is raised before the bit is set, so it never falls below the
+  // number of set bits
+  recycled_tuple_count++;
+
+  uint64_t bit = 1UL << (tuple_slot_id % 64);
+  uint64_t old_word = recycled_slot_bitmap[tuple_slot_id / 64].fetch_or(bit);
+  if ((old_word & bit) != 0) {
+    recycled_tuple_count--;
+    return false;
+  }
+
+  bool expected = false;
+  return on_free_list.compare_exchange_strong(expected, true);
+}
+
+size_t TileGroupHeader::TakeRecycledTupleSlots(
+    std::vector<oid_t> &tuple_slot_ids, const size_t max_count) {
+  size_t taken_count = 0;
+  size_t bitmap_word_count = (num_tuple_slots + 63) / 64;
+
+  for (size_t word_itr = 0;
+       word_itr < bitmap_word_count && taken_count < max_count &&
+           recycled_tuple_count > 0;
+       word_itr++) {
+    uint64_t word = recycled_slot_bitmap[word_itr].load();
+    while (word != 0 && taken_count < max_count) {
+      uint64_t bit = word & (~word + 1);
+      // another backend may take the same slot if the tile group was put
+      // back on the free list in the meantime
+      uint64_t old_word = recycled_slot_bitmap[word_itr].fetch_and(~bit);
+      if ((old_word & bit) != 0) {
+        recycled_tuple_count--;
+        tuple_slot_ids.push_back(word_itr * 64 + __builtin_ctzl(bit));
+        taken_count++;
+      }
+      word = old_word & ~bit;
+    }
+  }
+
+  return taken_count;
+}
+
+bool TileGroupHeader::FinishTakingRecycledTupleSlots() {
+  on_free_list = false;
+
+  // slots recycled while the flag was still set were not announced
+  if (recycled_tuple_count == 0) {
+    return false;
+  }
+
+  bool expected = false;
+  return on_free_list.compare_exchange_strong(expected, true);
+}
+
+void TileGroupHeader::Retire() {
+  retired = true;
+
+  // a slot recycled concurrently may still be set in the bitmap, but it is
+  // never taken since the gc skips retired tile groups
+  std::vector<oid_t> tuple_slot_ids;
+  TakeRecycledTupleSlots(tuple_slot_ids, num_tuple_slots);
+}
+
 //===--------------------------------------------------------------------===//
 // Tile Group Header
 //===--------------------------------------------------------------------===//
@@ -165,6 +248,14 @@ void TileGroupHeader::Sync() {
   storage_manager.Sync(backend_type, data, header_size);
 }
 
+void TileGroupHeader::AdoptMappedData(char *mapped_data) {
+  PL_ASSERT(mapped_data != nullptr);
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  storage_manager.Release(backend_type, data);
+
+  data = mapped_data;
+}
+
 void TileGroupHeader::PrintVisibility(txn_id_t txn_id, cid_t at_cid) {
   oid_t active_tuple_slots = GetCurrentNextTupleSlot();
   std::stringstream os;
@@ -837,6 +837,51 @@ std::ostream& operator<<(std::ostream& os, const IndexType& type) {
   return os;
 }
 
+//===--------------------------------------------------------------------===//
+// IndexPartitionType - String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string IndexPartitionTypeToString(IndexPartitionType type) {
+  switch (type) {
+    case IndexPartitionType::INVALID: {
+      return "INVALID";
+    }
+    case IndexPartitionType::HASH: {
+      return "HASH";
+    }
+    case IndexPartitionType::RANGE: {
+      return "RANGE";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for IndexPartitionType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+IndexPartitionType StringToIndexPartitionType(const std::string& str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return IndexPartitionType::INVALID;
+  } else if (upper_str == "HASH") {
+    return IndexPartitionType::HASH;
+  } else if (upper_str == "RANGE") {
+    return IndexPartitionType::RANGE;
+  } else {
+    throw ConversionException(StringUtil::Format(
+        "No IndexPartitionType conversion from string '%s'",
+        upper_str.c_str()));
+  }
+  return IndexPartitionType::INVALID;
+}
+
+std::ostream& operator<<(std::ostream& os, const IndexPartitionType& type) {
+  os << IndexPartitionTypeToString(type);
+  return os;
+}
+
 //===--------------------------------------------------------------------===//
 // IndexConstraintType - String Utilities
 //===--------------------------------------------------------------------===//
@@ -1876,6 +1921,12 @@ std::string CheckpointTypeToString(CheckpointType type) {
     case CheckpointType::NORMAL: {
       return "NORMAL";
     }
+    case CheckpointType::FUZZY: {
+      return "FUZZY";
+    }
+    case CheckpointType::IMAGE: {
+      return "IMAGE";
+    }
     default: {
       throw ConversionException(StringUtil::Format(
           "No string conversion for CheckpointType value '%d'",
@@ -1891,6 +1942,10 @@ CheckpointType StringToCheckpointType(const std::string& str) {
     return CheckpointType::INVALID;
   } else if (upper_str == "NORMAL") {
     return CheckpointType::NORMAL;
+  } else if (upper_str == "FUZZY") {
+    return CheckpointType::FUZZY;
+  } else if (upper_str == "IMAGE") {
+    return CheckpointType::IMAGE;
   } else {
     throw ConversionException(
         StringUtil::Format("No CheckpointType conversion from string '%s'",
@@ -1904,6 +1959,56 @@ std::ostream& operator<<(std::ostream& os, const CheckpointType& type) {
   return os;
 }
 
+//===--------------------------------------------------------------------===//
+// LogCompressionType - String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string LogCompressionTypeToString(LogCompressionType type) {
+  switch (type) {
+    case LogCompressionType::INVALID: {
+      return "INVALID";
+    }
+    case LogCompressionType::NONE: {
+      return "NONE";
+    }
+    case LogCompressionType::LZ4: {
+      return "LZ4";
+    }
+    case LogCompressionType::ZSTD: {
+      return "ZSTD";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for LogCompressionType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+LogCompressionType StringToLogCompressionType(const std::string& str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return LogCompressionType::INVALID;
+  } else if (upper_str == "NONE") {
+    return LogCompressionType::NONE;
+  } else if (upper_str == "LZ4") {
+    return LogCompressionType::LZ4;
+  } else if (upper_str == "ZSTD") {
+    return LogCompressionType::ZSTD;
+  } else {
+    throw ConversionException(
+        StringUtil::Format("No LogCompressionType conversion from string '%s'",
+                           upper_str.c_str()));
+  }
+  return LogCompressionType::INVALID;
+}
+
+std::ostream& operator<<(std::ostream& os, const LogCompressionType& type) {
+  os << LogCompressionTypeToString(type);
+  return os;
+}
+
 //===--------------------------------------------------------------------===//
 // LoggingStatusType - String Utilities
 //===--------------------------------------------------------------------===//
@@ -2036,6 +2141,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_TUPLE_UPDATE: {
       return "TUPLE_UPDATE";
     }
+    case LOGRECORD_TYPE_TUPLE_DELTA_UPDATE: {
+      return "TUPLE_DELTA_UPDATE";
+    }
     case LOGRECORD_TYPE_WAL_TUPLE_INSERT: {
       return "WAL_TUPLE_INSERT";
     }
@@ -2045,6 +2153,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
       return "WAL_TUPLE_UPDATE";
     }
+    case LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE: {
+      return "WAL_TUPLE_DELTA_UPDATE";
+    }
     case LOGRECORD_TYPE_WBL_TUPLE_INSERT: {
       return "WBL_TUPLE_INSERT";
     }
@@ -2057,6 +2168,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_ITERATION_DELIMITER: {
       return "ITERATION_DELIMITER";
     }
+    case LOGRECORD_TYPE_COMPRESSED_BLOCK: {
+      return "COMPRESSED_BLOCK";
+    }
     default: {
       throw ConversionException(StringUtil::Format(
           "No string conversion for LogRecordType value '%d'",
@@ -2086,12 +2200,16 @@ LogRecordType StringToLogRecordType(const std::string& str) {
     return LOGRECORD_TYPE_TUPLE_DELETE;
   } else if (upper_str == "TUPLE_UPDATE") {
     return LOGRECORD_TYPE_TUPLE_UPDATE;
+  } else if (upper_str == "TUPLE_DELTA_UPDATE") {
+    return LOGRECORD_TYPE_TUPLE_DELTA_UPDATE;
   } else if (upper_str == "WAL_TUPLE_INSERT") {
     return LOGRECORD_TYPE_WAL_TUPLE_INSERT;
   } else if (upper_str == "WAL_TUPLE_DELETE") {
     return LOGRECORD_TYPE_WAL_TUPLE_DELETE;
   } else if (upper_str == "WAL_TUPLE_UPDATE") {
     return LOGRECORD_TYPE_WAL_TUPLE_UPDATE;
+  } else if (upper_str == "WAL_TUPLE_DELTA_UPDATE") {
+    return LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE;
   } else if (upper_str == "WBL_TUPLE_INSERT") {
     return LOGRECORD_TYPE_WBL_TUPLE_INSERT;
   } else if (upper_str == "WBL_TUPLE_DELETE") {
@@ -2100,6 +2218,8 @@ LogRecordType StringToLogRecordType(const std::string& str) {
     return LOGRECORD_TYPE_WBL_TUPLE_UPDATE;
   } else if (upper_str == "ITERATION_DELIMITER") {
     return LOGRECORD_TYPE_ITERATION_DELIMITER;
+  } else if (upper_str == "COMPRESSED_BLOCK") {
+    return LOGRECORD_TYPE_COMPRESSED_BLOCK;
   } else {
     throw ConversionException(StringUtil::Format(
         "No LogRecordType conversion from string '%s'", upper_str.c_str()));
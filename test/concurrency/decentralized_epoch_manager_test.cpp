@@ -70,6 +70,36 @@ TEST_F(DecentralizedEpochManagerTests, SingleThreadTest) {
 }
 
 
+TEST_F(DecentralizedEpochManagerTests, ActiveSnapshotsTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  epoch_manager.Reset(2);
+  epoch_manager.RegisterThread(0);
+
+  // a long-running transaction at epoch 2
+  cid_t long_txn_id = epoch_manager.EnterEpoch(0);
+
+  epoch_manager.Reset(10);
+  cid_t txn_id = epoch_manager.EnterEpoch(0);
+
+  concurrency::ActiveSnapshots snapshots;
+  epoch_manager.GetActiveSnapshots(snapshots);
+  EXPECT_EQ(10, snapshots.next_epoch_id);
+  EXPECT_EQ(2, snapshots.epoch_ranges.size());
+
+  // a version replaced within epoch 5 is visible to no snapshot
+  EXPECT_FALSE(snapshots.MayBeVisible((5UL << 32) | 1, (5UL << 32) | 2));
+
+  // versions visible at epoch 2 or epoch 10
+  EXPECT_TRUE(snapshots.MayBeVisible((1UL << 32) | 1, (5UL << 32) | 2));
+  EXPECT_TRUE(snapshots.MayBeVisible((9UL << 32) | 1, (10UL << 32) | 2));
+
+  epoch_manager.ExitEpoch(0, txn_id);
+  epoch_manager.ExitEpoch(0, long_txn_id);
+  epoch_manager.DeregisterThread(0);
+}
+
+
 TEST_F(DecentralizedEpochManagerTests, MultipleThreadsTest) {
 
   auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
@@ -24,21 +24,6 @@ namespace test {
 class LocalEpochTests : public PelotonTest {};
 
 
-TEST_F(LocalEpochTests, EpochCompareTest) {
-  concurrency::EpochCompare comp;
-  
-  std::shared_ptr<concurrency::Epoch> epoch0(new concurrency::Epoch(10, 20));
-  std::shared_ptr<concurrency::Epoch> epoch1(new concurrency::Epoch(10, 20));
-  bool rt = comp(epoch0, epoch1);
-  EXPECT_EQ(rt, false);
-
-  std::shared_ptr<concurrency::Epoch> epoch2(new concurrency::Epoch(11, 21));
-  std::shared_ptr<concurrency::Epoch> epoch3(new concurrency::Epoch(12, 20));
-  rt = comp(epoch2, epoch3);
-  EXPECT_EQ(rt, false);
-}
-
-
 TEST_F(LocalEpochTests, TransactionTest) {
   concurrency::LocalEpoch local_epoch(0);
   
@@ -92,6 +77,43 @@ TEST_F(LocalEpochTests, TransactionTest) {
 }
 
 
+TEST_F(LocalEpochTests, EpochRingTest) {
+  concurrency::LocalEpoch local_epoch(0);
+
+  bool rt = local_epoch.EnterEpoch(10);
+  EXPECT_EQ(rt, true);
+
+  // this epoch shares the slot of epoch 10, and is counted with it
+  rt = local_epoch.EnterEpoch(10 + EPOCH_RING_SIZE);
+  EXPECT_EQ(rt, true);
+
+  uint64_t max_eid = local_epoch.GetMaxCommittedEpochId(100);
+  EXPECT_EQ(max_eid, 9);
+
+  // the slot keeps the older epoch until both transactions left
+  local_epoch.ExitEpoch(10);
+  max_eid = local_epoch.GetMaxCommittedEpochId(100);
+  EXPECT_EQ(max_eid, 9);
+
+  local_epoch.ExitEpoch(10 + EPOCH_RING_SIZE);
+  max_eid = local_epoch.GetMaxCommittedEpochId(100);
+  EXPECT_EQ(max_eid, 99);
+
+  // a read-only transaction lowers the slot of a younger epoch
+  rt = local_epoch.EnterEpoch(150);
+  EXPECT_EQ(rt, true);
+  local_epoch.EnterEpochRO(150 - EPOCH_RING_SIZE);
+
+  max_eid = local_epoch.GetMaxCommittedEpochId(160);
+  EXPECT_EQ(max_eid, 150 - EPOCH_RING_SIZE - 1);
+
+  local_epoch.ExitEpoch(150 - EPOCH_RING_SIZE);
+  local_epoch.ExitEpoch(150);
+  max_eid = local_epoch.GetMaxCommittedEpochId(160);
+  EXPECT_EQ(max_eid, 159);
+}
+
+
 }  // End test namespace
 }  // End peloton namespace
 
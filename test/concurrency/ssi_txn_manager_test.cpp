@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// ssi_txn_manager_test.cpp
+//
+// Identification: test/concurrency/ssi_txn_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "concurrency/testing_transaction_util.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/ssi_txn_manager.h"
+#include "concurrency/ssn_txn_manager.h"
+#include "common/harness.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Transaction Tests
+//===--------------------------------------------------------------------===//
+
+class SsiTxnManagerTests : public PelotonTest {};
+
+template <typename TxnManagerType>
+void ContextReclaimTest(TxnManagerType &txn_manager) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  epoch_manager.Reset(1);
+  epoch_manager.RegisterThread(0);
+
+  size_t retained_count = txn_manager.GetRetainedTxnCount();
+
+  for (size_t i = 0; i < 100; i++) {
+    auto txn = txn_manager.BeginTransaction(0);
+    txn_manager.CommitTransaction(txn);
+  }
+
+  // The epoch the transactions finished in is still open
+  EXPECT_EQ(retained_count + 100, txn_manager.GetRetainedTxnCount());
+
+  // Contexts are unlinked once their epoch is committed, and freed one
+  // epoch later
+  for (uint64_t epoch_id = 2;
+       epoch_id < 10 && txn_manager.GetRetainedTxnCount() != 0; epoch_id++) {
+    epoch_manager.Reset(epoch_id);
+    txn_manager.CleanUp();
+  }
+  EXPECT_EQ(0, txn_manager.GetRetainedTxnCount());
+
+  epoch_manager.DeregisterThread(0);
+}
+
+TEST_F(SsiTxnManagerTests, ContextReclaimTest) {
+  concurrency::EpochManagerFactory::Configure(EpochType::DECENTRALIZED_EPOCH);
+
+  ContextReclaimTest(concurrency::SsiTxnManager::GetInstance());
+  ContextReclaimTest(concurrency::SsnTxnManager::GetInstance());
+}
+
+template <typename TxnManagerType>
+void DirtyRangeVisibilityTest(TxnManagerType &txn_manager) {
+  storage::TileGroupHeader tile_group_header(BackendType::MM, 4);
+
+  // committed at 2, invalidated at 5
+  tile_group_header.SetTransactionId(0, INITIAL_TXN_ID);
+  tile_group_header.SetBeginCommitId(0, 2);
+  tile_group_header.SetEndCommitId(0, 5);
+
+  // committed at 5
+  tile_group_header.SetTransactionId(1, INITIAL_TXN_ID);
+  tile_group_header.SetBeginCommitId(1, 5);
+  tile_group_header.SetEndCommitId(1, MAX_CID);
+
+  // committed at 8
+  tile_group_header.SetTransactionId(2, INITIAL_TXN_ID);
+  tile_group_header.SetBeginCommitId(2, 8);
+  tile_group_header.SetEndCommitId(2, MAX_CID);
+
+  concurrency::Transaction txn(1000, 10, 0, false);
+  EXPECT_EQ(VisibilityType::INVISIBLE,
+            txn_manager.IsVisible(&txn, &tile_group_header, 0));
+  EXPECT_EQ(VisibilityType::OK,
+            txn_manager.IsVisible(&txn, &tile_group_header, 1));
+  EXPECT_EQ(VisibilityType::OK,
+            txn_manager.IsVisible(&txn, &tile_group_header, 2));
+  EXPECT_FALSE(txn_manager.IsOwnable(&txn, &tile_group_header, 0));
+
+  // The commit at 5 was not durable when the system crashed
+  txn_manager.SetDirtyRanges({std::make_pair(3, 6)});
+
+  EXPECT_EQ(VisibilityType::OK,
+            txn_manager.IsVisible(&txn, &tile_group_header, 0));
+  EXPECT_EQ(VisibilityType::INVISIBLE,
+            txn_manager.IsVisible(&txn, &tile_group_header, 1));
+  EXPECT_EQ(VisibilityType::OK,
+            txn_manager.IsVisible(&txn, &tile_group_header, 2));
+  EXPECT_TRUE(txn_manager.IsOwnable(&txn, &tile_group_header, 0));
+
+  txn_manager.SetDirtyRanges({});
+}
+
+TEST_F(SsiTxnManagerTests, DirtyRangeVisibilityTest) {
+  DirtyRangeVisibilityTest(concurrency::SsiTxnManager::GetInstance());
+  DirtyRangeVisibilityTest(concurrency::SsnTxnManager::GetInstance());
+}
+
+}  // End test namespace
+}  // End peloton namespace
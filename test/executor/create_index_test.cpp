@@ -144,6 +144,13 @@ TEST_F(CreateIndexTests, CreatingIndex) {
   LOG_INFO("Building plan tree completed!\n%s",
            planner::PlanUtil::GetInfo(statement->GetPlanTree().get()).c_str());
 
+  // The index is populated from the table directly, right after its creation
+  auto create_plan = statement->GetPlanTree().get();
+  EXPECT_EQ(PlanNodeType::POPULATE_INDEX, create_plan->GetPlanNodeType());
+  ASSERT_EQ(1, create_plan->GetChildren().size());
+  EXPECT_EQ(PlanNodeType::CREATE,
+            create_plan->GetChildren()[0]->GetPlanNodeType());
+
   LOG_INFO("Executing plan...");
   result_format =
       std::move(std::vector<int>(statement->GetTupleDescriptor().size(), 0));
@@ -159,6 +166,9 @@ TEST_F(CreateIndexTests, CreatingIndex) {
   // Expected 2 , Primary key index + created index
   EXPECT_EQ(target_table_->GetIndexCount(), 2);
 
+  // The tuple inserted before holds an entry in the new index
+  EXPECT_EQ(1, target_table_->GetIndex(1)->GetNumberOfTuples());
+
   // free the database just created
   txn = txn_manager.BeginTransaction();
   catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
@@ -28,6 +28,7 @@
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/plan_executor.h"
+#include "index/index_factory.h"
 #include "optimizer/simple_optimizer.h"
 #include "planner/create_plan.h"
 #include "planner/delete_plan.h"
@@ -172,5 +173,107 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Index scan answered from the included columns of an index.
+TEST_F(IndexScanTests, IncludedColumnsTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateAndPopulateTable());
+
+  // Index on column 0 that also stores column 1
+  auto tuple_schema = data_table->GetSchema();
+  std::vector<oid_t> key_attrs = {0};
+  std::vector<oid_t> included_attrs = {1};
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, {0, 1});
+  key_schema->SetIndexedColumns({0, 1});
+  auto index_metadata = new index::IndexMetadata(
+      "covering_index", 125, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      IndexConstraintType::DEFAULT, tuple_schema, key_schema, key_attrs, false,
+      included_attrs);
+  std::shared_ptr<index::Index> index(
+      index::IndexFactory::GetIndex(index_metadata));
+  EXPECT_TRUE(data_table->BulkLoadIndex(index.get()));
+  data_table->AddIndex(index);
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 <= 110, output ATTR 0 and ATTR 1
+  //===--------------------------------------------------------------------===//
+
+  std::vector<oid_t> column_ids({0, 1});
+  std::vector<oid_t> key_column_ids({0});
+  std::vector<ExpressionType> expr_types(
+      {ExpressionType::COMPARE_LESSTHANOREQUALTO});
+  std::vector<type::Value> values(
+      {type::ValueFactory::GetIntegerValue(110).Copy()});
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+  planner::IndexScanPlan node(data_table.get(), nullptr, column_ids,
+                              index_scan_desc);
+
+  // The version chain of the first tuple reports an update of the included
+  // column, so it has to be read from the table
+  std::vector<ItemPointer *> locations;
+  index->ScanAllKeys(locations);
+  ASSERT_FALSE(locations.empty());
+  index->MarkCoveredUpdate(locations[0]);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  int result_tuple_count = 0;
+  while (executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_THAT(result_tile, NotNull());
+
+    for (oid_t tuple_id : *result_tile) {
+      int key = result_tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+      int included = result_tile->GetValue(tuple_id, 1).GetAs<int32_t>();
+      EXPECT_LE(key, 110);
+      EXPECT_EQ(key + 1, included);
+      result_tuple_count++;
+    }
+  }
+
+  EXPECT_EQ(12, result_tuple_count);
+
+  // All but the updated chain were answered from the index keys
+  EXPECT_EQ(11, executor.GetIndexOnlyTupleCount());
+
+  txn_manager.CommitTransaction(txn);
+
+  // Once the gc pruned the stale entries of the chain, its latest version is
+  // answered from the index keys as well
+  index->ClearCoveredUpdate(locations[0]);
+
+  txn = txn_manager.BeginTransaction();
+  context.reset(new executor::ExecutorContext(txn));
+  executor::IndexScanExecutor pruned_executor(&node, context.get());
+  EXPECT_TRUE(pruned_executor.Init());
+
+  result_tuple_count = 0;
+  while (pruned_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        pruned_executor.GetOutput());
+    EXPECT_THAT(result_tile, NotNull());
+
+    for (oid_t tuple_id : *result_tile) {
+      int key = result_tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+      int included = result_tile->GetValue(tuple_id, 1).GetAs<int32_t>();
+      EXPECT_EQ(key + 1, included);
+      result_tuple_count++;
+    }
+  }
+
+  EXPECT_EQ(12, result_tuple_count);
+  EXPECT_EQ(12, pruned_executor.GetIndexOnlyTupleCount());
+
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
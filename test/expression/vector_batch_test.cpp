@@ -0,0 +1,165 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vector_batch_test.cpp
+//
+// Identification: test/expression/vector_batch_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/container_tuple.h"
+#include "common/harness.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "executor/testing_executor_util.h"
+#include "expression/expression_util.h"
+#include "expression/vector_batch.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+class VectorBatchTests : public PelotonTest {};
+
+static expression::AbstractExpression *ColumnExpr(type::Type::TypeId type_id,
+                                                  int column_id) {
+  return expression::ExpressionUtil::TupleValueFactory(type_id, 0, column_id);
+}
+
+static expression::AbstractExpression *ConstantExpr(const type::Value &value) {
+  return expression::ExpressionUtil::ConstantValueFactory(value);
+}
+
+// Check that the batch kernels agree with the tuple-at-a-time evaluation
+static void CheckBatch(std::shared_ptr<storage::TileGroup> tile_group,
+                       expression::VectorBatch &batch,
+                       const expression::AbstractExpression *expr) {
+  expression::ColumnVector result;
+  EXPECT_TRUE(expr->EvaluateBatch(batch, result, nullptr));
+  EXPECT_EQ(batch.GetSize(), result.GetSize());
+
+  for (size_t row = 0; row < batch.GetSize(); row++) {
+    expression::ContainerTuple<storage::TileGroup> tuple(
+        tile_group.get(), batch.GetTupleIds()[row]);
+    auto expected = expr->Evaluate(&tuple, nullptr, nullptr);
+    auto actual = result.GetValue(row);
+    EXPECT_EQ(expected.IsNull(), actual.IsNull());
+    if (expected.IsNull() == false) {
+      EXPECT_EQ(type::CMP_TRUE, expected.CompareEquals(actual));
+    }
+  }
+}
+
+TEST_F(VectorBatchTests, KernelTest) {
+  const int tuple_count = 100;
+  auto tile_group = TestingExecutorUtil::CreateTileGroup(tuple_count);
+  TestingExecutorUtil::PopulateTiles(tile_group, tuple_count);
+
+  std::vector<oid_t> tuple_ids;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id += 3) {
+    tuple_ids.push_back(tuple_id);
+  }
+  expression::VectorBatch batch(tile_group.get(), std::move(tuple_ids));
+
+  // COL_A + COL_B * 2 >= 300
+  std::unique_ptr<expression::AbstractExpression> compare(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+              ColumnExpr(type::Type::INTEGER, 0),
+              expression::ExpressionUtil::OperatorFactory(
+                  ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+                  ColumnExpr(type::Type::INTEGER, 1),
+                  ConstantExpr(type::ValueFactory::GetIntegerValue(2)))),
+          ConstantExpr(type::ValueFactory::GetIntegerValue(300))));
+  CheckBatch(tile_group, batch, compare.get());
+
+  // COL_C / 7, with a decimal result
+  std::unique_ptr<expression::AbstractExpression> divide(
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_DIVIDE, type::Type::DECIMAL,
+          ColumnExpr(type::Type::DECIMAL, 2),
+          ConstantExpr(type::ValueFactory::GetBigIntValue(7))));
+  CheckBatch(tile_group, batch, divide.get());
+
+  // NOT (COL_C < 500.5) OR (COL_A = NULL AND COL_B <> 11)
+  std::unique_ptr<expression::AbstractExpression> conjunction(
+      expression::ExpressionUtil::ConjunctionFactory(
+          ExpressionType::CONJUNCTION_OR,
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_NOT, type::Type::BOOLEAN,
+              expression::ExpressionUtil::ComparisonFactory(
+                  ExpressionType::COMPARE_LESSTHAN,
+                  ColumnExpr(type::Type::DECIMAL, 2),
+                  ConstantExpr(type::ValueFactory::GetDecimalValue(500.5))),
+              nullptr),
+          expression::ExpressionUtil::ConjunctionFactory(
+              ExpressionType::CONJUNCTION_AND,
+              expression::ExpressionUtil::ComparisonFactory(
+                  ExpressionType::COMPARE_EQUAL,
+                  ColumnExpr(type::Type::INTEGER, 0),
+                  ConstantExpr(type::ValueFactory::GetNullValueByType(
+                      type::Type::INTEGER))),
+              expression::ExpressionUtil::ComparisonFactory(
+                  ExpressionType::COMPARE_NOTEQUAL,
+                  ColumnExpr(type::Type::INTEGER, 1),
+                  ConstantExpr(type::ValueFactory::GetIntegerValue(11))))));
+  CheckBatch(tile_group, batch, conjunction.get());
+}
+
+TEST_F(VectorBatchTests, FallbackTest) {
+  const int tuple_count = 50;
+  auto tile_group = TestingExecutorUtil::CreateTileGroup(tuple_count);
+  TestingExecutorUtil::PopulateTiles(tile_group, tuple_count);
+
+  std::vector<oid_t> tuple_ids;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    tuple_ids.push_back(tuple_id);
+  }
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::WrapTileGroup(tile_group));
+  expression::VectorBatch batch(logical_tile.get(), std::move(tuple_ids));
+
+  // varchars have no batch kernels
+  std::unique_ptr<expression::AbstractExpression> varchar_compare(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_EQUAL, ColumnExpr(type::Type::VARCHAR, 3),
+          ConstantExpr(type::ValueFactory::GetVarcharValue("33"))));
+  expression::ColumnVector result;
+  EXPECT_FALSE(varchar_compare->EvaluateBatch(batch, result, nullptr));
+
+  // the predicate is evaluated one tuple at a time instead
+  batch.EvaluatePredicate(varchar_compare.get(), result, nullptr);
+  for (size_t row = 0; row < batch.GetSize(); row++) {
+    EXPECT_EQ(row == 3, result.IsTrue(row));
+  }
+
+  // the tuples that overflow are left to the tuple-at-a-time evaluation,
+  // which throws
+  std::unique_ptr<expression::AbstractExpression> overflow(
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+          ColumnExpr(type::Type::INTEGER, 0),
+          ConstantExpr(type::ValueFactory::GetIntegerValue(
+              type::PELOTON_INT32_MAX))));
+  EXPECT_FALSE(overflow->EvaluateBatch(batch, result, nullptr));
+
+  // and so are divisions by zero
+  std::unique_ptr<expression::AbstractExpression> divide(
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_DIVIDE, type::Type::INTEGER,
+          ColumnExpr(type::Type::INTEGER, 1),
+          ColumnExpr(type::Type::INTEGER, 0)));
+  EXPECT_FALSE(divide->EvaluateBatch(batch, result, nullptr));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -12,16 +12,26 @@
 
 #include "concurrency/testing_transaction_util.h"
 #include "executor/testing_executor_util.h"
+#include "logging/testing_logging_util.h"
 #include "common/harness.h"
 #include "gc/gc_manager.h"
 #include "gc/gc_manager_factory.h"
+#include "gc/transaction_level_gc_manager.h"
+#include "index/index.h"
+#include "index/index_factory.h"
 #include "concurrency/epoch_manager.h"
+#include "executor/executor_context.h"
+#include "executor/index_scan_executor.h"
+#include "executor/logical_tile.h"
+#include "planner/index_scan_plan.h"
 
 
 #include "catalog/catalog.h"
+#include "catalog/manager.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
+#include "type/value_factory.h"
 
 
 namespace peloton {
@@ -108,6 +118,46 @@ int GarbageNum(storage::DataTable *table) {
   return old_num;
 }
 
+// look up the value in an index that includes the id column, expecting a
+// single tuple with the id. returns the number of tuples answered from the
+// index keys without reading the table
+size_t ScanIncludedColumns(storage::DataTable *table,
+                           std::shared_ptr<index::Index> index, int value,
+                           int id) {
+  std::vector<oid_t> column_ids({0, 1});
+  std::vector<oid_t> key_column_ids({1});
+  std::vector<ExpressionType> expr_types({ExpressionType::COMPARE_EQUAL});
+  std::vector<type::Value> values(
+      {type::ValueFactory::GetIntegerValue(value).Copy()});
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+  planner::IndexScanPlan node(table, nullptr, column_ids, index_scan_desc);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  int result_tuple_count = 0;
+  while (executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      EXPECT_EQ(id, result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+      EXPECT_EQ(value, result_tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+      result_tuple_count++;
+    }
+  }
+  EXPECT_EQ(1, result_tuple_count);
+
+  txn_manager.CommitTransaction(txn);
+  return executor.GetIndexOnlyTupleCount();
+}
+
 // get tuple recycled by GC
 int RecycledNum(storage::DataTable *table) {
   int count = 0;
@@ -197,6 +247,240 @@ TEST_F(GarbageCollectionTests, SimpleTest) {
   }
 }
 
+TEST_F(GarbageCollectionTests, StaleIndexEntryTest) {
+
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  // the value column has a secondary index
+  std::unique_ptr<storage::DataTable> table(
+    TestingTransactionUtil::CreatePrimaryKeyUniqueKeyTable());
+  auto index = table->GetIndex(1);
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // the value column also has an index that stores the id column
+  auto tuple_schema = table->GetSchema();
+  auto covering_key_schema = catalog::Schema::CopySchema(tuple_schema, {1, 0});
+  covering_key_schema->SetIndexedColumns({1, 0});
+  auto covering_index_metadata = new index::IndexMetadata(
+      "covering_index", 1236, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      IndexConstraintType::DEFAULT, tuple_schema, covering_key_schema, {1},
+      false, {0});
+  std::shared_ptr<index::Index> covering_index(
+      index::IndexFactory::GetIndex(covering_index_metadata));
+  EXPECT_TRUE(table->BulkLoadIndex(covering_index.get()));
+  table->AddIndex(covering_index);
+
+  gc_manager.StartGC(gc_threads);
+
+  // move key 0 from value 0 to value 100, and keep value 1 of key 1
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  TransactionScheduler scheduler(1, table.get(), &txn_manager);
+  scheduler.Txn(0).Update(0, 100);
+  scheduler.Txn(0).Update(1, 1);
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+  EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+
+  std::unique_ptr<storage::Tuple> old_key(
+    new storage::Tuple(index->GetKeySchema(), true));
+  old_key->SetValue(0, type::ValueFactory::GetIntegerValue(0), pool);
+  std::unique_ptr<storage::Tuple> new_key(
+    new storage::Tuple(index->GetKeySchema(), true));
+  new_key->SetValue(0, type::ValueFactory::GetIntegerValue(100), pool);
+  std::unique_ptr<storage::Tuple> kept_key(
+    new storage::Tuple(index->GetKeySchema(), true));
+  kept_key->SetValue(0, type::ValueFactory::GetIntegerValue(1), pool);
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(old_key.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  // the chain of key 0 changed its covered columns, so the new value is
+  // read from the table while the stale entry exists
+  EXPECT_EQ(0, ScanIncludedColumns(table.get(), covering_index, 100, 0));
+  EXPECT_EQ(1, ScanIncludedColumns(table.get(), covering_index, 1, 1));
+
+  for (size_t i = 2; i < 12; ++i) {
+    epoch_manager.Reset(i);
+    SelectTuple(table.get(), 2);
+  }
+
+  // sleep a while for gc to finish its job
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  for (size_t i = 12; i < 22; ++i) {
+    epoch_manager.Reset(i);
+    SelectTuple(table.get(), 2);
+  }
+
+  // sleep a while for gc to finish its job
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  EXPECT_EQ(0, GarbageNum(table.get()));
+
+  // the entry of the old value is gone, while the entries still matching
+  // the latest versions stay
+  index->ScanKey(old_key.get(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanKey(new_key.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanKey(kept_key.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  // with its stale entry gone, the new value is answered from the index
+  EXPECT_EQ(1, ScanIncludedColumns(table.get(), covering_index, 100, 0));
+
+  gc_manager.StopGC();
+
+  gc::GCManagerFactory::Configure(0);
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+}
+
+
+TEST_F(GarbageCollectionTests, CompactionTest) {
+
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  // only the commits of ssi and ssn are logged
+  concurrency::TransactionManagerFactory::Configure(
+    ConcurrencyType::CONCURRENCY_TYPE_SSI);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.SetCompaction(true);
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(catalog->HasDatabase(db_id));
+
+  auto frontend_logger = TestingLoggingUtil::StartFileLogging();
+
+  // fill the first tile group, which has 100 slots
+  const int num_key = 100;
+  const int live_count = 5;
+  const oid_t table_oid = 12345;
+  storage::DataTable *table = nullptr;
+  std::thread populate_thread([&] {
+    table = TestingTransactionUtil::CreateTable(num_key, "TEST_TABLE", db_id,
+                                                table_oid, 1234, true);
+  });
+  populate_thread.join();
+  oid_t sparse_tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+
+  gc_manager.StartGC(gc_threads);
+
+  // delete all but the last tuples
+  TransactionScheduler scheduler(1, table, &txn_manager);
+  for (int i = 0; i < num_key - live_count; i++) {
+    scheduler.Txn(0).Delete(i);
+  }
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+  EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+
+  // the gc reclaims the deleted tuples, and then moves the live tuples out
+  // of the sparse tile group
+  for (size_t round = 0; round < 3; ++round) {
+    for (size_t i = 2 + round * 10; i < 12 + round * 10; ++i) {
+      epoch_manager.Reset(i);
+      SelectTuple(table, num_key);
+    }
+
+    // sleep a while for gc to finish its job
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+
+  gc_manager.StopGC();
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+  gc_manager.SetCompaction(false);
+
+  // the index finds the moved tuples at their new locations
+  auto index = table->GetIndex(0);
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<storage::Tuple> key(
+    new storage::Tuple(index->GetKeySchema(), true));
+  for (int i = num_key - live_count; i < num_key; i++) {
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    std::vector<ItemPointer *> location_ptrs;
+    index->ScanKey(key.get(), location_ptrs);
+    EXPECT_EQ(1, location_ptrs.size());
+    for (auto location_ptr : location_ptrs) {
+      EXPECT_NE(sparse_tile_group_id, location_ptr->block);
+    }
+  }
+
+  TransactionScheduler read_scheduler(1, table, &txn_manager);
+  for (int i = num_key - live_count; i < num_key; i++) {
+    read_scheduler.Txn(0).Read(i);
+  }
+  read_scheduler.Txn(0).Commit();
+  read_scheduler.Run();
+  EXPECT_TRUE(read_scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+  for (auto result : read_scheduler.schedules[0].results) {
+    EXPECT_EQ(0, result);
+  }
+
+  TestingLoggingUtil::CrashFileLogging(frontend_logger);
+
+  // recovery replays the moves into a fresh table, as updates from the old
+  // to the new locations
+  database->DropTableWithOid(table_oid);
+  table = TestingTransactionUtil::CreateTable(0, "TEST_TABLE", db_id,
+                                              table_oid, 1234, true);
+  TestingLoggingUtil::RecoverFromLogFiles();
+
+  auto &manager = catalog::Manager::GetInstance();
+  index = table->GetIndex(0);
+  for (int i = 0; i < num_key; i++) {
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    std::vector<ItemPointer *> location_ptrs;
+    index->ScanKey(key.get(), location_ptrs);
+    if (i < num_key - live_count) {
+      EXPECT_EQ(0, location_ptrs.size());
+      continue;
+    }
+
+    EXPECT_EQ(1, location_ptrs.size());
+    for (auto location_ptr : location_ptrs) {
+      EXPECT_NE(sparse_tile_group_id, location_ptr->block);
+      auto tile_group = manager.GetTileGroup(location_ptr->block);
+      EXPECT_EQ(i, tile_group->GetValue(location_ptr->offset, 0)
+                     .GetAs<int32_t>());
+    }
+  }
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+  concurrency::TransactionManagerFactory::Configure(
+    ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
 
 }  // End test namespace
 }  // End peloton namespace
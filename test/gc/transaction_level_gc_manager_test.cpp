@@ -11,10 +11,13 @@
 //===----------------------------------------------------------------------===//
 
 
+#include "concurrency/testing_transaction_util.h"
 #include "executor/testing_executor_util.h"
 #include "catalog/catalog.h"
 #include "common/harness.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "gc/gc_manager_factory.h"
+#include "gc/transaction_level_gc_manager.h"
 
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
@@ -39,6 +42,287 @@ TEST_F(TransactionLevelGCManagerTests, EnableTest) {
   EXPECT_TRUE(gc::GCManagerFactory::GetGCType() == GarbageCollectionType::OFF);
 }
 
+TEST_F(TransactionLevelGCManagerTests, CooperativeModeTest) {
+  gc::GCManagerFactory::Configure(1, true);
+  EXPECT_TRUE(gc::GCManagerFactory::GetGCType() == GarbageCollectionType::ON);
+
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  EXPECT_TRUE(gc_manager.IsCooperativeMode());
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      1, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto reclaimed_version_count =
+      gc_manager.GetMetrics().reclaimed_version_count_;
+
+  // Each update leaves an old version behind. The versions of a commit are
+  // unlinked by a later commit, once no transaction can see them anymore,
+  // and reclaimed by the commit after that. No gc thread is running.
+  size_t epoch_id = 2;
+  for (int round = 0; round < 3; round++) {
+    TransactionScheduler update_scheduler(1, table.get(), &txn_manager);
+    update_scheduler.Txn(0).Update(0, round);
+    update_scheduler.Txn(0).Commit();
+    update_scheduler.Run();
+    EXPECT_TRUE(update_scheduler.schedules[0].txn_result ==
+                ResultType::SUCCESS);
+
+    for (int i = 0; i < 10; i++, epoch_id++) {
+      epoch_manager.Reset(epoch_id);
+      TransactionScheduler read_scheduler(1, table.get(), &txn_manager);
+      read_scheduler.Txn(0).Read(0);
+      read_scheduler.Txn(0).Commit();
+      read_scheduler.Run();
+    }
+  }
+  EXPECT_TRUE(gc_manager.GetStatus() == false);
+
+  EXPECT_LT(reclaimed_version_count,
+            gc_manager.GetMetrics().reclaimed_version_count_);
+  EXPECT_FALSE(gc_manager.ReturnFreeSlot(table->GetOid()).IsNull());
+
+  table.release();
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(1);
+  EXPECT_FALSE(gc_manager.IsCooperativeMode());
+
+  gc::GCManagerFactory::Configure(0);
+}
+
+TEST_F(TransactionLevelGCManagerTests, FreeSlotCacheFlushTest) {
+  gc::GCManagerFactory::Configure(1, true);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+
+  const int num_key = 10;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // the inserted versions of all keys are reclaimed by the third commit
+  size_t epoch_id = 2;
+  for (int round = 0; round < 3; round++) {
+    TransactionScheduler update_scheduler(1, table.get(), &txn_manager);
+    for (int key = 0; key < num_key; key++) {
+      update_scheduler.Txn(0).Update(key, round);
+    }
+    update_scheduler.Txn(0).Commit();
+    update_scheduler.Run();
+    EXPECT_TRUE(update_scheduler.schedules[0].txn_result ==
+                ResultType::SUCCESS);
+
+    for (int i = 0; i < 10; i++, epoch_id++) {
+      epoch_manager.Reset(epoch_id);
+      TransactionScheduler read_scheduler(1, table.get(), &txn_manager);
+      read_scheduler.Txn(0).Read(0);
+      read_scheduler.Txn(0).Commit();
+      read_scheduler.Run();
+    }
+  }
+
+  // a backend takes a batch of the recycled slots of the tile group, uses
+  // one and exits
+  ItemPointer location = INVALID_ITEMPOINTER;
+  std::thread backend_thread(
+      [&] { location = gc_manager.ReturnFreeSlot(table->GetOid()); });
+  backend_thread.join();
+  EXPECT_FALSE(location.IsNull());
+
+  // the rest of its batch goes back to the table
+  EXPECT_LT(0, gc_manager.FlushFreeSlotCaches());
+  EXPECT_FALSE(gc_manager.ReturnFreeSlot(table->GetOid()).IsNull());
+
+  // the batch of a backend is only handed back once it is idle
+  EXPECT_EQ(0, gc_manager.FlushFreeSlotCaches());
+  EXPECT_LT(0, gc_manager.FlushFreeSlotCaches(0));
+
+  table.release();
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+}
+
+TEST_F(TransactionLevelGCManagerTests, CompactionTest) {
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  gc_manager.SetCompaction(true, 0.2);
+  EXPECT_TRUE(gc_manager.IsCompactionEnabled());
+
+  // Nothing turned sparse yet
+  EXPECT_EQ(0, gc_manager.CompactTileGroups());
+
+  gc_manager.SetCompaction(false);
+  EXPECT_FALSE(gc_manager.IsCompactionEnabled());
+
+  // Released tile groups keep their id and offset, but hold no tuples
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  auto tile_group = data_table->GetTileGroup(0);
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+
+  tile_group->GetHeader()->Retire();
+  data_table->ReleaseTileGroup(tile_group_id);
+
+  auto released_tile_group = data_table->GetTileGroup(0);
+  EXPECT_NE(tile_group.get(), released_tile_group.get());
+  EXPECT_EQ(tile_group_id, released_tile_group->GetTileGroupId());
+  EXPECT_EQ(0, released_tile_group->GetNextTupleSlot());
+  EXPECT_TRUE(released_tile_group->GetHeader()->IsRetired());
+  EXPECT_EQ(1, data_table->GetTileGroupCount());
+
+  gc::GCManagerFactory::Configure(0);
+}
+
+TEST_F(TransactionLevelGCManagerTests, VersionTrimmingTest) {
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.SetVersionTrimming(true);
+  EXPECT_TRUE(gc_manager.IsVersionTrimmingEnabled());
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+
+  // key 0 is inserted in slot 0 of the first tile group
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      1, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  gc_manager.StartGC(gc_threads);
+
+  // the snapshot of epoch 2 reads the inserted version
+  epoch_manager.Reset(2);
+  auto snapshot_txn = txn_manager.BeginTransaction();
+  int result = -1;
+  EXPECT_TRUE(
+      TestingTransactionUtil::ExecuteRead(snapshot_txn, table.get(), 0, result));
+  EXPECT_EQ(0, result);
+
+  // the versions 1 and 2 begin and end within epoch 3, such that no snapshot
+  // may see them
+  epoch_manager.Reset(3);
+  for (int value = 1; value <= 3; value++) {
+    TransactionScheduler scheduler(1, table.get(), &txn_manager);
+    scheduler.Txn(0).Update(0, value);
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+  }
+
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_header = tile_group->GetHeader();
+  EXPECT_EQ(4, tile_group->GetNextTupleSlot());
+  EXPECT_EQ(2, tile_group_header->GetNextItemPointer(3).offset);
+
+  epoch_manager.Reset(4);
+
+  // sleep a while for gc to finish its job
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  // the latest version links to the version of the snapshot, which still
+  // reads it
+  ItemPointer older_version = tile_group_header->GetNextItemPointer(3);
+  EXPECT_EQ(tile_group->GetTileGroupId(), older_version.block);
+  EXPECT_EQ(0, older_version.offset);
+  EXPECT_EQ(3, tile_group_header->GetPrevItemPointer(0).offset);
+
+  result = -1;
+  EXPECT_TRUE(
+      TestingTransactionUtil::ExecuteRead(snapshot_txn, table.get(), 0, result));
+  EXPECT_EQ(0, result);
+  EXPECT_TRUE(txn_manager.CommitTransaction(snapshot_txn) ==
+              ResultType::SUCCESS);
+
+  // once the snapshot ended, the slots of all old versions are reset
+  size_t epoch_id = 5;
+  for (int round = 0; round < 2; round++) {
+    for (int i = 0; i < 10; i++, epoch_id++) {
+      epoch_manager.Reset(epoch_id);
+      TransactionScheduler read_scheduler(1, table.get(), &txn_manager);
+      read_scheduler.Txn(0).Read(0);
+      read_scheduler.Txn(0).Commit();
+      read_scheduler.Run();
+      EXPECT_EQ(3, read_scheduler.schedules[0].results[0]);
+    }
+
+    // sleep a while for gc to finish its job
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+
+  for (oid_t tuple_id = 0; tuple_id < 3; tuple_id++) {
+    EXPECT_EQ(INVALID_TXN_ID, tile_group_header->GetTransactionId(tuple_id));
+  }
+
+  gc_manager.StopGC();
+  gc_manager.SetVersionTrimming(false);
+
+  table.release();
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+}
+
+TEST_F(TransactionLevelGCManagerTests, MetricsTest) {
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  auto metrics = gc_manager.GetMetrics();
+  EXPECT_EQ(1, metrics.queue_depths_.size());
+
+  // Versions of a tile group that does not exist are counted, but never
+  // touched
+  std::shared_ptr<GCSet> gc_set(new GCSet());
+  (*gc_set)[1 << 30][0] = false;
+  (*gc_set)[1 << 30][1] = false;
+
+  gc_manager.SetWriterThrottle(true, 1);
+  EXPECT_TRUE(gc_manager.IsWriterThrottleEnabled());
+
+  gc_manager.RecycleTransaction(gc_set, 0);
+
+  auto new_metrics = gc_manager.GetMetrics();
+  EXPECT_EQ(metrics.queued_version_count_ + 2,
+            new_metrics.queued_version_count_);
+  EXPECT_EQ(metrics.queue_depths_[0] + 1, new_metrics.queue_depths_[0]);
+  EXPECT_LE(2, gc_manager.GetBacklogVersionCount());
+
+  // The backlog is above the threshold
+  EXPECT_EQ(metrics.throttled_txn_count_ + 1,
+            new_metrics.throttled_txn_count_);
+
+  gc_manager.SetWriterThrottle(false);
+  EXPECT_FALSE(gc_manager.IsWriterThrottleEnabled());
+
+  gc::GCManagerFactory::Configure(0);
+}
+
 TEST_F(TransactionLevelGCManagerTests, StartGC) {
 
   std::vector<std::unique_ptr<std::thread>> gc_threads;
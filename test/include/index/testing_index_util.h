@@ -50,15 +50,24 @@ class TestingIndexUtil {
 
   static void NonUniqueKeyMultiThreadedStressTest2(const IndexType index_type);
 
+  static void BulkInsertTest(const IndexType index_type);
+
+  static void PartitionedIndexTest(const IndexType index_type,
+                                   const IndexPartitionType partition_type);
+
   //===--------------------------------------------------------------------===//
   // Utility Methods
   //===--------------------------------------------------------------------===//
 
   /**
    * Builds an index with 4 columns, the first 2 being indexed
+   *
+   * A partitioned index has 4 partitions; range partitions split the
+   * first column at 250, 500 and 750
    */
-  static index::Index *BuildIndex(const IndexType index_type,
-                                  const bool unique_keys);
+  static index::Index *BuildIndex(
+      const IndexType index_type, const bool unique_keys,
+      const IndexPartitionType partition_type = IndexPartitionType::INVALID);
 
   /**
    * Insert helper function
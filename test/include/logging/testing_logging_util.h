@@ -58,6 +58,21 @@ class TestingLoggingUtil {
 
   static std::vector<std::shared_ptr<storage::Tuple>> BuildTuples(
       storage::DataTable *table, int num_rows, bool mutate, bool random);
+
+  // Starts write ahead logging to the files of a fresh log directory, with
+  // a single frontend logger that the test drives. Backend loggers are bound
+  // to their thread and dropped with the frontend logger, so transactions
+  // are logged from threads of their own.
+  static logging::WriteAheadFrontendLogger *StartFileLogging();
+
+  // Writes what the backends logged to the log file and drops the loggers,
+  // as a crash would
+  static void CrashFileLogging(
+      logging::WriteAheadFrontendLogger *frontend_logger);
+
+  // Replays the log files into the tables of the catalog and rebuilds their
+  // indexes
+  static void RecoverFromLogFiles();
 };
 
 // Operation of the logger
@@ -65,5 +65,16 @@ TEST_F(BwTreeIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::BWTREE);
 }
 
+TEST_F(BwTreeIndexTests, BulkInsertTest) {
+  TestingIndexUtil::BulkInsertTest(IndexType::BWTREE);
+}
+
+TEST_F(BwTreeIndexTests, PartitionedIndexTest) {
+  TestingIndexUtil::PartitionedIndexTest(IndexType::BWTREE,
+                                         IndexPartitionType::HASH);
+  TestingIndexUtil::PartitionedIndexTest(IndexType::BWTREE,
+                                         IndexPartitionType::RANGE);
+}
+
 }  // End test namespace
 }  // End peloton namespace
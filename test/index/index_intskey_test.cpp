@@ -15,8 +15,10 @@
 
 #include "common/logger.h"
 #include "common/platform.h"
+#include "common/simd_util.h"
 #include "common/timer.h"
 #include "index/index_factory.h"
+#include "index/index_key.h"
 #include "storage/tuple.h"
 
 namespace peloton {
@@ -234,6 +236,59 @@ TEST_F(IndexIntsKeyTests, IndexIntsKeyTest) {
   }
 }
 
+TEST_F(IndexIntsKeyTests, SimdCompareTest) {
+  // Buffers of every length up to a few AVX2 strides, differing at each
+  // position in turn, must agree with memcmp()
+  const size_t max_length = 3 * SIMD_AVX2_MIN_LENGTH + 7;
+  std::vector<unsigned char> lhs(max_length), rhs(max_length);
+  for (size_t i = 0; i < max_length; i++) {
+    lhs[i] = rhs[i] = static_cast<unsigned char>(rand());
+  }
+
+  for (size_t length = 0; length <= max_length; length++) {
+    EXPECT_EQ(length, FindFirstMismatch(lhs.data(), rhs.data(), length));
+    EXPECT_EQ(0, SimdCompareBytes(lhs.data(), rhs.data(), length));
+
+    for (size_t pos = 0; pos < length; pos++) {
+      unsigned char saved = rhs[pos];
+      rhs[pos] = static_cast<unsigned char>(saved + 1 + rand() % 255);
+
+      EXPECT_EQ(pos, FindFirstMismatch(lhs.data(), rhs.data(), length));
+      int expected = memcmp(lhs.data(), rhs.data(), length);
+      int actual = SimdCompareBytes(lhs.data(), rhs.data(), length);
+      EXPECT_EQ(expected < 0, actual < 0);
+      EXPECT_EQ(expected > 0, actual > 0);
+
+      rhs[pos] = saved;
+    }
+  }
+
+  // CompactIntsKey ordering must follow the signed order of its integers
+  index::CompactIntsKey<1> key1_a, key1_b;
+  index::CompactIntsKey<3> key3_a, key3_b;
+  for (int i = 0; i < NUM_TUPLES; i++) {
+    int64_t a = static_cast<int64_t>(rand()) - RAND_MAX / 2;
+    int64_t b = static_cast<int64_t>(rand()) - RAND_MAX / 2;
+    if (i % 8 == 0) b = a;
+
+    key1_a.ZeroOut();
+    key1_b.ZeroOut();
+    key1_a.AddInteger<int64_t>(a, 0);
+    key1_b.AddInteger<int64_t>(b, 0);
+    EXPECT_EQ(a < b, index::CompactIntsKey<1>::LessThan(key1_a, key1_b));
+    EXPECT_EQ(a == b, index::CompactIntsKey<1>::Equals(key1_a, key1_b));
+
+    key3_a.ZeroOut();
+    key3_b.ZeroOut();
+    key3_a.AddInteger<int64_t>(i, 0);
+    key3_b.AddInteger<int64_t>(i, 0);
+    key3_a.AddInteger<int64_t>(a, 16);
+    key3_b.AddInteger<int64_t>(b, 16);
+    EXPECT_EQ(a < b, index::CompactIntsKey<3>::LessThan(key3_a, key3_b));
+    EXPECT_EQ(a == b, index::CompactIntsKey<3>::Equals(key3_a, key3_b));
+  }
+}
+
 // FIXME: The B-Tree core dumps. If we're not going to support then we should
 // probably drop it.
 // TEST_F(IndexIntsKeyTests, BTreeTest) {
@@ -20,6 +20,7 @@
 #include "common/logger.h"
 #include "index/index.h"
 #include "index/index_util.h"
+#include "index/partitioned_index.h"
 #include "storage/tuple.h"
 #include "type/types.h"
 
@@ -653,8 +654,196 @@ void TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(const IndexType inde
 }
 
 
-index::Index *TestingIndexUtil::BuildIndex(const IndexType index_type,
-                                           const bool unique_keys) {
+void TestingIndexUtil::BulkInsertTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(
+      TestingIndexUtil::BuildIndex(index_type, false));
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Keys are generated out of order, and every key has two locations
+  const size_t key_count = 1000;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<std::unique_ptr<ItemPointer>> locations;
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+
+  for (size_t i = 0; i < key_count; i++) {
+    int key_value = static_cast<int>((i * 7919) % key_count);
+    for (size_t j = 0; j < 2; j++) {
+      std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+      key->SetValue(0, type::ValueFactory::GetIntegerValue(key_value), pool);
+      key->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+
+      std::unique_ptr<ItemPointer> location(new ItemPointer(key_value, j));
+
+      entries.emplace_back(key.get(), location.get());
+      keys.push_back(std::move(key));
+      locations.push_back(std::move(location));
+    }
+  }
+
+  // BULK INSERT
+  EXPECT_TRUE(index->BulkInsertEntries(entries));
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(2 * key_count, location_ptrs.size());
+  location_ptrs.clear();
+
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  key0->SetValue(0, type::ValueFactory::GetIntegerValue(500), pool);
+  key0->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  EXPECT_EQ(500, location_ptrs[0]->block);
+  location_ptrs.clear();
+
+  // The bulk loaded index must keep working with regular operations
+  index->InsertEntry(key0.get(), TestingIndexUtil::item0.get());
+  for (auto &location : locations) {
+    if (location->block == 500 && location->offset == 0) {
+      EXPECT_TRUE(index->DeleteEntry(key0.get(), location.get()));
+    }
+  }
+
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(2 * key_count, location_ptrs.size());
+  location_ptrs.clear();
+
+  // A second batch goes into the non-empty index one entry at a time
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  key1->SetValue(0, type::ValueFactory::GetIntegerValue(100000), pool);
+  key1->SetValue(1, type::ValueFactory::GetVarcharValue("b"), pool);
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> more_entries;
+  more_entries.emplace_back(key1.get(), TestingIndexUtil::item1.get());
+
+  EXPECT_TRUE(index->BulkInsertEntries(more_entries));
+
+  index->ScanKey(key1.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  // BULK DELETE
+  // The second location of every key goes in one batch
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> stale_entries;
+  for (auto &entry : entries) {
+    if (entry.second->offset == 1) {
+      stale_entries.push_back(entry);
+    }
+  }
+
+  EXPECT_EQ(key_count, index->BulkDeleteEntries(stale_entries));
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count + 1, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Entries that are gone already are not counted
+  EXPECT_EQ(0, index->BulkDeleteEntries(stale_entries));
+
+  delete index->GetMetadata()->GetTupleSchema();
+
+  // Duplicated keys are rejected by a unique index
+  std::unique_ptr<index::Index> unique_index(
+      TestingIndexUtil::BuildIndex(index_type, true));
+
+  EXPECT_FALSE(unique_index->BulkInsertEntries(entries));
+
+  unique_index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+
+  delete unique_index->GetMetadata()->GetTupleSchema();
+}
+
+void TestingIndexUtil::PartitionedIndexTest(
+    const IndexType index_type, const IndexPartitionType partition_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(
+      TestingIndexUtil::BuildIndex(index_type, true, partition_type));
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  auto partitioned_index = dynamic_cast<index::PartitionedIndex *>(index.get());
+  EXPECT_TRUE(partitioned_index != nullptr);
+  EXPECT_EQ(4, partitioned_index->GetPartitionCount());
+
+  // Monotonically increasing keys
+  const int key_count = 1000;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<std::unique_ptr<ItemPointer>> locations;
+  for (int i = 0; i < key_count; i++) {
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    key->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+
+    std::unique_ptr<ItemPointer> location(new ItemPointer(i, 0));
+    EXPECT_TRUE(index->CondInsertEntry(key.get(), location.get(),
+                                       [](const void *) { return true; }));
+
+    keys.push_back(std::move(key));
+    locations.push_back(std::move(location));
+  }
+
+  // Keys are spread over all partitions
+  for (size_t partition_itr = 0;
+       partition_itr < partitioned_index->GetPartitionCount();
+       partition_itr++) {
+    partitioned_index->GetPartition(partition_itr)->ScanAllKeys(location_ptrs);
+    EXPECT_LT(0, location_ptrs.size());
+    location_ptrs.clear();
+  }
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Unique keys are still checked across the logical index
+  EXPECT_FALSE(index->CondInsertEntry(keys[600].get(),
+                                      TestingIndexUtil::item0.get(),
+                                      [](const void *) { return true; }));
+
+  index->ScanKey(keys[600].get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(600, location_ptrs[0]->block);
+  location_ptrs.clear();
+
+  // Range scans return keys in order across partitions
+  index->ScanTest({type::ValueFactory::GetIntegerValue(100),
+                   type::ValueFactory::GetIntegerValue(899)},
+                  {0, 0}, {ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                           ExpressionType::COMPARE_LESSTHANOREQUALTO},
+                  ScanDirectionType::FORWARD, location_ptrs);
+  EXPECT_EQ(800, location_ptrs.size());
+  for (size_t i = 0; i < location_ptrs.size(); i++) {
+    EXPECT_EQ(100 + i, location_ptrs[i]->block);
+  }
+  location_ptrs.clear();
+
+  // Deletes go to the partition of the key
+  EXPECT_TRUE(index->DeleteEntry(keys[600].get(), locations[600].get()));
+  index->ScanKey(keys[600].get(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+
+  delete index->GetMetadata()->GetTupleSchema();
+}
+
+index::Index *TestingIndexUtil::BuildIndex(
+    const IndexType index_type, const bool unique_keys,
+    const IndexPartitionType partition_type) {
   LOG_DEBUG("Build index type: %s", IndexTypeToString(index_type).c_str());
 
   catalog::Schema *key_schema = nullptr;
@@ -711,6 +900,13 @@ index::Index *TestingIndexUtil::BuildIndex(const IndexType index_type,
       INVALID_OID, INVALID_OID, index_type, IndexConstraintType::DEFAULT,
       tuple_schema, key_schema, key_attrs, unique_keys);
 
+  if (partition_type != IndexPartitionType::INVALID) {
+    index_metadata->SetPartitioning(
+        partition_type, 4, {type::ValueFactory::GetIntegerValue(250),
+                            type::ValueFactory::GetIntegerValue(500),
+                            type::ValueFactory::GetIntegerValue(750)});
+  }
+
   // Build index
   //
   // The type of index key has been chosen inside this function, but we are
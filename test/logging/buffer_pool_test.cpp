@@ -157,6 +157,33 @@ TEST_F(BufferPoolTests, LargeTupleRecordTest) {
   EXPECT_EQ(success, true);
 }
 
+TEST_F(BufferPoolTests, InPlaceSerializationTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  auto default_capacity = log_manager.GetLogBufferCapacity();
+  log_manager.SetLogBufferCapacity(32);
+
+  logging::LogBuffer log_buffer(nullptr);
+  std::string expected;
+  for (cid_t cid = 1; cid <= 4; cid++) {
+    logging::TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, cid);
+    CopySerializeOutput output_buffer;
+    record.Serialize(output_buffer);
+    expected.append(record.GetMessage(), record.GetMessageLength());
+
+    EXPECT_TRUE(log_buffer.WriteRecord(&record));
+  }
+
+  // the records did not fit into the initial capacity
+  EXPECT_TRUE(log_buffer.IsFull());
+  EXPECT_EQ(expected.size(), log_buffer.GetSize());
+  EXPECT_EQ(expected, std::string(log_buffer.GetData(), log_buffer.GetSize()));
+
+  log_buffer.ResetData();
+  EXPECT_FALSE(log_buffer.IsFull());
+
+  log_manager.SetLogBufferCapacity(default_capacity);
+}
+
 TEST_F(BufferPoolTests, BufferPoolConcurrentTest) {
   unsigned int txn_count = 9999;
 
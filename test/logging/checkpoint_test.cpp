@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
 #include <numeric>
+#include <thread>
 
 #include "common/harness.h"
 #include "catalog/catalog.h"
@@ -19,10 +21,13 @@
 #include "logging/testing_logging_util.h"
 #include "logging/logging_util.h"
 #include "logging/loggers/wal_backend_logger.h"
+#include "logging/checkpoint/fuzzy_checkpoint.h"
+#include "logging/checkpoint/image_checkpoint.h"
 #include "logging/checkpoint/simple_checkpoint.h"
 #include "logging/checkpoint_manager.h"
 #include "storage/database.h"
 
+#include "concurrency/testing_transaction_util.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/logical_tile_factory.h"
 #include "index/index.h"
@@ -244,5 +249,201 @@ TEST_F(CheckpointTests, CheckpointModeTransitionTest) {
   thread.join();
 }
 
+TEST_F(CheckpointTests, FuzzyCheckpointTest) {
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const int num_key = 300;
+  const size_t updater_count = 2;
+  oid_t default_table_oid = 13;
+
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+
+  // keys 0 to num_key - 1 with value 0, over 3 tile groups
+  storage::DataTable *target_table = TestingTransactionUtil::CreateTable(
+      num_key, "TEST_TABLE", DEFAULT_DB_ID, default_table_oid);
+
+  // each updater keeps setting its own keys to increasing values, and
+  // records the commit id of every update
+  struct CommittedUpdate {
+    cid_t commit_id;
+    int key;
+    int value;
+  };
+  std::vector<std::vector<CommittedUpdate>> committed_updates(updater_count);
+  std::vector<std::atomic<cid_t>> begun_cids(updater_count);
+  std::vector<std::atomic<size_t>> commit_counts(updater_count);
+  std::atomic<bool> stop_updates(false);
+  std::vector<std::thread> updater_threads;
+  for (size_t updater = 0; updater < updater_count; updater++) {
+    begun_cids[updater] = 0;
+    commit_counts[updater] = 0;
+    updater_threads.emplace_back([&, updater] {
+      int value = 0;
+      int key = updater;
+      while (stop_updates == false) {
+        auto txn = txn_manager.BeginTransaction();
+        cid_t commit_id = txn->GetBeginCommitId();
+        begun_cids[updater] = commit_id;
+
+        value++;
+        if (TestingTransactionUtil::ExecuteUpdate(txn, target_table, key,
+                                                  value) == false) {
+          txn_manager.AbortTransaction(txn);
+          continue;
+        }
+        if (txn_manager.CommitTransaction(txn) == ResultType::SUCCESS) {
+          committed_updates[updater].push_back({commit_id, key, value});
+          commit_counts[updater]++;
+        }
+
+        key += updater_count;
+        if (key >= num_key) {
+          key = updater;
+        }
+      }
+    });
+  }
+
+  // let the updaters go over all their keys once
+  for (size_t updater = 0; updater < updater_count; updater++) {
+    while (commit_counts[updater] < num_key / updater_count) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  // the snapshot covers the transactions that began before it, which all
+  // ended once every updater began a later one. the checkpoint is taken
+  // while the updates go on
+  auto snapshot_txn = txn_manager.BeginTransaction();
+  cid_t snapshot_cid = snapshot_txn->GetBeginCommitId();
+  txn_manager.CommitTransaction(snapshot_txn);
+  for (size_t updater = 0; updater < updater_count; updater++) {
+    while (begun_cids[updater] < snapshot_cid) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  logging::FuzzyCheckpoint fuzzy_checkpoint(false);
+  fuzzy_checkpoint.SetScannerCount(2);
+  fuzzy_checkpoint.TakeCheckpoint(snapshot_cid);
+  EXPECT_EQ(num_key, fuzzy_checkpoint.GetCheckpointedTupleCount());
+
+  stop_updates = true;
+  for (auto &updater_thread : updater_threads) {
+    updater_thread.join();
+  }
+
+  // the values as of the snapshot
+  std::vector<int> expected_values(num_key, 0);
+  std::vector<cid_t> expected_cids(num_key, 0);
+  size_t later_update_count = 0;
+  for (auto &updates : committed_updates) {
+    for (auto &update : updates) {
+      if (update.commit_id > snapshot_cid) {
+        later_update_count++;
+      } else if (update.commit_id > expected_cids[update.key]) {
+        expected_cids[update.key] = update.commit_id;
+        expected_values[update.key] = update.value;
+      }
+    }
+  }
+  EXPECT_LT(0, later_update_count);
+
+  // replace the table with an empty one, and restore it from the checkpoint
+  db->DropTableWithOid(default_table_oid);
+  TestingTransactionUtil::CreateTable(0, "TEST_TABLE", DEFAULT_DB_ID,
+                                      default_table_oid);
+
+  logging::FuzzyCheckpoint recovery_checkpoint(false);
+  EXPECT_EQ(snapshot_cid, recovery_checkpoint.DoRecovery());
+
+  // every key holds exactly its version of the snapshot
+  auto recovered_table = db->GetTableWithOid(default_table_oid);
+  EXPECT_EQ(num_key, recovered_table->GetTupleCount());
+  std::vector<int> recovered_versions(num_key, 0);
+  auto tile_group_count = recovered_table->GetTileGroupCount();
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = recovered_table->GetTileGroup(tile_group_offset);
+    auto tile_group_header = tile_group->GetHeader();
+    for (oid_t tuple_slot = 0; tuple_slot < tile_group->GetNextTupleSlot();
+         tuple_slot++) {
+      if (tile_group_header->GetTransactionId(tuple_slot) != INITIAL_TXN_ID) {
+        continue;
+      }
+      int key = tile_group->GetValue(tuple_slot, 0).GetAs<int32_t>();
+      int value = tile_group->GetValue(tuple_slot, 1).GetAs<int32_t>();
+      ASSERT_LE(0, key);
+      ASSERT_GT(num_key, key);
+      EXPECT_EQ(expected_values[key], value);
+      recovered_versions[key]++;
+    }
+  }
+  for (int key = 0; key < num_key; key++) {
+    EXPECT_EQ(1, recovered_versions[key]);
+  }
+
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+}
+
+TEST_F(CheckpointTests, ImageCheckpointTest) {
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+  size_t table_tile_group_count = 3;
+  size_t num_rows = tile_group_size * table_tile_group_count;
+  oid_t default_table_oid = 13;
+
+  // table has 3 tile groups
+  auto txn = txn_manager.BeginTransaction();
+  storage::DataTable *target_table = TestingExecutorUtil::CreateTable(
+      tile_group_size, false, default_table_oid);
+  TestingExecutorUtil::PopulateTable(target_table, num_rows, false, false,
+                                     false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // add table to catalog
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  db->AddTable(target_table);
+  catalog->AddDatabase(db);
+
+  auto tile_group = target_table->GetTileGroup(0);
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto inlined_value = tile_group->GetValue(1, 0).ToString();
+  auto uninlined_value = tile_group->GetValue(1, 3).ToString();
+  tile_group.reset();
+
+  cid_t snapshot_cid = txn_manager.GetNextCommitId();
+  logging::ImageCheckpoint image_checkpoint(false);
+  image_checkpoint.TakeCheckpoint(snapshot_cid);
+  EXPECT_EQ(num_rows, image_checkpoint.GetCheckpointedTupleCount());
+
+  // replace the table with an empty one, and restore it from the checkpoint
+  db->DropTableWithOid(default_table_oid);
+  db->AddTable(TestingExecutorUtil::CreateTable(tile_group_size, false,
+                                                default_table_oid));
+
+  logging::ImageCheckpoint recovery_checkpoint(false);
+  EXPECT_EQ(snapshot_cid, recovery_checkpoint.DoRecovery());
+  EXPECT_EQ(table_tile_group_count,
+            recovery_checkpoint.GetMappedTileGroupCount());
+  EXPECT_EQ(num_rows, db->GetTableWithOid(default_table_oid)->GetTupleCount());
+
+  // the mapped tile group holds the values of the checkpoint
+  tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  EXPECT_EQ(inlined_value, tile_group->GetValue(1, 0).ToString());
+  EXPECT_EQ(uninlined_value, tile_group->GetValue(1, 3).ToString());
+  tile_group.reset();
+
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_compression_test.cpp
+//
+// Identification: test/logging/log_compression_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+
+#include "logging/log_buffer.h"
+#include "logging/log_compression.h"
+#include "logging/log_manager.h"
+#include "logging/records/transaction_record.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Log Compression Tests
+//===--------------------------------------------------------------------===//
+
+class LogCompressionTests : public PelotonTest {};
+
+TEST_F(LogCompressionTests, RoundTripTest) {
+  // a log buffer of commit records compresses well
+  logging::LogBuffer log_buffer(nullptr);
+  for (cid_t cid = 1; cid <= 1000; cid++) {
+    logging::TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, cid);
+    log_buffer.WriteRecord(&record);
+  }
+
+  for (auto compression_type :
+       {LogCompressionType::LZ4, LogCompressionType::ZSTD}) {
+    if (!logging::LogCompression::IsSupported(compression_type)) {
+      continue;
+    }
+
+    std::vector<char> compressed;
+    size_t compressed_length = logging::LogCompression::Compress(
+        compression_type, DEFAULT_LOG_COMPRESSION_LEVEL, log_buffer.GetData(),
+        log_buffer.GetSize(), compressed);
+    EXPECT_GT(compressed_length, 0);
+    EXPECT_LT(compressed_length, log_buffer.GetSize());
+
+    std::vector<char> decompressed(log_buffer.GetSize());
+    EXPECT_TRUE(logging::LogCompression::Decompress(
+        compression_type, compressed.data(), compressed_length,
+        decompressed.data(), decompressed.size()));
+    EXPECT_EQ(0, memcmp(log_buffer.GetData(), decompressed.data(),
+                        decompressed.size()));
+
+    // a truncated block is rejected
+    EXPECT_FALSE(logging::LogCompression::Decompress(
+        compression_type, compressed.data(), compressed_length / 2,
+        decompressed.data(), decompressed.size()));
+  }
+}
+
+TEST_F(LogCompressionTests, ConfigurationTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  EXPECT_EQ(LogCompressionType::NONE, log_manager.GetLogCompressionType());
+
+  for (auto compression_type :
+       {LogCompressionType::LZ4, LogCompressionType::ZSTD}) {
+    log_manager.SetLogCompression(compression_type, 3);
+
+    // codecs missing from the build fall back to no compression
+    if (logging::LogCompression::IsSupported(compression_type)) {
+      EXPECT_EQ(compression_type, log_manager.GetLogCompressionType());
+    } else {
+      EXPECT_EQ(LogCompressionType::NONE, log_manager.GetLogCompressionType());
+    }
+  }
+
+  log_manager.SetLogCompression(LogCompressionType::NONE);
+  EXPECT_EQ(DEFAULT_LOG_COMPRESSION_LEVEL,
+            log_manager.GetLogCompressionLevel());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -14,8 +14,13 @@
 #include "logging/testing_logging_util.h"
 #include "catalog/catalog.h"
 #include "common/harness.h"
+#include "concurrency/testing_transaction_util.h"
 
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/ssi_txn_manager.h"
+#include "concurrency/ssn_txn_manager.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "logging/backend_logger.h"
 #include "executor/logical_tile_factory.h"
 #include "logging/loggers/wal_frontend_logger.h"
 #include "logging/logging_util.h"
@@ -371,5 +376,270 @@ TEST_F(LoggingTests, BasicLogManagerTest) {
   log_manager.EndLogging();
 }
 
+TEST_F(LoggingTests, EpochGroupCommitTest) {
+  std::unique_ptr<storage::DataTable> table(TestingExecutorUtil::CreateTable(1));
+
+  auto &log_manager = logging::LogManager::GetInstance();
+
+  concurrency::EpochManagerFactory::Configure(EpochType::DECENTRALIZED_EPOCH);
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+  log_manager.SetEpochGroupCommit(true);
+
+  LoggingScheduler scheduler(1, 1, &log_manager, table.get());
+
+  scheduler.Init();
+  // The first flush of the epoch goes through
+  scheduler.BackendLogger(0, 0).Prepare();
+  scheduler.BackendLogger(0, 0).Begin(2);
+  scheduler.BackendLogger(0, 0).Insert(2);
+  scheduler.BackendLogger(0, 0).Commit(2);
+  scheduler.FrontendLogger(0).Collect();
+  scheduler.FrontendLogger(0).Flush();
+  // Later commits of the same epoch wait for it to end
+  scheduler.BackendLogger(0, 0).Prepare();
+  scheduler.BackendLogger(0, 0).Begin(3);
+  scheduler.BackendLogger(0, 0).Insert(3);
+  scheduler.BackendLogger(0, 0).Commit(3);
+  scheduler.FrontendLogger(0).Collect();
+  scheduler.FrontendLogger(0).Flush();
+  scheduler.Run();
+
+  auto results = scheduler.frontend_threads[0].results;
+  EXPECT_EQ(2, results[0]);
+  EXPECT_EQ(2, results[1]);
+
+  // The next epoch flushes the whole group
+  epoch_manager.Reset(2);
+  auto frontend_logger = reinterpret_cast<logging::WriteAheadFrontendLogger *>(
+      log_manager.GetFrontendLogger(0));
+  frontend_logger->FlushLogRecords();
+  EXPECT_EQ(3, frontend_logger->GetMaxFlushedCommitId());
+
+  log_manager.SetEpochGroupCommit(false);
+  scheduler.Cleanup();
+}
+
+TEST_F(LoggingTests, PipelinedSyncTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  auto frontend_logger = TestingLoggingUtil::StartFileLogging();
+  log_manager.SetSyncCommit(true);
+
+  // the commit waits for its flush, which the sync thread of the log file
+  // completes
+  cid_t commit_id = 2;
+  std::atomic<bool> committed(false);
+  size_t fsync_count_at_commit = 0;
+  std::thread backend_thread([&] {
+    log_manager.PrepareLogging();
+    log_manager.LogBeginTransaction(commit_id);
+    log_manager.LogCommitTransaction(commit_id);
+    fsync_count_at_commit = log_manager.GetFsyncCount();
+    committed = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(committed);
+
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+  backend_thread.join();
+
+  EXPECT_TRUE(committed);
+  EXPECT_EQ(1, fsync_count_at_commit);
+  EXPECT_EQ(commit_id, frontend_logger->GetMaxFlushedCommitId());
+  EXPECT_EQ(commit_id, log_manager.GetPersistentFlushedCommitId());
+
+  TestingLoggingUtil::CrashFileLogging(frontend_logger);
+}
+
+// Parse the records a backend logger holds, without handing them over to
+// the frontend logger
+static std::vector<std::pair<LogRecordType, cid_t>> CollectBackendLogRecords(
+    logging::BackendLogger *backend_logger) {
+  std::vector<std::pair<LogRecordType, cid_t>> records;
+  FILE *record_file = tmpfile();
+  size_t record_size = 0;
+  for (auto &log_buffer : backend_logger->GetLogBuffers()) {
+    fwrite(log_buffer->GetData(), sizeof(char), log_buffer->GetSize(),
+           record_file);
+    record_size += log_buffer->GetSize();
+  }
+  rewind(record_file);
+  FileHandle file_handle(record_file, fileno(record_file), record_size);
+
+  while (true) {
+    auto record_type = logging::LoggingUtil::GetNextLogRecordType(file_handle);
+    if (record_type == LOGRECORD_TYPE_TRANSACTION_BEGIN ||
+        record_type == LOGRECORD_TYPE_TRANSACTION_COMMIT) {
+      logging::TransactionRecord txn_record(record_type);
+      if (logging::LoggingUtil::ReadTransactionRecordHeader(
+              txn_record, file_handle) == false) {
+        break;
+      }
+      records.emplace_back(record_type, txn_record.GetTransactionId());
+    } else if (record_type == LOGRECORD_TYPE_WAL_TUPLE_INSERT ||
+               record_type == LOGRECORD_TYPE_WAL_TUPLE_UPDATE ||
+               record_type == LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE ||
+               record_type == LOGRECORD_TYPE_WAL_TUPLE_DELETE) {
+      logging::TupleRecord tuple_record(record_type);
+      if (logging::LoggingUtil::ReadTupleRecordHeader(
+              tuple_record, file_handle) == false) {
+        break;
+      }
+      if (record_type != LOGRECORD_TYPE_WAL_TUPLE_DELETE) {
+        logging::LoggingUtil::SkipTupleRecordBody(file_handle);
+      }
+      records.emplace_back(record_type, tuple_record.GetTransactionId());
+    } else {
+      break;
+    }
+  }
+
+  fclose(record_file);
+  return records;
+}
+
+TEST_F(LoggingTests, SerializableCommitLoggingTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+
+  for (auto protocol : {ConcurrencyType::CONCURRENCY_TYPE_SSI,
+                        ConcurrencyType::CONCURRENCY_TYPE_SI_SSN}) {
+    concurrency::TransactionManagerFactory::Configure(protocol);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+    auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+    oid_t db_id = database->GetOid();
+    auto frontend_logger = TestingLoggingUtil::StartFileLogging();
+
+    storage::DataTable *table = nullptr;
+    std::thread populate_thread([&] {
+      table = TestingTransactionUtil::CreateTable(2, "TEST_TABLE", db_id,
+                                                  12345, 1234, true);
+    });
+    populate_thread.join();
+
+    // a commit logs its begin, its update and its commit, in that order
+    ResultType commit_result = ResultType::INVALID;
+    logging::BackendLogger *commit_logger = nullptr;
+    std::thread commit_thread([&] {
+      auto txn = txn_manager.BeginTransaction();
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 0, 100));
+      commit_result = txn_manager.CommitTransaction(txn);
+      commit_logger = log_manager.GetBackendLogger();
+    });
+    commit_thread.join();
+    EXPECT_EQ(ResultType::SUCCESS, commit_result);
+
+    commit_logger->PrepareLogBuffers();
+    auto records = CollectBackendLogRecords(commit_logger);
+    EXPECT_EQ(3, records.size());
+    if (records.size() == 3) {
+      EXPECT_EQ(LOGRECORD_TYPE_TRANSACTION_BEGIN, records[0].first);
+      EXPECT_TRUE(records[1].first == LOGRECORD_TYPE_WAL_TUPLE_UPDATE ||
+                  records[1].first == LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE);
+      EXPECT_EQ(LOGRECORD_TYPE_TRANSACTION_COMMIT, records[2].first);
+      EXPECT_NE(INVALID_CID, records[0].second);
+      EXPECT_EQ(records[0].second, records[1].second);
+      EXPECT_EQ(records[0].second, records[2].second);
+    }
+
+    // the frontend logger has now seen a commit, so preparing to log raises
+    // the lower bound of a backend logger above the invalid cid
+    frontend_logger->CollectLogRecordsFromBackendLoggers();
+
+    // a committed read of the new version raises its pstamp under ssn
+    std::thread read_thread([&] {
+      auto txn = txn_manager.BeginTransaction();
+      int result = -1;
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 0, result));
+      EXPECT_EQ(100, result);
+      EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+    });
+    read_thread.join();
+
+    // an rw-conflict abort logs nothing and resets the lower bound it set
+    ResultType abort_result = ResultType::INVALID;
+    logging::BackendLogger *abort_logger = nullptr;
+    std::thread abort_thread([&] {
+      auto txn = txn_manager.BeginTransaction();
+      int result = -1;
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 1, result));
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 0, 200));
+
+      // stand in for the concurrent readers and writers of a dangerous
+      // structure
+      if (protocol == ConcurrencyType::CONCURRENCY_TYPE_SSI) {
+        concurrency::current_ssi_txn_ctx->in_conflict_ = true;
+        concurrency::current_ssi_txn_ctx->out_conflict_ = true;
+      } else {
+        concurrency::current_ssn_txn_ctx->sstamp = 0;
+      }
+      abort_result = txn_manager.CommitTransaction(txn);
+      abort_logger = log_manager.GetBackendLogger();
+    });
+    abort_thread.join();
+    EXPECT_EQ(ResultType::ABORTED, abort_result);
+
+    auto logged_cids = abort_logger->PrepareLogBuffers();
+    EXPECT_EQ(INVALID_CID, logged_cids.first);
+    EXPECT_EQ(0, CollectBackendLogRecords(abort_logger).size());
+
+    TestingLoggingUtil::CrashFileLogging(frontend_logger);
+    TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+TEST_F(LoggingTests, FullBufferCommitTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  auto log_buffer_capacity = log_manager.GetLogBufferCapacity();
+
+  // the commit record exactly fills the buffer of the transaction
+  cid_t commit_id = 2;
+  logging::TransactionRecord begin_record(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                          commit_id);
+  logging::TransactionRecord commit_record(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           commit_id);
+  CopySerializeOutput begin_output;
+  begin_record.Serialize(begin_output);
+  CopySerializeOutput commit_output;
+  commit_record.Serialize(commit_output);
+  log_manager.SetLogBufferCapacity(begin_record.GetMessageLength() +
+                                   commit_record.GetMessageLength());
+
+  auto frontend_logger = TestingLoggingUtil::StartFileLogging();
+  log_manager.SetSyncCommit(true);
+
+  std::atomic<bool> committed(false);
+  std::thread backend_thread([&] {
+    log_manager.PrepareLogging();
+    log_manager.LogBeginTransaction(commit_id);
+    log_manager.LogCommitTransaction(commit_id);
+    committed = true;
+  });
+
+  // the full buffer still reports the commit, so one collection releases it
+  for (int attempt = 0; attempt < 50 && committed == false; attempt++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    frontend_logger->CollectLogRecordsFromBackendLoggers();
+    frontend_logger->FlushLogRecords();
+  }
+  EXPECT_TRUE(committed);
+  EXPECT_EQ(commit_id, frontend_logger->GetMaxFlushedCommitId());
+
+  // do not leave the backend waiting if the commit was lost
+  if (committed == false) {
+    frontend_logger->SetMaxFlushedCommitId(commit_id);
+    log_manager.FrontendLoggerFlushed();
+  }
+  backend_thread.join();
+
+  TestingLoggingUtil::CrashFileLogging(frontend_logger);
+  log_manager.SetLogBufferCapacity(log_buffer_capacity);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -15,18 +15,24 @@
 #include <sys/mman.h>
 #include <dirent.h>
 
+#include "concurrency/testing_transaction_util.h"
 #include "executor/testing_executor_util.h"
 #include "logging/testing_logging_util.h"
 #include "common/harness.h"
 #include "catalog/catalog.h"
+#include "catalog/manager.h"
 
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/logical_tile_factory.h"
 #include "storage/data_table.h"
 #include "storage/tile.h"
+#include "storage/tile_group_header.h"
 #include "logging/loggers/wal_frontend_logger.h"
 #include "logging/log_manager.h"
 #include "logging/logging_util.h"
+#include "logging/records/transaction_record.h"
+#include "logging/replication/replication_sender.h"
+#include "logging/replication/replication_standby.h"
 #include "index/index.h"
 #include "storage/database.h"
 #include "storage/table_factory.h"
@@ -234,6 +240,11 @@ TEST_F(RecoveryTests, RestartTest) {
 
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
+  // Replay and index with more threads than there are tables
+  log_manager.SetRecoveryThreadCount(0);
+  EXPECT_EQ(log_manager.GetRecoveryThreadCount(), 1);
+  log_manager.SetRecoveryThreadCount(2);
+
   wal_fel.DoRecovery();
 
   LOG_TRACE("recovery_table tile group count after recovery: %ld",
@@ -250,6 +261,7 @@ TEST_F(RecoveryTests, RestartTest) {
     EXPECT_EQ(index->GetNumberOfTuples(),
               tile_group_size * table_tile_group_count - 1);
   }
+  log_manager.SetRecoveryThreadCount(DEFAULT_NUM_RECOVERY_THREADS);
 
   // TODO check a few more invariants here
   wal_fel.CreateNewLogFile(false);
@@ -376,6 +388,341 @@ TEST_F(RecoveryTests, BasicUpdateTest) {
   catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
 }
 
+TEST_F(RecoveryTests, BasicDeltaUpdateTest) {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto recovery_table = TestingExecutorUtil::CreateTable(1024);
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(recovery_table);
+
+  auto tuples = BuildLoggingTuples(recovery_table, 2, false, false);
+  EXPECT_EQ(tuples.size(), 2);
+  logging::WriteAheadFrontendLogger fel(true);
+  cid_t test_commit_id = 10;
+
+  type::Value val0 = (tuples[0]->GetValue(0));
+  type::Value val1 = (tuples[1]->GetValue(1));
+  type::Value val2 = (tuples[0]->GetValue(2));
+  type::Value val3 = (tuples[0]->GetValue(3));
+
+  // the old version holds the first tuple
+  auto insert_rec = new logging::TupleRecord(
+      LOGRECORD_TYPE_TUPLE_INSERT, test_commit_id, recovery_table->GetOid(),
+      ItemPointer(100, 4), INVALID_ITEMPOINTER, tuples[0], DEFAULT_DB_ID);
+  insert_rec->SetTuple(tuples[0]);
+  fel.InsertTuple(insert_rec);
+  delete insert_rec;
+
+  // the delta only carries the second column
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  storage::Tuple *delta_tuple =
+      new storage::Tuple(recovery_table->GetSchema(), true);
+  delta_tuple->SetValue(1, val1, testing_pool);
+
+  auto update_rec = new logging::TupleRecord(
+      LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE, test_commit_id + 1,
+      recovery_table->GetOid(), ItemPointer(100, 5), ItemPointer(100, 4),
+      delta_tuple, DEFAULT_DB_ID);
+  update_rec->SetTuple(delta_tuple);
+  update_rec->SetColumnIds({1});
+  fel.UpdateTuple(update_rec);
+  delete update_rec;
+  delete tuples[1];
+
+  auto tg_header = recovery_table->GetTileGroupById(100)->GetHeader();
+  EXPECT_EQ(tg_header->GetEndCommitId(5), MAX_CID);
+  EXPECT_EQ(tg_header->GetEndCommitId(4), test_commit_id + 1);
+
+  auto tile_group = recovery_table->GetTileGroupById(100);
+  EXPECT_TRUE(val0.CompareEquals(tile_group->GetValue(5, 0)) == type::CMP_TRUE);
+  EXPECT_TRUE(val1.CompareEquals(tile_group->GetValue(5, 1)) == type::CMP_TRUE);
+  EXPECT_TRUE(val2.CompareEquals(tile_group->GetValue(5, 2)) == type::CMP_TRUE);
+  EXPECT_TRUE(val3.CompareEquals(tile_group->GetValue(5, 3)) == type::CMP_TRUE);
+
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+}
+
+TEST_F(RecoveryTests, MultiTableRecoveryTest) {
+  // only the commits of ssi and ssn are logged
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::CONCURRENCY_TYPE_SSI);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(catalog->HasDatabase(db_id));
+
+  auto frontend_logger = TestingLoggingUtil::StartFileLogging();
+
+  const int num_key = 10;
+  const int round_count = 3;
+  std::vector<oid_t> table_oids = {12345, 12346};
+  std::vector<storage::DataTable *> tables(table_oids.size());
+  auto create_tables = [&](int key_count) {
+    for (size_t table_itr = 0; table_itr < tables.size(); table_itr++) {
+      tables[table_itr] = TestingTransactionUtil::CreateTable(
+          key_count, "TEST_TABLE_" + std::to_string(table_itr), db_id,
+          table_oids[table_itr], 1234 + table_itr, true);
+    }
+  };
+  std::thread populate_thread(create_tables, num_key);
+  populate_thread.join();
+
+  // the commit ids of the two tables interleave
+  for (int round = 1; round <= round_count; round++) {
+    for (size_t table_itr = 0; table_itr < tables.size(); table_itr++) {
+      TransactionScheduler scheduler(1, tables[table_itr], &txn_manager);
+      scheduler.Txn(0).Update(round, round * 10 + table_itr);
+      scheduler.Txn(0).Delete(num_key - round);
+      scheduler.Txn(0).Commit();
+      scheduler.Run();
+      EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+    }
+  }
+
+  TestingLoggingUtil::CrashFileLogging(frontend_logger);
+
+  // replay into fresh tables, each table by a thread of its own
+  for (auto table_oid : table_oids) {
+    database->DropTableWithOid(table_oid);
+  }
+  create_tables(0);
+
+  log_manager.SetRecoveryThreadCount(2);
+  TestingLoggingUtil::RecoverFromLogFiles();
+  log_manager.SetRecoveryThreadCount(DEFAULT_NUM_RECOVERY_THREADS);
+
+  for (size_t table_itr = 0; table_itr < tables.size(); table_itr++) {
+    // every live tuple is indexed exactly once
+    EXPECT_EQ(num_key - round_count,
+              tables[table_itr]->GetIndex(0)->GetNumberOfTuples());
+
+    TransactionScheduler scheduler(1, tables[table_itr], &txn_manager);
+    for (int key = 0; key < num_key; key++) {
+      scheduler.Txn(0).Read(key);
+    }
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+
+    auto &results = scheduler.schedules[0].results;
+    EXPECT_EQ(num_key, results.size());
+    for (int key = 0; key < (int)results.size(); key++) {
+      int value = 0;
+      if (key >= num_key - round_count) {
+        value = -1;
+      } else if (key >= 1 && key <= round_count) {
+        value = key * 10 + table_itr;
+      }
+      EXPECT_EQ(value, results[key]);
+    }
+  }
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+TEST_F(RecoveryTests, CompressedLogRecoveryTest) {
+  // only the commits of ssi and ssn are logged
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::CONCURRENCY_TYPE_SSI);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+
+  const int num_key = 20;
+  oid_t table_oid = 12347;
+  oid_t index_oid = 1236;
+
+  for (auto compression_type :
+       {LogCompressionType::LZ4, LogCompressionType::ZSTD}) {
+    if (!logging::LogCompression::IsSupported(compression_type)) {
+      continue;
+    }
+    log_manager.SetLogCompression(compression_type);
+    auto frontend_logger = TestingLoggingUtil::StartFileLogging();
+
+    storage::DataTable *table = nullptr;
+    std::thread populate_thread([&] {
+      table = TestingTransactionUtil::CreateTable(
+          num_key, "TEST_TABLE", db_id, table_oid, index_oid, true);
+    });
+    populate_thread.join();
+
+    // the records of a single transaction compress well
+    TransactionScheduler scheduler(1, table, &txn_manager);
+    for (int key = 0; key < num_key; key++) {
+      scheduler.Txn(0).Update(key, key + 100);
+    }
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+
+    frontend_logger->CollectLogRecordsFromBackendLoggers();
+    frontend_logger->FlushLogRecords();
+    EXPECT_LT(0, frontend_logger->GetCompressionStats().block_count);
+
+    TestingLoggingUtil::CrashFileLogging(frontend_logger);
+
+    // replay the compressed blocks into a fresh table
+    database->DropTableWithOid(table_oid);
+    table = TestingTransactionUtil::CreateTable(0, "TEST_TABLE", db_id,
+                                                table_oid, index_oid, true);
+    TestingLoggingUtil::RecoverFromLogFiles();
+
+    EXPECT_EQ(num_key, table->GetIndex(0)->GetNumberOfTuples());
+
+    TransactionScheduler read_scheduler(1, table, &txn_manager);
+    for (int key = 0; key < num_key; key++) {
+      read_scheduler.Txn(0).Read(key);
+    }
+    read_scheduler.Txn(0).Commit();
+    read_scheduler.Run();
+
+    auto &results = read_scheduler.schedules[0].results;
+    EXPECT_EQ(num_key, results.size());
+    for (int key = 0; key < (int)results.size(); key++) {
+      EXPECT_EQ(key + 100, results[key]);
+    }
+
+    database->DropTableWithOid(table_oid);
+  }
+
+  log_manager.SetLogCompression(LogCompressionType::NONE);
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+TEST_F(RecoveryTests, DeltaUpdateRecoveryTest) {
+  // only the commits of ssi and ssn are logged
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::CONCURRENCY_TYPE_SSI);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+
+  const int num_key = 5;
+  oid_t table_oid = 12348;
+  oid_t index_oid = 1237;
+
+  auto frontend_logger = TestingLoggingUtil::StartFileLogging();
+
+  storage::DataTable *table = nullptr;
+  std::thread populate_thread([&] {
+    table = TestingTransactionUtil::CreateTable(num_key, "TEST_TABLE", db_id,
+                                                table_oid, index_oid, true);
+  });
+  populate_thread.join();
+
+  // a delta record only carries the changed columns, with their ids
+  std::unique_ptr<storage::Tuple> delta_tuple(
+      new storage::Tuple(table->GetSchema(), true));
+  delta_tuple->SetValue(1, type::ValueFactory::GetIntegerValue(42),
+                        testing_pool);
+  logging::TupleRecord delta_record(
+      LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE, 5, table_oid, ItemPointer(1, 2),
+      ItemPointer(1, 1), delta_tuple.get(), db_id);
+  delta_record.SetColumnIds({1});
+  CopySerializeOutput output_buffer;
+  delta_record.Serialize(output_buffer);
+
+  FILE *record_file = tmpfile();
+  fwrite(delta_record.GetMessage(), sizeof(char),
+         delta_record.GetMessageLength(), record_file);
+  rewind(record_file);
+  FileHandle file_handle(record_file, fileno(record_file),
+                         delta_record.GetMessageLength());
+
+  EXPECT_EQ(LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE,
+            logging::LoggingUtil::GetNextLogRecordType(file_handle));
+  logging::TupleRecord read_record(LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE);
+  EXPECT_TRUE(
+      logging::LoggingUtil::ReadTupleRecordHeader(read_record, file_handle));
+  EXPECT_EQ(5, read_record.GetTransactionId());
+
+  std::vector<oid_t> column_ids;
+  std::unique_ptr<storage::Tuple> read_tuple(
+      logging::LoggingUtil::ReadTupleDeltaRecordBody(
+          table->GetSchema(), testing_pool, file_handle, column_ids));
+  EXPECT_EQ(std::vector<oid_t>({1}), column_ids);
+  EXPECT_EQ(42, read_tuple->GetValue(1).GetAs<int32_t>());
+  fclose(record_file);
+
+  // the update executor records the changed column for the commit
+  std::thread update_thread([&] {
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 2, 200,
+                                                      false));
+
+    size_t update_count = 0;
+    for (auto &tile_group_entry : txn->GetReadWriteSet()) {
+      auto tile_group_header =
+          manager.GetTileGroup(tile_group_entry.first)->GetHeader();
+      for (auto &tuple_entry : tile_group_entry.second) {
+        if (tuple_entry.second != RWType::UPDATE) {
+          continue;
+        }
+        ItemPointer new_version =
+            tile_group_header->GetNextItemPointer(tuple_entry.first);
+        auto updated_columns = txn->GetUpdatedColumns(new_version);
+        EXPECT_TRUE(updated_columns != nullptr);
+        if (updated_columns != nullptr) {
+          EXPECT_EQ(std::vector<oid_t>({1}), *updated_columns);
+        }
+        update_count++;
+      }
+    }
+    EXPECT_EQ(1, update_count);
+
+    EXPECT_TRUE(txn_manager.CommitTransaction(txn) == ResultType::SUCCESS);
+  });
+  update_thread.join();
+
+  TestingLoggingUtil::CrashFileLogging(frontend_logger);
+
+  // replay into a fresh table, the key of the updated tuple is filled in
+  // from its old version
+  database->DropTableWithOid(table_oid);
+  table = TestingTransactionUtil::CreateTable(0, "TEST_TABLE", db_id,
+                                              table_oid, index_oid, true);
+  TestingLoggingUtil::RecoverFromLogFiles();
+
+  EXPECT_EQ(num_key, table->GetIndex(0)->GetNumberOfTuples());
+
+  TransactionScheduler scheduler(1, table, &txn_manager);
+  for (int key = 0; key < num_key; key++) {
+    scheduler.Txn(0).Read(key);
+  }
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+
+  auto &results = scheduler.schedules[0].results;
+  EXPECT_EQ(num_key, results.size());
+  for (int key = 0; key < (int)results.size(); key++) {
+    EXPECT_EQ(key == 2 ? 200 : 0, results[key]);
+  }
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
 /* (From Joy) TODO FIX this
 TEST_F(RecoveryTests, BasicDeleteTest) {
   auto recovery_table = ExecutorTestsUtil::CreateTable(1024);
@@ -443,5 +790,142 @@ TEST_F(RecoveryTests, OutOfOrderCommitTest) {
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 2);
 }
 
+TEST_F(RecoveryTests, StreamReplayTest) {
+  auto recovery_table = TestingExecutorUtil::CreateTable(1024);
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(recovery_table);
+
+  auto tuples = BuildLoggingTuples(recovery_table, 2, false, false);
+  logging::WriteAheadFrontendLogger fel(true);
+  cid_t insert_commit_id = 10;
+  cid_t update_commit_id = 12;
+
+  // the block covers the insert, the update committed after the block was
+  // collected
+  std::vector<char> block;
+  auto append_record = [&block](logging::LogRecord &record) {
+    CopySerializeOutput output_buffer;
+    record.Serialize(output_buffer);
+    block.insert(block.end(), record.GetMessage(),
+                 record.GetMessage() + record.GetMessageLength());
+  };
+
+  logging::TransactionRecord insert_begin(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                          insert_commit_id);
+  append_record(insert_begin);
+  logging::TupleRecord insert_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_INSERT, insert_commit_id,
+      recovery_table->GetOid(), ItemPointer(100, 4), INVALID_ITEMPOINTER,
+      tuples[0], DEFAULT_DB_ID);
+  append_record(insert_rec);
+  logging::TransactionRecord insert_commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           insert_commit_id);
+  append_record(insert_commit);
+
+  logging::TransactionRecord update_begin(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                          update_commit_id);
+  append_record(update_begin);
+  logging::TupleRecord update_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_UPDATE, update_commit_id,
+      recovery_table->GetOid(), ItemPointer(100, 5), ItemPointer(100, 4),
+      tuples[1], DEFAULT_DB_ID);
+  append_record(update_rec);
+  logging::TransactionRecord update_commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           update_commit_id);
+  append_record(update_commit);
+
+  fel.ReplayLogBlock(block.data(), block.size(), insert_commit_id);
+
+  auto tg_header = recovery_table->GetTileGroupById(100)->GetHeader();
+  EXPECT_EQ(tg_header->GetBeginCommitId(4), insert_commit_id);
+  EXPECT_EQ(tg_header->GetEndCommitId(4), MAX_CID);
+  EXPECT_EQ(tg_header->GetBeginCommitId(5), MAX_CID);
+
+  // the next block covers the update without holding records
+  fel.ReplayLogBlock(nullptr, 0, update_commit_id);
+
+  // the old version stays readable for the snapshots older than the update
+  EXPECT_EQ(tg_header->GetTransactionId(4), INITIAL_TXN_ID);
+  EXPECT_EQ(tg_header->GetBeginCommitId(4), insert_commit_id);
+  EXPECT_EQ(tg_header->GetEndCommitId(4), update_commit_id);
+  EXPECT_EQ(tg_header->GetNextItemPointer(4).offset, 5);
+  EXPECT_EQ(tg_header->GetBeginCommitId(5), update_commit_id);
+  EXPECT_EQ(tg_header->GetEndCommitId(5), MAX_CID);
+
+  // the old version is handed to the gc once no snapshot before the update
+  // is left, and only once
+  EXPECT_EQ(0, fel.RecycleEndedVersions(update_commit_id - 1));
+  EXPECT_EQ(1, fel.RecycleEndedVersions(update_commit_id));
+  EXPECT_EQ(0, fel.RecycleEndedVersions(update_commit_id));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  EXPECT_GT(txn_manager.GetCurrentCommitId(), update_commit_id);
+
+  delete tuples[0];
+  delete tuples[1];
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+}
+
+TEST_F(RecoveryTests, StreamAcknowledgementTest) {
+  auto stream_table = TestingExecutorUtil::CreateTable(1024);
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(stream_table);
+
+  // the primary and the standby share the rpc server of the process, the
+  // stream goes over a loopback connection
+  int port = 15446;
+  auto &standby = logging::ReplicationStandby::GetInstance();
+  EXPECT_TRUE(standby.Start(port));
+
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.Configure(LoggingType::NVM_WAL, true);
+  EXPECT_TRUE(log_manager.SetReplication("127.0.0.1:" + std::to_string(port),
+                                         SYNC_REPLICATION, port));
+  auto replication_sender = log_manager.GetReplicationSender();
+  EXPECT_TRUE(replication_sender != nullptr);
+
+  auto tuples = BuildLoggingTuples(stream_table, 1, false, false);
+  cid_t commit_id = 20;
+
+  std::vector<char> block;
+  auto append_record = [&block](logging::LogRecord &record) {
+    CopySerializeOutput output_buffer;
+    record.Serialize(output_buffer);
+    block.insert(block.end(), record.GetMessage(),
+                 record.GetMessage() + record.GetMessageLength());
+  };
+
+  logging::TransactionRecord begin_record(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                          commit_id);
+  append_record(begin_record);
+  logging::TupleRecord insert_record(
+      LOGRECORD_TYPE_WAL_TUPLE_INSERT, commit_id, stream_table->GetOid(),
+      ItemPointer(150, 3), INVALID_ITEMPOINTER, tuples[0], DEFAULT_DB_ID);
+  append_record(insert_record);
+  logging::TransactionRecord commit_record(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           commit_id);
+  append_record(commit_record);
+
+  replication_sender->SendBlock(block.data(), block.size(), commit_id);
+
+  // with synchronous replication the standby acknowledges the block once it
+  // replayed it
+  EXPECT_TRUE(replication_sender->WaitForAcknowledgement(commit_id));
+  EXPECT_FALSE(replication_sender->IsBroken());
+  EXPECT_EQ(commit_id, replication_sender->GetAcknowledgedCommitId());
+  EXPECT_EQ(commit_id, standby.GetReplayedCommitId());
+
+  auto tg_header = stream_table->GetTileGroupById(150)->GetHeader();
+  EXPECT_EQ(commit_id, tg_header->GetBeginCommitId(3));
+  EXPECT_EQ(MAX_CID, tg_header->GetEndCommitId(3));
+
+  delete tuples[0];
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+}
+
 }  // End test namespace
 }  // End peloton namespace
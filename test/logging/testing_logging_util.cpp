@@ -12,6 +12,9 @@
 
 #include "logging/testing_logging_util.h"
 
+#include "catalog/manager.h"
+#include "logging/logging_util.h"
+
 #define DEFAULT_RECOVERY_CID 15
 
 namespace peloton {
@@ -138,6 +141,54 @@ std::vector<std::shared_ptr<storage::Tuple>> TestingLoggingUtil::BuildTuples(
   return tuples;
 }
 
+logging::WriteAheadFrontendLogger *TestingLoggingUtil::StartFileLogging() {
+  std::string dir_name = logging::WriteAheadFrontendLogger::wal_directory_path;
+  logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.DropFrontendLoggers();
+  log_manager.SetLogDirectoryName("./");
+  log_manager.Configure(LoggingType::NVM_WAL, false, 1,
+                        LoggerMappingStrategyType::ROUND_ROBIN);
+  // no frontend logger thread acknowledges synchronous commits
+  log_manager.SetSyncCommit(false);
+  log_manager.SetLoggingStatus(LoggingStatusType::LOGGING);
+  log_manager.InitFrontendLoggers();
+
+  return reinterpret_cast<logging::WriteAheadFrontendLogger *>(
+      log_manager.GetFrontendLogger(0));
+}
+
+void TestingLoggingUtil::CrashFileLogging(
+    logging::WriteAheadFrontendLogger *frontend_logger) {
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+
+  // the log file is closed with the frontend logger
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.SetLoggingStatus(LoggingStatusType::INVALID);
+  log_manager.DropFrontendLoggers();
+  log_manager.SetSyncCommit(true);
+}
+
+void TestingLoggingUtil::RecoverFromLogFiles() {
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.SetGlobalMaxFlushedIdForRecovery(MAX_CID);
+
+  // recovery sets the next tile group id to the largest one it replayed,
+  // while the tables of the test still hold later ones
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t next_tile_group_id = manager.GetCurrentTileGroupId();
+
+  logging::WriteAheadFrontendLogger frontend_logger;
+  frontend_logger.DoRecovery();
+  frontend_logger.RecoverIndex();
+
+  if (manager.GetCurrentTileGroupId() < next_tile_group_id) {
+    manager.SetNextTileGroupId(next_tile_group_id);
+  }
+}
+
 // =======================================================================
 // Abstract Logging Thread
 // =======================================================================
@@ -1,38 +1,267 @@
-// //===----------------------------------------------------------------------===//
-// //
-// //                         Peloton
-// //
-// // write_behind_logging_test.cpp
-// //
-// // Identification: test/logging/write_behind_logging_test.cpp
-// //
-// // Copyright (c) 2015-16, Carnegie Mellon University Database Group
-// //
-// //===----------------------------------------------------------------------===//
-
-
-// #include "executor/testing_executor_util.h"
-// #include "logging/testing_logging_util.h"
-// #include "common/harness.h"
-
-// #include "concurrency/transaction_manager_factory.h"
-// #include "executor/logical_tile_factory.h"
-// #include "executor/executor_context.h"
-// #include "logging/loggers/wal_frontend_logger.h"
-// #include "logging/logging_util.h"
-// #include "storage/data_table.h"
-// #include "storage/tile.h"
-// #include "storage/table_factory.h"
-
-// #include "executor/mock_executor.h"
-
-// using ::testing::NotNull;
-// using ::testing::Return;
-// using ::testing::InSequence;
-
-// namespace peloton {
-// namespace test {
-// class WriteBehindLoggingTests : public PelotonTest {};
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// write_behind_logging_test.cpp
+//
+// Identification: test/logging/write_behind_logging_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <cstdio>
+
+#include "executor/testing_executor_util.h"
+#include "concurrency/testing_transaction_util.h"
+#include "common/harness.h"
+
+#include "catalog/catalog.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/log_manager.h"
+#include "logging/loggers/wbl_backend_logger.h"
+#include "logging/loggers/wbl_frontend_logger.h"
+#include "logging/records/transaction_record.h"
+#include "logging/records/tuple_record.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+extern size_t peloton_data_file_size;
+
+namespace peloton {
+namespace test {
+class WriteBehindLoggingTests : public PelotonTest {};
+
+// Log a committed transaction that inserted a tuple into the tile group
+void LogCommittedInsert(logging::BackendLogger *backend_logger,
+                        storage::DataTable *table, oid_t tile_group_id,
+                        cid_t commit_id) {
+  logging::TupleRecord insert_record(
+      LOGRECORD_TYPE_WBL_TUPLE_INSERT, commit_id, table->GetOid(),
+      ItemPointer(tile_group_id, 0), INVALID_ITEMPOINTER, nullptr,
+      table->GetDatabaseOid());
+  backend_logger->Log(&insert_record);
+
+  logging::TransactionRecord commit_record(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           commit_id);
+  backend_logger->Log(&commit_record);
+}
+
+TEST_F(WriteBehindLoggingTests, GroupCommitRecoveryTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+
+  std::string log_file_name =
+      std::string("./") + logging::WriteBehindFrontendLogger::wbl_log_path;
+  remove(log_file_name.c_str());
+  remove((log_file_name + ".layout").c_str());
+  log_manager.SetLogFileName(log_file_name);
+
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(5));
+  oid_t tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+
+  //===--------------------------------------------------------------------===//
+  // Group commits before the first crash
+  //===--------------------------------------------------------------------===//
+
+  std::unique_ptr<logging::WriteBehindFrontendLogger> frontend_logger(
+      new logging::WriteBehindFrontendLogger());
+  // the frontend logger owns its backend loggers
+  auto backend_logger = new logging::WriteBehindBackendLogger();
+  frontend_logger->AddBackendLogger(backend_logger);
+
+  txn_manager.SetNextCid(6);
+  LogCommittedInsert(backend_logger, table.get(), tile_group_id, 5);
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+
+  // the modified tile group is synced before the group commit record
+  EXPECT_EQ(1, frontend_logger->GetSyncedTileGroupCount());
+  EXPECT_EQ(1, frontend_logger->GetFsyncCount());
+  EXPECT_EQ(5, frontend_logger->GetMaxFlushedCommitId());
+  std::unordered_set<oid_t> tile_groups;
+  backend_logger->CollectTileGroupsToSync(tile_groups);
+  EXPECT_TRUE(tile_groups.empty());
+
+  // nothing new to persist and the grant still covers the next commit ids
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+  EXPECT_EQ(1, frontend_logger->GetSyncedTileGroupCount());
+  EXPECT_EQ(1, frontend_logger->GetFsyncCount());
+
+  txn_manager.SetNextCid(7);
+  LogCommittedInsert(backend_logger, table.get(), tile_group_id, 6);
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+  EXPECT_EQ(2, frontend_logger->GetSyncedTileGroupCount());
+  EXPECT_EQ(2, frontend_logger->GetFsyncCount());
+  EXPECT_EQ(6, frontend_logger->GetMaxFlushedCommitId());
+
+  // CRASH!
+  frontend_logger.reset();
+
+  //===--------------------------------------------------------------------===//
+  // First recovery
+  //===--------------------------------------------------------------------===//
+
+  frontend_logger.reset(new logging::WriteBehindFrontendLogger());
+  frontend_logger->DoRecovery();
+
+  // the grant of the last group commit is possibly dirty
+  auto dirty_ranges = txn_manager.GetDirtyRanges();
+  EXPECT_EQ(1, dirty_ranges.size());
+  cid_t first_grant = dirty_ranges[0].second;
+  EXPECT_EQ(6, dirty_ranges[0].first);
+  EXPECT_LT(7, first_grant);
+  EXPECT_EQ(first_grant + 1, txn_manager.GetCurrentCommitId());
+  EXPECT_EQ(first_grant, frontend_logger->GetMaxFlushedCommitId());
+
+  backend_logger = new logging::WriteBehindBackendLogger();
+  frontend_logger->AddBackendLogger(backend_logger);
+
+  // the first group commit hands out a new grant
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+  EXPECT_EQ(1, frontend_logger->GetFsyncCount());
+
+  cid_t commit_id = txn_manager.GetNextCommitId();
+  EXPECT_EQ(first_grant + 1, commit_id);
+  LogCommittedInsert(backend_logger, table.get(), tile_group_id, commit_id);
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+  EXPECT_EQ(1, frontend_logger->GetSyncedTileGroupCount());
+  EXPECT_EQ(2, frontend_logger->GetFsyncCount());
+  EXPECT_EQ(commit_id, frontend_logger->GetMaxFlushedCommitId());
+
+  // CRASH!
+  frontend_logger.reset();
+
+  //===--------------------------------------------------------------------===//
+  // Second recovery
+  //===--------------------------------------------------------------------===//
+
+  frontend_logger.reset(new logging::WriteBehindFrontendLogger());
+  frontend_logger->DoRecovery();
+
+  // the gap of the first crash is kept
+  dirty_ranges = txn_manager.GetDirtyRanges();
+  EXPECT_EQ(2, dirty_ranges.size());
+  cid_t second_grant = dirty_ranges[1].second;
+  EXPECT_EQ(6, dirty_ranges[0].first);
+  EXPECT_EQ(first_grant, dirty_ranges[0].second);
+  EXPECT_EQ(commit_id, dirty_ranges[1].first);
+  EXPECT_LT(commit_id + 1, second_grant);
+  EXPECT_EQ(second_grant + 1, txn_manager.GetCurrentCommitId());
+
+  frontend_logger.reset();
+  remove(log_file_name.c_str());
+  remove((log_file_name + ".layout").c_str());
+
+  txn_manager.SetDirtyRanges({});
+  txn_manager.SetMaxGrantCid(MAX_CID);
+  txn_manager.ResetStates();
+}
+
+TEST_F(WriteBehindLoggingTests, DataFileRecoveryTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  auto catalog = catalog::Catalog::GetInstance();
+
+  std::string log_file_name =
+      std::string("./") + logging::WriteBehindFrontendLogger::wbl_log_path;
+  remove(log_file_name.c_str());
+  remove((log_file_name + ".layout").c_str());
+  log_manager.SetLogFileName(log_file_name);
+
+  // the tile groups are allocated from the data file
+  peloton_logging_mode = LoggingType::SSD_WBL;
+  peloton_data_file_size = 16;
+
+  oid_t table_oid = 13;
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  auto table = TestingTransactionUtil::CreateTable(0, "wbl_table",
+                                                   DEFAULT_DB_ID, table_oid,
+                                                   1234, true);
+
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table, 1, 10));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  auto tile_group = table->GetTileGroup(0);
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+  cid_t commit_id = tile_group->GetHeader()->GetBeginCommitId(0);
+  size_t tile_offset;
+  EXPECT_TRUE(storage_manager.LocateInDataFile(
+      tile_group->GetTile(0)->GetTupleLocation(0), tile_offset));
+  size_t tile_end = tile_offset + tile_group->GetTile(0)->GetInlinedSize();
+  tile_group.reset();
+
+  std::unique_ptr<logging::WriteBehindFrontendLogger> frontend_logger(
+      new logging::WriteBehindFrontendLogger());
+  auto backend_logger = new logging::WriteBehindBackendLogger();
+  frontend_logger->AddBackendLogger(backend_logger);
+
+  LogCommittedInsert(backend_logger, table, tile_group_id, commit_id);
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+  EXPECT_EQ(1, frontend_logger->GetSyncedTileGroupCount());
+  EXPECT_EQ(commit_id, frontend_logger->GetMaxFlushedCommitId());
+
+  // CRASH! Only the data file and the logs are left
+  frontend_logger.reset();
+  db->DropTableWithOid(table_oid);
+  table = TestingTransactionUtil::CreateTable(0, "wbl_table", DEFAULT_DB_ID,
+                                              table_oid, 1234, true);
+  EXPECT_EQ(0, table->GetTupleCount());
+
+  frontend_logger.reset(new logging::WriteBehindFrontendLogger());
+  frontend_logger->DoRecovery();
+  EXPECT_EQ(1, frontend_logger->GetRecoveredTileGroupCount());
+
+  // the allocations go past the recovered tile group
+  EXPECT_LE(tile_end, storage_manager.GetDataFileOffset());
+
+  // the first group commit hands out a new grant
+  backend_logger = new logging::WriteBehindBackendLogger();
+  frontend_logger->AddBackendLogger(backend_logger);
+  frontend_logger->CollectLogRecordsFromBackendLoggers();
+  frontend_logger->FlushLogRecords();
+
+  // the committed tuple is mapped back, and found through the index
+  EXPECT_EQ(1, table->GetTupleCount());
+  txn = txn_manager.BeginTransaction();
+  int result = -1;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 1, result));
+  EXPECT_EQ(10, result);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // and can be updated again
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 1, 20));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 1, result));
+  EXPECT_EQ(20, result);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  frontend_logger.reset();
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+  remove(log_file_name.c_str());
+  remove((log_file_name + ".layout").c_str());
+
+  peloton_logging_mode = LoggingType::INVALID;
+  txn_manager.SetDirtyRanges({});
+  txn_manager.SetMaxGrantCid(MAX_CID);
+  txn_manager.ResetStates();
+}
 
 // /* TODO: Disabled it due to arbitrary timing constraints
 // void grant_thread(concurrency::TransactionManager &txn_manager){
@@ -163,6 +392,5 @@
 // //   txn_manager.AbortTransaction(txn);
 // // }
 
-// }  // End test namespace
-// }  // End peloton namespace
-
+}  // End test namespace
+}  // End peloton namespace
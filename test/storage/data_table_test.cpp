@@ -18,7 +18,9 @@
 #include "storage/tile_group.h"
 #include "storage/database.h"
 
+#include "catalog/schema.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "index/index_factory.h"
 
 namespace peloton {
 namespace test {
@@ -91,5 +93,56 @@ TEST_F(DataTableTests, GlobalTableTest) {
   delete data_table_pointer;
 }
 
+TEST_F(DataTableTests, PopulateIndexTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  const int tile_group_count = 8;
+
+  // Create a table spanning several tile groups
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, true));
+  TestingExecutorUtil::PopulateTable(data_table.get(),
+                                     tuple_count * tile_group_count, false,
+                                     false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Build an index on column 0 with the given uniqueness
+  auto tuple_schema = data_table->GetSchema();
+  auto make_index = [tuple_schema](const oid_t index_oid, const bool unique) {
+    std::vector<oid_t> key_attrs = {0};
+    auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+    key_schema->SetIndexedColumns(key_attrs);
+    auto index_metadata = new index::IndexMetadata(
+        "populated_index", index_oid, INVALID_OID, INVALID_OID,
+        IndexType::BWTREE, IndexConstraintType::DEFAULT, tuple_schema,
+        key_schema, key_attrs, unique);
+    return std::shared_ptr<index::Index>(
+        index::IndexFactory::GetIndex(index_metadata));
+  };
+
+  // Exclusive build: runs of all workers are loaded as one batch
+  auto bulk_index = make_index(125, false);
+  EXPECT_TRUE(data_table->BulkLoadIndex(bulk_index.get(), 4));
+
+  std::vector<ItemPointer *> result;
+  bulk_index->ScanAllKeys(result);
+  EXPECT_EQ(tuple_count * tile_group_count, (int)result.size());
+
+  // Concurrent build on an attached index: entries that are already indexed
+  // with the same location are not conflicts
+  auto online_index = make_index(126, true);
+  data_table->AddIndex(online_index);
+  auto table_tile_group_count = data_table->GetTileGroupCount();
+  EXPECT_TRUE(data_table->PopulateIndex(online_index.get(), 0,
+                                        table_tile_group_count / 2, 3, true));
+  EXPECT_TRUE(data_table->PopulateIndex(online_index.get(), 0,
+                                        table_tile_group_count, 3, true));
+
+  result.clear();
+  online_index->ScanAllKeys(result);
+  EXPECT_EQ(tuple_count * tile_group_count, (int)result.size());
+}
+
 }  // End test namespace
 }  // End peloton namespace
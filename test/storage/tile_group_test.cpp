@@ -543,5 +543,40 @@ TEST_F(TileGroupTests, TileCopyTest) {
   delete schema;
 }
 
+TEST_F(TileGroupTests, RecycledTupleSlotTest) {
+  storage::TileGroupHeader header(BackendType::MM, 200);
+
+  // Only the first recycled slot puts the tile group on the free list
+  EXPECT_TRUE(header.RecycleTupleSlot(130));
+  EXPECT_FALSE(header.RecycleTupleSlot(3));
+  EXPECT_FALSE(header.RecycleTupleSlot(199));
+  EXPECT_FALSE(header.RecycleTupleSlot(3));
+  EXPECT_EQ(3, header.GetRecycledTupleCount());
+
+  // Slots are taken lowest first
+  std::vector<oid_t> tuple_slot_ids;
+  EXPECT_EQ(2, header.TakeRecycledTupleSlots(tuple_slot_ids, 2));
+  EXPECT_EQ(3, tuple_slot_ids[0]);
+  EXPECT_EQ(130, tuple_slot_ids[1]);
+
+  // One slot is left, so the tile group goes back on the free list
+  EXPECT_TRUE(header.FinishTakingRecycledTupleSlots());
+
+  tuple_slot_ids.clear();
+  EXPECT_EQ(1, header.TakeRecycledTupleSlots(tuple_slot_ids, 2));
+  EXPECT_EQ(199, tuple_slot_ids[0]);
+  EXPECT_FALSE(header.FinishTakingRecycledTupleSlots());
+  EXPECT_EQ(0, header.GetRecycledTupleCount());
+
+  EXPECT_TRUE(header.RecycleTupleSlot(0));
+
+  // Retired tile groups drop their recycled slots and take no new ones
+  header.Retire();
+  EXPECT_TRUE(header.IsRetired());
+  EXPECT_EQ(0, header.GetRecycledTupleCount());
+  EXPECT_FALSE(header.RecycleTupleSlot(5));
+  EXPECT_EQ(0, header.GetRecycledTupleCount());
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -273,6 +273,33 @@ TEST_F(TypesTests, IndexTypeTest) {
                peloton::Exception);
 }
 
+TEST_F(TypesTests, IndexPartitionTypeTest) {
+  std::vector<IndexPartitionType> list = {IndexPartitionType::INVALID,
+                                          IndexPartitionType::HASH,
+                                          IndexPartitionType::RANGE};
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::IndexPartitionTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToIndexPartitionType(str);
+    EXPECT_EQ(val, newVal);
+
+    std::ostringstream os;
+    os << val;
+    EXPECT_EQ(str, os.str());
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("XXXXX");
+  EXPECT_THROW(peloton::StringToIndexPartitionType(invalid),
+               peloton::Exception);
+  EXPECT_THROW(peloton::IndexPartitionTypeToString(
+                   static_cast<IndexPartitionType>(-99999)),
+               peloton::Exception);
+}
+
 TEST_F(TypesTests, IndexConstraintTypeTest) {
   std::vector<IndexConstraintType> list = {
       IndexConstraintType::INVALID, IndexConstraintType::DEFAULT,
@@ -491,6 +518,30 @@ TEST_F(TypesTests, LoggingTypeTest) {
                peloton::Exception);
 }
 
+TEST_F(TypesTests, LogCompressionTypeTest) {
+  std::vector<LogCompressionType> list = {
+      LogCompressionType::INVALID, LogCompressionType::NONE,
+      LogCompressionType::LZ4, LogCompressionType::ZSTD,
+  };
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::LogCompressionTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToLogCompressionType(str);
+    EXPECT_EQ(val, newVal);
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("WU TANG");
+  EXPECT_THROW(peloton::StringToLogCompressionType(invalid),
+               peloton::Exception);
+  EXPECT_THROW(peloton::LogCompressionTypeToString(
+                   static_cast<LogCompressionType>(-99999)),
+               peloton::Exception);
+}
+
 TEST_F(TypesTests, LoggingStatusTypeTest) {
   std::vector<LoggingStatusType> list = {
       LoggingStatusType::INVALID,   LoggingStatusType::STANDBY,
@@ -545,13 +596,16 @@ TEST_F(TypesTests, LogRecordTypeTest) {
       LOGRECORD_TYPE_TUPLE_INSERT,
       LOGRECORD_TYPE_TUPLE_DELETE,
       LOGRECORD_TYPE_TUPLE_UPDATE,
+      LOGRECORD_TYPE_TUPLE_DELTA_UPDATE,
       LOGRECORD_TYPE_WAL_TUPLE_INSERT,
       LOGRECORD_TYPE_WAL_TUPLE_DELETE,
       LOGRECORD_TYPE_WAL_TUPLE_UPDATE,
+      LOGRECORD_TYPE_WAL_TUPLE_DELTA_UPDATE,
       LOGRECORD_TYPE_WBL_TUPLE_INSERT,
       LOGRECORD_TYPE_WBL_TUPLE_DELETE,
       LOGRECORD_TYPE_WBL_TUPLE_UPDATE,
       LOGRECORD_TYPE_ITERATION_DELIMITER,
+      LOGRECORD_TYPE_COMPRESSED_BLOCK,
   };
 
   // Make sure that ToString and FromString work